@@ -1,6 +1,5 @@
 #include "examples/breakout/ball_ability.h"
 
-#include <list>
 #include <memory>
 
 #include "absl/log/check.h"
@@ -10,12 +9,11 @@
 namespace breakout {
 
 using lib::api::Camera;
-using lib::api::ObjectAndAbilities;
 using lib::api::abilities::AbilityContext;
 
-std::list<ObjectAndAbilities> BallAbility::Use(const AbilityContext& ctx) {
+void BallAbility::Use(const AbilityContext& ctx) {
   if (used_) {
-    return {};
+    return;
   }
   if (controls_->IsPressed(activation_button_)) {
     used_ = true;
@@ -23,8 +21,6 @@ std::list<ObjectAndAbilities> BallAbility::Use(const AbilityContext& ctx) {
     CHECK(cast_ball) << " ability user is not of correct type.";
     cast_ball->SetDirectionGlobal(1, -1);
   }
-
-  return {};
 }
 
 }  // namespace breakout
@@ -1,7 +1,6 @@
 #ifndef EXAMPLES_BREAKOUT_BALL_ABILITY_H
 #define EXAMPLES_BREAKOUT_BALL_ABILITY_H
 
-#include <list>
 #include <memory>
 
 #include "lib/api/abilities/ability.h"
@@ -17,8 +16,7 @@ class BallAbility : public lib::api::abilities::Ability {
                 /*opts*/ {.cooldown_sec = 0}),
         activation_button_(activation_button) {}
 
-  std::list<lib::api::ObjectAndAbilities> Use(
-      const lib::api::abilities::AbilityContext& ctx) override;
+  void Use(const lib::api::abilities::AbilityContext& ctx) override;
 
  private:
   lib::api::Button activation_button_;
@@ -1,5 +1,6 @@
 #include "g_1/levels.h"
 
+#include <cstddef>
 #include <list>
 #include <memory>
 
@@ -12,6 +13,7 @@
 #include "lib/api/controls.h"
 #include "lib/api/factories.h"
 #include "lib/api/level.h"
+#include "lib/api/objects/broadphase_collision_index.h"
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
@@ -32,6 +34,8 @@ constexpr int kOffsetBetweenButtons = 50;
 
 constexpr float kProjectileRadius = 8;
 constexpr float kProjectileSpeed = 5;
+// Projectiles live for a few seconds and are shot at most once per second.
+constexpr size_t kProjectilePoolSize = 8;
 
 constexpr float kPlayerSpeed = 7;
 constexpr int kPlayerX = 0;
@@ -64,9 +68,9 @@ using lib::api::abilities::Ability;
 using lib::api::abilities::MoveAbility;
 using lib::api::abilities::MoveWithCursorAbility;
 using lib::api::abilities::ProjectileAbility;
+using lib::api::objects::BroadphaseType;
 using lib::api::objects::MovableObject;
 using lib::api::objects::Object;
-using lib::api::objects::ObjectType;
 using lib::api::objects::ObjectTypeFactory;
 using lib::api::objects::ProjectileObject;
 using lib::api::objects::RectangleButtonObject;
@@ -107,11 +111,6 @@ std::list<std::unique_ptr<Ability>> MakePlayerAbilities(const bool debug_mode) {
   abilities.push_back(
       std::make_unique<MoveWithCursorAbility>(std::make_unique<Controls>()));
 
-  absl::flat_hash_set<ObjectType> despawn;
-  absl::flat_hash_set<ObjectType> reflect;
-  absl::flat_hash_set<ObjectType> ignore;
-  despawn.insert(ObjectTypeFactory::MakeEnemy());
-  reflect.insert(ObjectTypeFactory::MakeButton());
   abilities.push_back(std::make_unique<ProjectileAbility>(
       std::make_unique<Controls>(),
       /*projectile_type=*/ObjectTypeFactory::MakeProjectilePlayer(),
@@ -123,9 +122,10 @@ std::list<std::unique_ptr<Ability>> MakePlayerAbilities(const bool debug_mode) {
           .velocity = kProjectileSpeed,
           .hit_box_center = {-100, -100},
           .hit_box_radius = kProjectileRadius,
-          .despawn_on_colliding_with_these_objects = std::move(despawn),
-          .reflect_on_colliding_with_these_objects = std::move(reflect),
-          .ignore_these_objects = std::move(ignore)}));
+          .despawn_on_colliding_with_these_objects =
+              ObjectTypeFactory::MakeEnemy().LayerBit(),
+          .reflect_on_colliding_with_these_objects =
+              ObjectTypeFactory::MakeButton().LayerBit()}));
 
   return abilities;
 }
@@ -180,6 +180,13 @@ std::unique_ptr<Level> MakeOpeningLevel(Factories& factories,
   for (auto& static_object : static_objects) {
     level_builder.AddObject(std::move(static_object));
   }
+  // World borders and tiny projectiles are mixed, which the tree handles
+  // better than a grid.
+  level_builder.WithBroadphase(BroadphaseType::kAabbTree);
+  level_builder.WithObjectPool<ProjectileObject>(
+      kProjectilePoolSize, ObjectTypeFactory::MakeProjectilePlayer(),
+      ProjectileObject::ProjectileObjectOpts{.hit_box_radius =
+                                                 kProjectileRadius});
   level_builder.WithScreenObjects(/*should_draw_hitbox=*/false);
   if (debug_mode) {
     level_builder.WithCoordinates();
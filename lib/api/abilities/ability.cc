@@ -1,8 +1,5 @@
-#include "raylib/include/raylib.h"
-
 #include "lib/api/abilities/ability.h"
 
-#include <list>
 #include <memory>
 #include <optional>
 
@@ -17,11 +14,11 @@ namespace abilities {
 using objects::MovableObject;
 using objects::Object;
 
-bool Ability::IsOnCooldown() const {
-  return GetTime() - last_used_sec_ <= static_cast<float>(opts_.cooldown_sec);
+bool Ability::IsOnCooldown(const double now_sec) const {
+  return now_sec - last_used_sec_ <= opts_.cooldown_sec;
 }
 
-std::list<ObjectAndAbilities> MoveAbility::Use(const AbilityContext& ctx) {
+void MoveAbility::Use(const AbilityContext& ctx) {
   // Generally move should have no cooldown - so ignore it.
   auto* cast_user = dynamic_cast<MovableObject*>(user());
   CHECK(cast_user) << " ability user is not of correct type.";
@@ -51,15 +48,14 @@ std::list<ObjectAndAbilities> MoveAbility::Use(const AbilityContext& ctx) {
       // Freeze object temporarily if this is the first frame when movement
       // keys were not hold.
       cast_user->freeze_until_next_set_direction();
-      return {};
+      return;
     }
     // Do not touch directions.
     was_used_last_frame_ = was_used_this_frame;
-    return {};
+    return;
   }
   was_used_last_frame_ = was_used_this_frame;
   cast_user->SetDirectionGlobal(dir_x, dir_y);
-  return {};
 }
 
 }  // namespace abilities
@@ -1,14 +1,21 @@
 #ifndef LIB_API_ABILITIES_ABILITY_H
 #define LIB_API_ABILITIES_ABILITY_H
 
+#include <cstddef>
 #include <list>
 #include <memory>
 #include <optional>
+#include <span>
+#include <utility>
+#include <vector>
 
+#include "absl/base/nullability.h"
 #include "lib/api/camera.h"
 #include "lib/api/common_types.h"
 #include "lib/api/controls.h"
 #include "lib/api/objects/object.h"
+#include "lib/api/objects/object_pool.h"
+#include "lib/api/objects/world_query.h"
 
 namespace lib {
 namespace api {
@@ -27,9 +34,41 @@ typedef std::pair<std::unique_ptr<objects::Object>,
 
 namespace abilities {
 
+// Objects spawned by abilities, added to the level once every ability of the
+// step has been used. The level keeps its buffers between steps, so spawning
+// only allocates the spawned objects themselves.
+class SpawnBuffer {
+ public:
+  explicit SpawnBuffer(size_t capacity = 0) { spawned_.reserve(capacity); }
+
+  void Spawn(std::unique_ptr<objects::Object> object,
+             std::list<std::unique_ptr<Ability>> abilities = {}) {
+    spawned_.emplace_back(std::move(object), std::move(abilities));
+  }
+  // Keeps the capacity for the next step.
+  void Clear() { spawned_.clear(); }
+
+  // In the order they were spawned in.
+  [[nodiscard]] std::span<ObjectAndAbilities> spawned() { return spawned_; }
+  [[nodiscard]] bool empty() const { return spawned_.empty(); }
+
+ private:
+  std::vector<ObjectAndAbilities> spawned_;
+};
+
 struct AbilityContext {
   const Camera& camera;
   const ViewPortContext& view_port_ctx;
+  // Spatial queries against the objects of the level.
+  const objects::WorldQuery& world;
+  // Where to put the spawned objects.
+  SpawnBuffer& spawns;
+  // Pools of the level to take spawned objects from, see `ObjectPool`. Not
+  // set outside of a level.
+  absl::Nullable<objects::ObjectPools*> pools = nullptr;
+  // Simulated seconds since the level started. Unlike the wall clock it is
+  // the same in every replay of the same input.
+  double time_sec = 0;
 };
 
 class Ability {
@@ -43,16 +82,18 @@ class Ability {
       : controls_(std::move(controls)), user_(nullptr), opts_(opts) {}
   virtual ~Ability() = default;
 
-  virtual std::list<ObjectAndAbilities> Use(const AbilityContext& ctx) = 0;
+  // May run in parallel with the abilities of other objects, so it must only
+  // change the ability and its user. Objects to spawn go to `ctx.spawns`.
+  virtual void Use(const AbilityContext& ctx) = 0;
   void set_user(objects::Object* user) { user_ = user; }
   [[nodiscard]] objects::Object* user() const { return user_; }
 
  protected:
   template <typename LevelT>
   friend class lib::api::LevelBuilder;
-  [[nodiscard]] bool IsOnCooldown() const;
-  // TODO(f1lo): Temporary hack, switch to absl::Time.
-  float last_used_sec_ = -100;
+  [[nodiscard]] bool IsOnCooldown(double now_sec) const;
+  // Simulated seconds, see `AbilityContext::time_sec`.
+  double last_used_sec_ = -100;
   std::unique_ptr<const ControlsInterface> controls_;
 
  private:
@@ -78,8 +119,7 @@ class MoveAbility : public Ability {
         key_bottom_(opts.key_bottom) {}
   ~MoveAbility() override = default;
 
-  [[nodiscard]] std::list<ObjectAndAbilities> Use(
-      const AbilityContext& ctx) override;
+  void Use(const AbilityContext& ctx) override;
 
  private:
   std::optional<Button> key_left_;
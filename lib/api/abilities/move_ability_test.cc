@@ -1,7 +1,8 @@
 #include "lib/api/abilities/ability.h"
 
-#include <list>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -11,6 +12,7 @@
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
 
 namespace lib {
 namespace api {
@@ -26,6 +28,13 @@ constexpr float kScreenHeight = 300;
 constexpr float kNativeScreenWidth = 1500;
 constexpr float kNativeScreenHeight = 900;
 
+// None of the abilities under test query the world.
+const objects::WorldQuery& EmptyWorld() {
+  static const auto* const kObjects = new std::vector<objects::Object*>();
+  static const auto* const kWorld = new objects::WorldQuery(*kObjects);
+  return *kWorld;
+}
+
 class MoveAbilityTest : public ::testing::Test {};
 
 class DummyMovableObject : public MovableObject {
@@ -62,9 +71,12 @@ TEST(MoveAbilityDeathTest, UserNotMovable) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  EXPECT_DEATH(
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context}),
-      HasSubstr("ability user is not of correct type."));
+  SpawnBuffer spawns;
+  EXPECT_DEATH(ability.Use({.camera = camera,
+                            .view_port_ctx = view_port_context,
+                            .world = EmptyWorld(),
+                            .spawns = spawns}),
+               HasSubstr("ability user is not of correct type."));
 }
 
 TEST(MoveAbilityTest, Move) {
@@ -82,10 +94,13 @@ TEST(MoveAbilityTest, Move) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -107,10 +122,13 @@ TEST(MoveAbilityTest, MoveLeft) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), -1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -132,10 +150,13 @@ TEST(MoveAbilityTest, MoveRight) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -157,10 +178,13 @@ TEST(MoveAbilityTest, MoveTop) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 0);
   EXPECT_EQ(movable_object.direction_y(), -1);
 }
@@ -182,10 +206,13 @@ TEST(MoveAbilityTest, MoveBottom) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 0);
   EXPECT_EQ(movable_object.direction_y(), 1);
 }
@@ -1,6 +1,5 @@
 #include "lib/api/abilities/move_with_cursor_ability.h"
 
-#include <list>
 #include <memory>
 #include <optional>
 
@@ -20,8 +19,7 @@ namespace abilities {
 using objects::MovableObject;
 using objects::Object;
 
-std::list<ObjectAndAbilities> MoveWithCursorAbility::Use(
-    const AbilityContext& ctx) {
+void MoveWithCursorAbility::Use(const AbilityContext& ctx) {
   MovableObject* const movable_user = dynamic_cast<MovableObject*>(user());
   CHECK(movable_user) << "User not movable.";
   if (cursor_last_clicked_pos_.has_value()) {
@@ -34,20 +32,19 @@ std::list<ObjectAndAbilities> MoveWithCursorAbility::Use(
                    cursor_last_clicked_pos_->y}))) {
       cursor_last_clicked_pos_ = std::nullopt;
       movable_user->freeze_until_next_set_direction();
-      return {};
+      return;
     }
   }
   if (!controls_->IsSecondaryPressed()) {
-    return {};
+    return;
   }
   const std::optional<const WorldPosition> cursor_pos_world =
       GetMouseWorldPosition(ctx.camera, ctx.view_port_ctx, *controls_);
   if (!cursor_pos_world.has_value()) {
-    return {};
+    return;
   }
   cursor_last_clicked_pos_ = *cursor_pos_world;
   movable_user->SetDirectionRelative(cursor_pos_world->x, cursor_pos_world->y);
-  return {};
 }
 
 }  // namespace abilities
@@ -1,7 +1,6 @@
 #ifndef LIB_API_ABILITIES_MOVE_WITH_CURSOR_ABILITY_H
 #define LIB_API_ABILITIES_MOVE_WITH_CURSOR_ABILITY_H
 
-#include <list>
 #include <memory>
 #include <optional>
 
@@ -20,7 +19,7 @@ class MoveWithCursorAbility : public Ability {
         cursor_last_clicked_pos_(std::nullopt) {}
   ~MoveWithCursorAbility() override = default;
 
-  std::list<ObjectAndAbilities> Use(const AbilityContext& ctx) override;
+  void Use(const AbilityContext& ctx) override;
 
  private:
   std::optional<WorldPosition> cursor_last_clicked_pos_;
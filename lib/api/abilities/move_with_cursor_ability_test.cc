@@ -1,7 +1,7 @@
 #include "lib/api/abilities/move_with_cursor_ability.h"
 
-#include <list>
 #include <memory>
+#include <vector>
 
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -11,6 +11,7 @@
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
 
 namespace lib {
 namespace api {
@@ -26,6 +27,13 @@ constexpr float kScreenHeight = 300;
 constexpr float kNativeScreenWidth = 1500;
 constexpr float kNativeScreenHeight = 900;
 
+// None of the abilities under test query the world.
+const objects::WorldQuery& EmptyWorld() {
+  static const auto* const kObjects = new std::vector<objects::Object*>();
+  static const auto* const kWorld = new objects::WorldQuery(*kObjects);
+  return *kWorld;
+}
+
 class MoveWithCursorAbilityTest {};
 
 class DummyMovableObject : public MovableObject {
@@ -59,9 +67,12 @@ TEST(MoveWithCursorAbilityDeathTest, NonMovableObject) {
   const ViewPortContext view_port_context(
       kNativeScreenWidth, kNativeScreenHeight, kNativeScreenWidth,
       kNativeScreenHeight);
-  EXPECT_DEATH(
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context}),
-      HasSubstr("User not movable"));
+  SpawnBuffer spawns;
+  EXPECT_DEATH(ability.Use({.camera = camera,
+                            .view_port_ctx = view_port_context,
+                            .world = EmptyWorld(),
+                            .spawns = spawns}),
+               HasSubstr("User not movable"));
 }
 
 TEST(MoveWithCursorAbilityTest, MoveNotPressedDirectionNotChanged) {
@@ -79,10 +90,13 @@ TEST(MoveWithCursorAbilityTest, MoveNotPressedDirectionNotChanged) {
   const ViewPortContext view_port_context(
       kNativeScreenWidth, kNativeScreenHeight, kNativeScreenWidth,
       kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), -1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -101,10 +115,13 @@ TEST(MoveWithCursorAbilityTest, MovePressedDirectionChanges) {
   const ViewPortContext view_port_context(
       kNativeScreenWidth, kNativeScreenHeight, kNativeScreenWidth,
       kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -123,10 +140,13 @@ TEST(MoveWithCursorAbilityTest,
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 1);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
@@ -144,10 +164,13 @@ TEST(MoveWithCursorAbilityTest, MovePressedOutsideScreenDirectionSame) {
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
   EXPECT_EQ(movable_object.direction_x(), 0);
   EXPECT_EQ(movable_object.direction_y(), 0);
 }
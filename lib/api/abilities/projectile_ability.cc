@@ -1,14 +1,13 @@
-#include "raylib/include/raylib.h"
-
 #include "lib/api/abilities/projectile_ability.h"
 
-#include <list>
 #include <memory>
 
 #include "lib/api/abilities/ability.h"
 #include "lib/api/controls.h"
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object.h"
+#include "lib/api/objects/object_pool.h"
+#include "lib/api/objects/object_type.h"
 #include "lib/api/objects/projectile_object.h"
 
 namespace lib {
@@ -18,26 +17,25 @@ namespace abilities {
 using objects::MovableObject;
 using objects::ProjectileObject;
 
-std::list<ObjectAndAbilities> ProjectileAbility::Use(
-    const AbilityContext& ctx) {
-  if (IsOnCooldown()) {
-    return {};
+void ProjectileAbility::Use(const AbilityContext& ctx) {
+  if (IsOnCooldown(ctx.time_sec)) {
+    return;
   }
   if (!controls_->IsPrimaryPressed() && !controls_->IsPressed(kKeySpace)) {
-    return {};
+    return;
   }
 
-  last_used_sec_ = static_cast<float>(GetTime());
+  last_used_sec_ = ctx.time_sec;
 
   // Always spawn off user.
   projectile_object_opts_.hit_box_center = {user()->center().x,
                                             user()->center().y};
 
   // Always ignore the user.
-  projectile_object_opts_.ignore_these_objects.insert(user()->type());
+  projectile_object_opts_.ignore_these_objects |= user()->type().LayerBit();
   // Despawn once outside world borders.
-  projectile_object_opts_.despawn_on_colliding_with_these_objects.insert(
-      objects::ObjectTypeFactory::MakeWorldBorder());
+  projectile_object_opts_.despawn_on_colliding_with_these_objects |=
+      objects::ObjectTypeFactory::MakeWorldBorder().LayerBit();
 
   // If user has direction, spawn projectile with the same direction.
   // Otherwise go top right.
@@ -56,15 +54,18 @@ std::list<ObjectAndAbilities> ProjectileAbility::Use(
     direction_x = 1.0f;
   }
 
+  // Reuses a deleted projectile when the level has a pool for them.
+  objects::ObjectPool<ProjectileObject>* const pool =
+      ctx.pools == nullptr ? nullptr : ctx.pools->Get<ProjectileObject>();
   std::unique_ptr<ProjectileObject> projectile =
-      std::make_unique<ProjectileObject>(
-          /*type=*/projectile_type_, /*options=*/projectile_object_opts_);
+      pool == nullptr
+          ? std::make_unique<ProjectileObject>(
+                /*type=*/projectile_type_, /*options=*/projectile_object_opts_)
+          : pool->Acquire(/*type=*/projectile_type_,
+                          /*options=*/projectile_object_opts_);
   projectile->SetDirectionGlobal(direction_x, direction_y);
 
-  std::list<ObjectAndAbilities> result;
-  result.emplace_back(std::move(projectile),
-                      std::list<std::unique_ptr<Ability>>{});
-  return result;
+  ctx.spawns.Spawn(std::move(projectile));
 }
 
 }  // namespace abilities
@@ -1,11 +1,9 @@
 #ifndef LIB_API_ABILITIES_PROJECTILE_ABILITY_H
 #define LIB_API_ABILITIES_PROJECTILE_ABILITY_H
 
-#include <list>
 #include <memory>
 #include <utility>
 
-#include "absl/container/flat_hash_set.h"
 #include "lib/api/abilities/ability.h"
 #include "lib/api/controls.h"
 #include "lib/api/objects/object_type.h"
@@ -25,12 +23,13 @@ class ProjectileAbility : public Ability {
       std::unique_ptr<const ControlsInterface> controls,
       const objects::ObjectType projectile_type,
       const ProjectileAbilityOpts& opts,
-      objects::ProjectileObject::ProjectileObjectOpts projectile_object_opts)
+      const objects::ProjectileObject::ProjectileObjectOpts&
+          projectile_object_opts)
       : Ability(std::move(controls), {.cooldown_sec = opts.cooldown_sec}),
         projectile_type_(projectile_type),
-        projectile_object_opts_(std::move(projectile_object_opts)) {}
+        projectile_object_opts_(projectile_object_opts) {}
 
-  std::list<ObjectAndAbilities> Use(const AbilityContext& ctx) override;
+  void Use(const AbilityContext& ctx) override;
 
  private:
   objects::ObjectType projectile_type_;
@@ -1,6 +1,7 @@
 #include "lib/api/abilities/projectile_ability.h"
 
-#include <list>
+#include <memory>
+#include <vector>
 
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -12,6 +13,7 @@
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/projectile_object.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
 
 namespace lib {
 namespace api {
@@ -23,6 +25,13 @@ constexpr float kScreenHeight = 250;
 constexpr float kNativeScreenWidth = 1000;
 constexpr float kNativeScreenHeight = 500;
 
+// None of the abilities under test query the world.
+const objects::WorldQuery& EmptyWorld() {
+  static const auto* const kObjects = new std::vector<objects::Object*>();
+  static const auto* const kWorld = new objects::WorldQuery(*kObjects);
+  return *kWorld;
+}
+
 using objects::MovableObject;
 using objects::ProjectileObject;
 using objects::StaticObject;
@@ -60,20 +69,21 @@ TEST(ProjectileAbilityTest, InputNotPressed) {
           .velocity = 1,
           .hit_box_center = FPoint{5, 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<objects::ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
   ability.set_user(&static_object);
 
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
 }
 
 TEST(ProjectileAbilityTest, OnCooldown) {
@@ -95,22 +105,26 @@ TEST(ProjectileAbilityTest, OnCooldown) {
           .velocity = 1,
           .hit_box_center = FPoint{5, 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<objects::ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
   ability.set_user(&static_object);
 
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
-  objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
+  spawns.Clear();
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_TRUE(objects_and_abilities.empty());
+  EXPECT_TRUE(spawns.empty());
 }
 
 TEST(ProjectileAbilityTest, ProjectileSpawned) {
@@ -132,21 +146,22 @@ TEST(ProjectileAbilityTest, ProjectileSpawned) {
           .velocity = 1,
           .hit_box_center = FPoint{5, 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<objects::ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
   ability.set_user(&static_object);
 
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_EQ(objects_and_abilities.size(), 1);
-  EXPECT_EQ(objects_and_abilities.begin()->first->center(),
+  EXPECT_EQ(spawns.spawned().size(), 1);
+  EXPECT_EQ(spawns.spawned().front().first->center(),
             (WorldPosition{.x = 0, .y = 0}));
 }
 
@@ -167,22 +182,23 @@ TEST(ProjectileAbilityTest, MovableObjectProjectileSameDirection) {
           .velocity = 1,
           .hit_box_center = FPoint{5, 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<objects::ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
   ability.set_user(&movable_object);
 
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
 
-  EXPECT_EQ(objects_and_abilities.size(), 1);
+  EXPECT_EQ(spawns.spawned().size(), 1);
   ProjectileObject* projectile = dynamic_cast<ProjectileObject*>(
-      objects_and_abilities.begin()->first.get());
+      spawns.spawned().front().first.get());
   ASSERT_TRUE(projectile != nullptr);
   EXPECT_EQ(projectile->center(), (WorldPosition{.x = 0, .y = 0}));
   EXPECT_FLOAT_EQ(projectile->direction_x(), 0.6f);
@@ -208,20 +224,21 @@ TEST(ProjectileAbilityTest, CreatedProjectileDespawnsOnWorldBorderTouch) {
           .velocity = 1,
           .hit_box_center = FPoint{5, 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<objects::ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<objects::ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
   ability.set_user(&static_object);
   const Camera camera(kNativeScreenWidth, kNativeScreenHeight);
   const ViewPortContext view_port_context(
       kScreenWidth, kScreenHeight, kNativeScreenWidth, kNativeScreenHeight);
-  const std::list<ObjectAndAbilities> objects_and_abilities =
-      ability.Use({.camera = camera, .view_port_ctx = view_port_context});
-  EXPECT_EQ(objects_and_abilities.size(), 1);
+  SpawnBuffer spawns;
+  ability.Use({.camera = camera,
+               .view_port_ctx = view_port_context,
+               .world = EmptyWorld(),
+               .spawns = spawns});
+  EXPECT_EQ(spawns.spawned().size(), 1);
   ProjectileObject* projectile = dynamic_cast<ProjectileObject*>(
-      objects_and_abilities.begin()->first.get());
+      spawns.spawned().front().first.get());
   ASSERT_TRUE(projectile != nullptr);
   EXPECT_EQ(projectile->center(), (WorldPosition{.x = 0, .y = 0}));
   StaticObject world_border = StaticObject(
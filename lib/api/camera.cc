@@ -2,20 +2,24 @@
 
 #include "lib/api/camera.h"
 
+#include <optional>
+
+#include "absl/base/nullability.h"
 #include "absl/log/check.h"
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object.h"
+#include "lib/internal/slot_map.h"
 
 namespace lib {
 namespace api {
 
-void Camera::Bind(objects::Object* object) {
-  CHECK(!bound_object_) << "Object bound already set.";
-  bound_object_ = object;
+void Camera::Bind(const internal::SlotHandle handle) {
+  CHECK(!bound_.has_value()) << "Object bound already set.";
+  bound_ = handle;
 }
 
 ScreenPosition Camera::GetScreenPosition(const WorldPosition& world_pos) const {
-  if (!bound_object_) {
+  if (!bound_.has_value()) {
     return {world_pos.x, world_pos.y};
   }
   const Vector2 screen_pos =
@@ -24,7 +28,7 @@ ScreenPosition Camera::GetScreenPosition(const WorldPosition& world_pos) const {
 }
 
 WorldPosition Camera::GetWorldPosition(const ScreenPosition& screen_pos) const {
-  if (!bound_object_) {
+  if (!bound_.has_value()) {
     return {screen_pos.x, screen_pos.y};
   }
 
@@ -33,19 +37,39 @@ WorldPosition Camera::GetWorldPosition(const ScreenPosition& screen_pos) const {
   return {world_pos.x, world_pos.y};
 }
 
-void Camera::MaybeActivate() {
-  if (!bound_object_) {
+void Camera::Follow(const absl::Nullable<const objects::Object*> bound_object,
+                    const float alpha) {
+  if (bound_object == nullptr) {
     return;
   }
 
-  const WorldPosition world_position = bound_object_->center();
+  const WorldPosition world_position = bound_object->InterpolatedCenter(alpha);
   camera_.target.x = world_position.x;
   camera_.target.y = world_position.y;
-  BeginMode2D(camera_);
+}
+
+std::optional<WorldPosition> Camera::target() const {
+  if (!bound_.has_value()) {
+    return std::nullopt;
+  }
+
+  return WorldPosition{.x = camera_.target.x, .y = camera_.target.y};
+}
+
+void Camera::MaybeActivate(const std::optional<WorldPosition> target) const {
+  if (!target.has_value()) {
+    return;
+  }
+
+  // Only the target changes after construction, it is not read here.
+  BeginMode2D({.offset = camera_.offset,
+               .target = {.x = target->x, .y = target->y},
+               .rotation = camera_.rotation,
+               .zoom = camera_.zoom});
 }
 
 void Camera::MaybeDeactivate() const {
-  if (!bound_object_) {
+  if (!bound_.has_value()) {
     return;
   }
 
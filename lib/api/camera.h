@@ -3,8 +3,12 @@
 
 #include "raylib/include/raylib.h"
 
+#include <optional>
+
+#include "absl/base/nullability.h"
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object.h"
+#include "lib/internal/slot_map.h"
 
 namespace lib {
 namespace api {
@@ -16,26 +20,39 @@ class Camera {
                             .y = native_screen_height / 2.0f},
                  .target = {.x = 0.0f, .y = 0.0f},
                  .rotation = 0.0f,
-                 .zoom = 1.0f}),
-        bound_object_(nullptr) {}
+                 .zoom = 1.0f}) {}
 
   Camera(const Camera&) = delete;
   Camera& operator=(const Camera&) = delete;
   Camera(const Camera&&) = delete;
   Camera&& operator=(const Camera&&) = delete;
 
-  // Does not take ownership.
-  void Bind(objects::Object* object);
+  // Follows the object behind `handle` in the objects of the level.
+  void Bind(internal::SlotHandle handle);
+  [[nodiscard]] std::optional<internal::SlotHandle> bound() const {
+    return bound_;
+  }
   [[nodiscard]] ScreenPosition GetScreenPosition(
       const WorldPosition& world_pos) const;
   [[nodiscard]] WorldPosition GetWorldPosition(
       const ScreenPosition& screen_pos) const;
-  void MaybeActivate();
+  // Centers the camera on `bound_object`, which the caller finds through
+  // `bound()`. Stays where it is once the bound object is gone. `alpha`
+  // interpolates between its previous and current center, see
+  // `objects::Object::InterpolatedCenter`.
+  void Follow(absl::Nullable<const objects::Object*> bound_object,
+              float alpha = 1.0f);
+  // Where the camera looks at, not set when no object is bound.
+  [[nodiscard]] std::optional<WorldPosition> target() const;
+  // Starts drawing through the camera looking at `target`, does nothing when
+  // it is not set. Does not read the bound object, so it can be called while
+  // the object is simulated on another thread.
+  void MaybeActivate(std::optional<WorldPosition> target) const;
   void MaybeDeactivate() const;
 
  private:
   Camera2D camera_;
-  objects::Object* bound_object_;
+  std::optional<internal::SlotHandle> bound_;
 };
 
 }  // namespace api
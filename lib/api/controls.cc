@@ -2,13 +2,80 @@
 
 #include "lib/api/controls.h"
 
+#include <bitset>
 #include <optional>
+#include <vector>
 
 #include "lib/api/common_types.h"
 
 namespace lib {
 namespace api {
 
+namespace {
+
+// Every raylib key code is below this.
+constexpr int kMaxKeys = 512;
+
+std::bitset<kMaxKeys> pressed_keys;
+std::bitset<kMaxKeys> down_keys;
+bool primary_pressed = false;
+bool secondary_pressed = false;
+ScreenPosition cursor_pos = {.x = 0, .y = 0};
+
+}  // namespace
+
+void CollectInput() {
+  for (int key = 0; key < kMaxKeys; ++key) {
+    if (IsKeyPressed(key)) {
+      pressed_keys.set(key);
+    }
+    down_keys.set(key, IsKeyDown(key));
+  }
+  primary_pressed |= IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+  secondary_pressed |= IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
+  cursor_pos = {.x = static_cast<float>(GetMouseX()),
+                .y = static_cast<float>(GetMouseY())};
+}
+
+void ClearPresses() {
+  pressed_keys.reset();
+  primary_pressed = false;
+  secondary_pressed = false;
+}
+
+ScriptedInput CollectedInput() {
+  ScriptedInput input = {.primary_pressed = primary_pressed,
+                         .secondary_pressed = secondary_pressed,
+                         .cursor_pos = cursor_pos};
+  for (int key = 0; key < kMaxKeys; ++key) {
+    if (pressed_keys.test(key)) {
+      input.pressed.push_back(key);
+    }
+    if (down_keys.test(key)) {
+      input.down.push_back(key);
+    }
+  }
+  return input;
+}
+
+void ReplayInput(const ScriptedInput& input) {
+  pressed_keys.reset();
+  down_keys.reset();
+  for (const Button key : input.pressed) {
+    if (key >= 0 && key < kMaxKeys) {
+      pressed_keys.set(key);
+    }
+  }
+  for (const Button key : input.down) {
+    if (key >= 0 && key < kMaxKeys) {
+      down_keys.set(key);
+    }
+  }
+  primary_pressed = input.primary_pressed;
+  secondary_pressed = input.secondary_pressed;
+  cursor_pos = input.cursor_pos;
+}
+
 std::optional<WorldPosition> GetMouseWorldPosition(
     const Camera& camera, const ViewPortContext& ctx,
     const ControlsInterface& controls) {
@@ -21,24 +88,23 @@ std::optional<WorldPosition> GetMouseWorldPosition(
 }
 
 bool Controls::IsPressed(const Button button) const {
-  return IsKeyPressed(button);
+  return button >= 0 && button < kMaxKeys && pressed_keys.test(button);
 }
 
 bool Controls::IsDown(const Button button) const {
-  return IsKeyDown(button);
+  return button >= 0 && button < kMaxKeys && down_keys.test(button);
 }
 
 bool Controls::IsPrimaryPressed() const {
-  return IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+  return primary_pressed;
 }
 
 bool Controls::IsSecondaryPressed() const {
-  return IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
+  return secondary_pressed;
 }
 
 ScreenPosition Controls::GetCursorPos() const {
-  return {.x = static_cast<float>(GetMouseX()),
-          .y = static_cast<float>(GetMouseY())};
+  return cursor_pos;
 }
 
 }  // namespace api
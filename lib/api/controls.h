@@ -4,6 +4,7 @@
 #include "raylib/include/raylib.h"
 
 #include <optional>
+#include <vector>
 
 #include "lib/api/camera.h"
 #include "lib/api/common_types.h"
@@ -20,6 +21,17 @@ constexpr Button kKeyW = KEY_W;
 constexpr Button kKeySpace = KEY_SPACE;
 constexpr Button kKeyEscape = KEY_ESCAPE;
 
+// Input of a single simulation step.
+struct ScriptedInput {
+  std::vector<Button> pressed;
+  std::vector<Button> down;
+  bool primary_pressed = false;
+  bool secondary_pressed = false;
+  ScreenPosition cursor_pos = {.x = 0, .y = 0};
+
+  bool operator==(const ScriptedInput& other) const = default;
+};
+
 class ControlsInterface {
  public:
   [[nodiscard]] virtual bool IsPressed(Button button) const = 0;
@@ -42,6 +54,21 @@ class Controls : public ControlsInterface {
   [[nodiscard]] ScreenPosition GetCursorPos() const override;
 };
 
+// `Controls` reports the input collected by `CollectInput` once per frame, and
+// never asks raylib itself - so the simulation can read it from another
+// thread. raylib reports a press only in the frame it happens, while a level
+// can simulate zero or several steps in one frame. Presses are reported until
+// `ClearPresses` is called after the next simulation step, so none is lost or
+// seen twice.
+void CollectInput();
+void ClearPresses();
+// What `Controls` reports until the next `CollectInput` or `ReplayInput`,
+// e.g. for recording it into an `InputLog`.
+[[nodiscard]] ScriptedInput CollectedInput();
+// Makes `Controls` report `input` instead of what raylib has collected, for
+// replaying recorded input.
+void ReplayInput(const ScriptedInput& input);
+
 [[nodiscard]] std::optional<WorldPosition> GetMouseWorldPosition(
     const Camera& camera, const ViewPortContext& ctx,
     const ControlsInterface& controls);
@@ -0,0 +1,114 @@
+#ifndef LIB_API_ECS_COMPONENTS_H
+#define LIB_API_ECS_COMPONENTS_H
+
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include "absl/base/nullability.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/sprites/sprite.h"
+#include "lib/internal/hit_box.h"
+#include "lib/internal/slot_map.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+
+// Refers to an entity of a `Registry`, stale once the entity is destroyed.
+typedef internal::SlotHandle Entity;
+
+// Set of components, every component owns one bit. Entities with the same
+// set of components are stored together in one `Archetype`.
+typedef uint32_t ComponentMask;
+
+// Where the entity is, every entity has one.
+struct Transform {
+  WorldPosition center;
+  // Center before the last simulation step, the entity is drawn in between.
+  WorldPosition previous_center;
+};
+
+// Moves the entity by `speed` along (`direction_x`, `direction_y`) every
+// step, see `objects::MovableObject`. The direction has unit length or is 0.
+struct Velocity {
+  float speed = 0;
+  float direction_x = 0;
+  float direction_y = 0;
+};
+
+// Hit box in world coordinates, moved together with the `Transform`.
+// Entities with one need a `Type`.
+struct Collider {
+  internal::HitBox hit_box;
+  bool should_draw_hit_box = false;
+};
+
+struct Sprite {
+  // Owned by the sprite factory, outlives every level.
+  absl::Nonnull<const sprites::Sprite*> sprite;
+  int frame = 0;
+  // Simulation steps every frame of an animation is shown for, 0 only ever
+  // shows the first frame.
+  int steps_per_frame = 0;
+  int steps_on_frame = 0;
+};
+
+// What the entity is and what it collides with, like `objects::Object`.
+struct Type {
+  objects::ObjectType type;
+  objects::LayerMask collides_with = 0;
+};
+
+// How a moving entity responds to a collision, see
+// `objects::ProjectileObject`. Moving entities without it step back out of
+// whatever they collide with, like `objects::MovableObject`.
+struct Projectile {
+  bool despawn_outside_screen_area = false;
+  objects::LayerMask despawn_on_colliding_with_these_objects = 0;
+  objects::LayerMask reflect_on_colliding_with_these_objects = 0;
+};
+
+inline constexpr ComponentMask kTransformComponent = 1 << 0;
+inline constexpr ComponentMask kVelocityComponent = 1 << 1;
+inline constexpr ComponentMask kColliderComponent = 1 << 2;
+inline constexpr ComponentMask kSpriteComponent = 1 << 3;
+inline constexpr ComponentMask kTypeComponent = 1 << 4;
+inline constexpr ComponentMask kProjectileComponent = 1 << 5;
+
+// Bit of component `T`.
+template <typename T>
+constexpr ComponentMask ComponentBit() {
+  if constexpr (std::is_same_v<T, Transform>) {
+    return kTransformComponent;
+  } else if constexpr (std::is_same_v<T, Velocity>) {
+    return kVelocityComponent;
+  } else if constexpr (std::is_same_v<T, Collider>) {
+    return kColliderComponent;
+  } else if constexpr (std::is_same_v<T, Sprite>) {
+    return kSpriteComponent;
+  } else if constexpr (std::is_same_v<T, Type>) {
+    return kTypeComponent;
+  } else {
+    static_assert(std::is_same_v<T, Projectile>, "Not a component");
+    return kProjectileComponent;
+  }
+}
+
+// Components of a new entity, unset components are left out. Every entity
+// has a `Transform` at `center`.
+struct EntityDesc {
+  WorldPosition center;
+  std::optional<Velocity> velocity;
+  std::optional<Collider> collider;
+  std::optional<Sprite> sprite;
+  std::optional<Type> type;
+  std::optional<Projectile> projectile;
+};
+
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_ECS_COMPONENTS_H
@@ -0,0 +1,184 @@
+#include "lib/api/ecs/registry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/internal/geometry/aabb.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+
+namespace {
+
+ComponentMask MaskOf(const EntityDesc& desc) {
+  ComponentMask mask = kTransformComponent;
+  if (desc.velocity.has_value()) {
+    mask |= kVelocityComponent;
+  }
+  if (desc.collider.has_value()) {
+    mask |= kColliderComponent;
+  }
+  if (desc.sprite.has_value()) {
+    mask |= kSpriteComponent;
+  }
+  if (desc.type.has_value()) {
+    mask |= kTypeComponent;
+  }
+  if (desc.projectile.has_value()) {
+    mask |= kProjectileComponent;
+  }
+  return mask;
+}
+
+template <typename T>
+void SwapRemoveRow(std::vector<T>& column, const uint32_t row) {
+  if (column.empty()) {
+    return;
+  }
+  if (row != column.size() - 1) {
+    column[row] = std::move(column.back());
+  }
+  column.pop_back();
+}
+
+}  // namespace
+
+uint32_t Archetype::Push(const Entity entity, const EntityDesc& desc) {
+  entities_.push_back(entity);
+  transforms_.push_back(
+      {.center = desc.center, .previous_center = desc.center});
+  if (desc.velocity.has_value()) {
+    velocities_.push_back(*desc.velocity);
+  }
+  if (desc.collider.has_value()) {
+    colliders_.push_back(*desc.collider);
+  }
+  if (desc.sprite.has_value()) {
+    sprites_.push_back(*desc.sprite);
+  }
+  if (desc.type.has_value()) {
+    types_.push_back(*desc.type);
+  }
+  if (desc.projectile.has_value()) {
+    projectiles_.push_back(*desc.projectile);
+  }
+  return static_cast<uint32_t>(entities_.size()) - 1;
+}
+
+void Archetype::SwapRemove(const uint32_t row) {
+  SwapRemoveRow(entities_, row);
+  SwapRemoveRow(transforms_, row);
+  SwapRemoveRow(velocities_, row);
+  SwapRemoveRow(colliders_, row);
+  SwapRemoveRow(sprites_, row);
+  SwapRemoveRow(types_, row);
+  SwapRemoveRow(projectiles_, row);
+}
+
+Registry::Registry() : colliders_(objects::kDefaultBroadphaseCellSize) {}
+
+Entity Registry::Create(const EntityDesc& desc) {
+  CHECK(!desc.collider.has_value() || desc.type.has_value())
+      << "Entities with a collider need a type.";
+  CHECK(!desc.projectile.has_value() ||
+        (desc.velocity.has_value() && desc.collider.has_value()))
+      << "Projectiles need a velocity and a collider.";
+  uint32_t index;
+  if (free_slots_.empty()) {
+    index = static_cast<uint32_t>(slots_.size());
+    slots_.push_back({});
+  } else {
+    index = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  Slot& slot = slots_[index];
+  const Entity entity = {.index = index, .generation = slot.generation};
+  slot.archetype = FindOrCreateArchetype(MaskOf(desc));
+  slot.row = archetypes_[slot.archetype]->Push(entity, desc);
+  if (desc.collider.has_value()) {
+    colliders_.Insert(index, desc.collider->hit_box.aabb());
+  }
+  ++size_;
+  return entity;
+}
+
+bool Registry::Destroy(const Entity entity) {
+  if (!Contains(entity)) {
+    return false;
+  }
+  Slot& slot = slots_[entity.index];
+  Archetype& archetype = *archetypes_[slot.archetype];
+  if (archetype.Has<Collider>()) {
+    colliders_.Remove(entity.index);
+  }
+  archetype.SwapRemove(slot.row);
+  // The last entity of the archetype moved into the row.
+  if (slot.row < archetype.size()) {
+    slots_[archetype.entities()[slot.row].index].row = slot.row;
+  }
+  slot.archetype = internal::SlotHandle::kInvalidIndex;
+  ++slot.generation;
+  free_slots_.push_back(entity.index);
+  --size_;
+  return true;
+}
+
+bool Registry::Contains(const Entity entity) const {
+  return entity.index < slots_.size() &&
+         slots_[entity.index].generation == entity.generation &&
+         slots_[entity.index].archetype != internal::SlotHandle::kInvalidIndex;
+}
+
+void Registry::ForEachArchetype(
+    const ComponentMask mask,
+    const absl::FunctionRef<void(Archetype&)> callback) {
+  for (const std::unique_ptr<Archetype>& archetype : archetypes_) {
+    if ((archetype->mask() & mask) == mask) {
+      callback(*archetype);
+    }
+  }
+}
+
+void Registry::ForEachArchetype(
+    const ComponentMask mask,
+    const absl::FunctionRef<void(const Archetype&)> callback) const {
+  for (const std::unique_ptr<Archetype>& archetype : archetypes_) {
+    if ((archetype->mask() & mask) == mask) {
+      callback(*archetype);
+    }
+  }
+}
+
+void Registry::UpdateCollider(const Entity entity,
+                              const internal::Aabb& aabb) {
+  colliders_.Update(entity.index, aabb);
+}
+
+void Registry::QueryColliders(
+    const internal::Aabb& aabb,
+    const absl::FunctionRef<void(Entity)> callback) const {
+  colliders_.Query(aabb, [this, callback](const internal::ProxyId id) {
+    callback({.index = id, .generation = slots_[id].generation});
+  });
+}
+
+uint32_t Registry::FindOrCreateArchetype(const ComponentMask mask) {
+  const auto [it, inserted] = archetype_indices_.try_emplace(
+      mask, static_cast<uint32_t>(archetypes_.size()));
+  if (inserted) {
+    archetypes_.push_back(std::make_unique<Archetype>(mask));
+  }
+  return it->second;
+}
+
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,156 @@
+#ifndef LIB_API_ECS_REGISTRY_H
+#define LIB_API_ECS_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "lib/api/ecs/components.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/spatial_hash_grid.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+
+// Every entity with the same set of components. Each component is stored in
+// its own contiguous column, row `i` of every column belongs to
+// `entities()[i]`. Columns of components the archetype does not have are
+// empty.
+class Archetype {
+ public:
+  explicit Archetype(ComponentMask mask) : mask_(mask) {}
+
+  template <typename T>
+  [[nodiscard]] bool Has() const {
+    return (mask_ & ComponentBit<T>()) != 0;
+  }
+  template <typename T>
+  [[nodiscard]] std::span<T> column() {
+    return Column<T>();
+  }
+  template <typename T>
+  [[nodiscard]] std::span<const T> column() const {
+    return const_cast<Archetype*>(this)->Column<T>();
+  }
+  [[nodiscard]] std::span<const Entity> entities() const { return entities_; }
+  [[nodiscard]] ComponentMask mask() const { return mask_; }
+  [[nodiscard]] size_t size() const { return entities_.size(); }
+
+ private:
+  friend class Registry;
+
+  template <typename T>
+  std::vector<T>& Column() {
+    if constexpr (std::is_same_v<T, Transform>) {
+      return transforms_;
+    } else if constexpr (std::is_same_v<T, Velocity>) {
+      return velocities_;
+    } else if constexpr (std::is_same_v<T, Collider>) {
+      return colliders_;
+    } else if constexpr (std::is_same_v<T, Sprite>) {
+      return sprites_;
+    } else if constexpr (std::is_same_v<T, Type>) {
+      return types_;
+    } else {
+      return projectiles_;
+    }
+  }
+  // Returns the row of the new entity.
+  uint32_t Push(Entity entity, const EntityDesc& desc);
+  // Moves the last row into `row`.
+  void SwapRemove(uint32_t row);
+
+  const ComponentMask mask_;
+  std::vector<Entity> entities_;
+  std::vector<Transform> transforms_;
+  std::vector<Velocity> velocities_;
+  std::vector<Collider> colliders_;
+  std::vector<Sprite> sprites_;
+  std::vector<Type> types_;
+  std::vector<Projectile> projectiles_;
+};
+
+// Entities of a level, an alternative to `objects::Object` for large numbers
+// of simple things such as bullets or particles. Entities have no virtual
+// methods and no abilities, systems (see systems.h) update them one column of
+// components at a time.
+//
+// Entities with a `Collider` are kept in a spatial hash grid, so that they
+// can find each other without checking every pair. Entities collide with the
+// objects of their level as well (see `CollisionSystem`), but objects do not
+// query the grid and never collide with entities.
+class Registry {
+ public:
+  Registry();
+
+  Entity Create(const EntityDesc& desc);
+  // Returns false if `entity` is stale. Moves the last entity of the
+  // archetype into the row of `entity`.
+  bool Destroy(Entity entity);
+  [[nodiscard]] bool Contains(Entity entity) const;
+  // Null if `entity` is stale or does not have component `T`. Invalidated by
+  // `Create` and `Destroy`.
+  template <typename T>
+  [[nodiscard]] absl::Nullable<T*> Get(const Entity entity) {
+    if (!Contains(entity)) {
+      return nullptr;
+    }
+    const Slot& slot = slots_[entity.index];
+    Archetype& archetype = *archetypes_[slot.archetype];
+    return archetype.Has<T>() ? &archetype.column<T>()[slot.row] : nullptr;
+  }
+  template <typename T>
+  [[nodiscard]] absl::Nullable<const T*> Get(const Entity entity) const {
+    return const_cast<Registry*>(this)->Get<T>(entity);
+  }
+  // Calls `callback` for every archetype which has at least the components of
+  // `mask`, in the order the archetypes were created in. Entities must not be
+  // created or destroyed by `callback`.
+  void ForEachArchetype(ComponentMask mask,
+                        absl::FunctionRef<void(Archetype&)> callback);
+  void ForEachArchetype(
+      ComponentMask mask,
+      absl::FunctionRef<void(const Archetype&)> callback) const;
+  // Has to be called after the hit box of a `Collider` has moved.
+  void UpdateCollider(Entity entity, const internal::Aabb& aabb);
+  // Calls `callback` for every entity whose hit box might overlap `aabb`, in
+  // an unspecified order.
+  void QueryColliders(const internal::Aabb& aabb,
+                      absl::FunctionRef<void(Entity)> callback) const;
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+ private:
+  struct Slot {
+    uint32_t archetype = internal::SlotHandle::kInvalidIndex;
+    uint32_t row = 0;
+    // Incremented every time the entity of the slot is destroyed.
+    uint32_t generation = 0;
+  };
+
+  // Index of the archetype for `mask`, created if there is none yet.
+  uint32_t FindOrCreateArchetype(ComponentMask mask);
+
+  // Heap allocated so that archetypes do not move when more are created.
+  std::vector<std::unique_ptr<Archetype>> archetypes_;
+  absl::flat_hash_map<ComponentMask, uint32_t> archetype_indices_;
+  // Indexed by `Entity::index`, which is also the proxy id in `colliders_`.
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  internal::SpatialHashGrid colliders_;
+  size_t size_ = 0;
+};
+
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_ECS_REGISTRY_H
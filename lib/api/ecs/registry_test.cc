@@ -0,0 +1,112 @@
+#include "lib/api/ecs/registry.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+namespace {
+
+using objects::ObjectTypeFactory;
+
+EntityDesc MakeBullet(const WorldPosition center) {
+  return {.center = center,
+          .velocity = Velocity{.speed = 1, .direction_x = 1},
+          .collider = Collider{.hit_box = internal::HitBox::CreateHitBox(
+                                   FCircle{.center = center.ToFPoint(),
+                                           .radius = 1})},
+          .type = Type{.type = ObjectTypeFactory::MakeProjectilePlayer()}};
+}
+
+TEST(RegistryTest, GroupsEntitiesByComponents) {
+  Registry registry;
+
+  const Entity bullet = registry.Create(MakeBullet({1, 2}));
+  const Entity marker = registry.Create({.center = {3, 4}});
+  registry.Create(MakeBullet({5, 6}));
+
+  EXPECT_EQ(registry.size(), 3);
+  ASSERT_NE(registry.Get<Transform>(bullet), nullptr);
+  EXPECT_EQ(registry.Get<Transform>(bullet)->center, (WorldPosition{1, 2}));
+  EXPECT_EQ(registry.Get<Transform>(bullet)->previous_center,
+            (WorldPosition{1, 2}));
+  EXPECT_EQ(registry.Get<Velocity>(marker), nullptr);
+  std::vector<size_t> sizes;
+  registry.ForEachArchetype(kVelocityComponent | kColliderComponent,
+                            [&sizes](Archetype& archetype) {
+                              EXPECT_TRUE(archetype.Has<Type>());
+                              EXPECT_FALSE(archetype.Has<Sprite>());
+                              EXPECT_EQ(archetype.column<Sprite>().size(), 0);
+                              sizes.push_back(archetype.size());
+                            });
+  EXPECT_EQ(sizes, std::vector<size_t>({2}));
+  sizes.clear();
+  registry.ForEachArchetype(
+      kTransformComponent,
+      [&sizes](Archetype& archetype) { sizes.push_back(archetype.size()); });
+  EXPECT_EQ(sizes, std::vector<size_t>({2, 1}));
+}
+
+TEST(RegistryTest, DestroyMovesLastEntity) {
+  Registry registry;
+  const Entity first = registry.Create(MakeBullet({1, 1}));
+  const Entity last = registry.Create(MakeBullet({2, 2}));
+
+  EXPECT_TRUE(registry.Destroy(first));
+  EXPECT_FALSE(registry.Destroy(first));
+
+  EXPECT_FALSE(registry.Contains(first));
+  EXPECT_EQ(registry.Get<Transform>(first), nullptr);
+  ASSERT_NE(registry.Get<Transform>(last), nullptr);
+  EXPECT_EQ(registry.Get<Transform>(last)->center, (WorldPosition{2, 2}));
+  EXPECT_EQ(registry.size(), 1);
+  // The slot is reused, the stale handle still does not refer to it.
+  const Entity reused = registry.Create(MakeBullet({3, 3}));
+  EXPECT_EQ(reused.index, first.index);
+  EXPECT_FALSE(registry.Contains(first));
+  EXPECT_TRUE(registry.Contains(reused));
+}
+
+TEST(RegistryTest, QueryColliders) {
+  Registry registry;
+  const Entity near = registry.Create(MakeBullet({0, 0}));
+  const Entity far = registry.Create(MakeBullet({1000, 0}));
+  registry.Create({.center = {0, 0}});
+
+  std::vector<Entity> found;
+  registry.QueryColliders({.min_x = -5, .min_y = -5, .max_x = 5, .max_y = 5},
+                          [&found](const Entity entity) {
+                            found.push_back(entity);
+                          });
+  EXPECT_EQ(found, std::vector<Entity>({near}));
+
+  Collider& collider = *registry.Get<Collider>(far);
+  collider.hit_box.Move(-1000, 0);
+  registry.UpdateCollider(far, collider.hit_box.aabb());
+  registry.Destroy(near);
+  found.clear();
+  registry.QueryColliders({.min_x = -5, .min_y = -5, .max_x = 5, .max_y = 5},
+                          [&found](const Entity entity) {
+                            found.push_back(entity);
+                          });
+  EXPECT_EQ(found, std::vector<Entity>({far}));
+}
+
+TEST(RegistryDeathTest, ColliderWithoutType) {
+  Registry registry;
+  EntityDesc desc = MakeBullet({0, 0});
+  desc.type = std::nullopt;
+
+  EXPECT_DEATH(registry.Create(desc), "Entities with a collider need a type");
+}
+
+}  // namespace
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,263 @@
+#include "lib/api/ecs/systems.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <tuple>
+
+#include "absl/base/nullability.h"
+#include "lib/api/common_types.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/world_query.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/vec.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+
+using internal::Vector;
+using objects::LayerMask;
+using objects::ObjectType;
+using objects::ObjectTypeFactory;
+
+void MoveSystem(Registry& registry) {
+  registry.ForEachArchetype(
+      kTransformComponent | kVelocityComponent,
+      [&registry](Archetype& archetype) {
+        const std::span<Transform> transforms = archetype.column<Transform>();
+        const std::span<const Velocity> velocities =
+            archetype.column<Velocity>();
+        for (size_t i = 0; i < transforms.size(); ++i) {
+          transforms[i].previous_center = transforms[i].center;
+          transforms[i].center.x +=
+              velocities[i].speed * velocities[i].direction_x;
+          transforms[i].center.y +=
+              velocities[i].speed * velocities[i].direction_y;
+        }
+        if (!archetype.Has<Collider>()) {
+          return;
+        }
+        const std::span<Collider> colliders = archetype.column<Collider>();
+        for (size_t i = 0; i < colliders.size(); ++i) {
+          const float x = velocities[i].speed * velocities[i].direction_x;
+          const float y = velocities[i].speed * velocities[i].direction_y;
+          if (x == 0 && y == 0) {
+            continue;
+          }
+          colliders[i].hit_box.Move(x, y);
+          registry.UpdateCollider(archetype.entities()[i],
+                                  colliders[i].hit_box.aabb());
+        }
+      });
+}
+
+void AnimationSystem(Registry& registry) {
+  registry.ForEachArchetype(kSpriteComponent, [](Archetype& archetype) {
+    for (Sprite& sprite : archetype.column<Sprite>()) {
+      if (sprite.steps_per_frame == 0 ||
+          ++sprite.steps_on_frame < sprite.steps_per_frame) {
+        continue;
+      }
+      sprite.steps_on_frame = 0;
+      sprite.frame = (sprite.frame + 1) % sprite.sprite->total_frames();
+    }
+  });
+}
+
+void RecordSystem(const Registry& registry,
+                  const std::optional<internal::Aabb> screen,
+                  RenderSnapshot& snapshot) {
+  registry.ForEachArchetype(
+      kTransformComponent, [&screen, &snapshot](const Archetype& archetype) {
+        const bool has_sprite = archetype.Has<Sprite>();
+        const bool has_collider = archetype.Has<Collider>();
+        if (!has_sprite && !has_collider) {
+          return;
+        }
+        const std::span<const Transform> transforms =
+            archetype.column<Transform>();
+        const std::span<const Sprite> sprites = archetype.column<Sprite>();
+        const std::span<const Collider> colliders =
+            archetype.column<Collider>();
+        for (size_t i = 0; i < transforms.size(); ++i) {
+          const Sprite* sprite = has_sprite ? &sprites[i] : nullptr;
+          const Collider* collider =
+              has_collider && colliders[i].should_draw_hit_box ? &colliders[i]
+                                                               : nullptr;
+          if (sprite == nullptr && collider == nullptr) {
+            continue;
+          }
+          const WorldPosition center = transforms[i].center;
+          const float half_height =
+              sprite == nullptr
+                  ? 0
+                  : static_cast<float>(sprite->sprite->sprite_height()) / 2;
+          if (screen.has_value()) {
+            // Same bounds as `Level::ShouldDraw` uses for objects.
+            const float half_width =
+                sprite == nullptr
+                    ? 0
+                    : static_cast<float>(sprite->sprite->sprite_width()) / 2;
+            const internal::Aabb bounds =
+                sprite == nullptr
+                    ? collider->hit_box.aabb()
+                    : internal::Aabb{.min_x = center.x - half_width,
+                                     .min_y = center.y - half_height,
+                                     .max_x = center.x + half_width,
+                                     .max_y = center.y + half_height};
+            if (!screen->Overlaps(bounds)) {
+              continue;
+            }
+          }
+          RenderItem& item = snapshot.Add(
+              static_cast<int>(center.y) + static_cast<int>(half_height),
+              transforms[i].previous_center, center);
+          if (sprite != nullptr) {
+            item.sprite = sprite->sprite;
+            item.frame = sprite->frame;
+          }
+          if (collider != nullptr) {
+            item.hit_box = collider->hit_box;
+          }
+        }
+      });
+}
+
+void CollisionSystem::Run(Registry& registry,
+                          const objects::WorldQuery& world) {
+  contacts_.clear();
+  registry.ForEachArchetype(
+      kTransformComponent | kVelocityComponent | kColliderComponent |
+          kTypeComponent,
+      [this, &registry, &world](Archetype& archetype) {
+        for (size_t row = 0; row < archetype.size(); ++row) {
+          const std::optional<Contact> contact =
+              FindContact(registry, world, archetype, row);
+          if (contact.has_value()) {
+            contacts_.push_back(*contact);
+          }
+        }
+      });
+  for (const Contact& contact : contacts_) {
+    Apply(registry, contact);
+  }
+}
+
+CollisionSystem::Response CollisionSystem::Respond(
+    const ObjectType other, const Projectile* const projectile) {
+  if (projectile == nullptr) {
+    return Response::kStepBack;
+  }
+  if (projectile->despawn_outside_screen_area && other.IsScreenEdge()) {
+    return Response::kDespawn;
+  }
+  if (other.IsIn(projectile->despawn_on_colliding_with_these_objects)) {
+    return Response::kDespawn;
+  }
+  if (other.IsIn(projectile->reflect_on_colliding_with_these_objects)) {
+    return Response::kReflect;
+  }
+  return Response::kNone;
+}
+
+std::optional<CollisionSystem::Contact> CollisionSystem::FindContact(
+    const Registry& registry, const objects::WorldQuery& world,
+    const Archetype& archetype, const size_t row) {
+  const Entity entity = archetype.entities()[row];
+  const internal::HitBox& hit_box = archetype.column<Collider>()[row].hit_box;
+  const Velocity& velocity = archetype.column<Velocity>()[row];
+  const Projectile* const projectile =
+      archetype.Has<Projectile>() ? &archetype.column<Projectile>()[row]
+                                  : nullptr;
+  LayerMask collides_with = archetype.column<Type>()[row].collides_with;
+  if (projectile != nullptr && projectile->despawn_outside_screen_area) {
+    collides_with |= objects::MakeLayerMask(
+        {ObjectTypeFactory::MakeScreenLeft(),
+         ObjectTypeFactory::MakeScreenRight(),
+         ObjectTypeFactory::MakeScreenTop(),
+         ObjectTypeFactory::MakeScreenBottom()});
+  }
+  Contact contact = {.entity = entity,
+                     .response = Response::kNone,
+                     .direction_x = velocity.direction_x,
+                     .direction_y = velocity.direction_y};
+
+  // Objects come first, in the order they were added.
+  world.QueryHitBox(hit_box, objects_, collides_with);
+  for (const objects::Object* object : objects_) {
+    contact.response = Respond(object->type(), projectile);
+    if (contact.response == Response::kNone) {
+      continue;
+    }
+    if (contact.response == Response::kReflect) {
+      std::tie(contact.direction_x, contact.direction_y) =
+          object->Reflect(hit_box, velocity.direction_x, velocity.direction_y);
+    }
+    return contact;
+  }
+
+  // Then the other entities, in the order of their handles.
+  entities_.clear();
+  registry.QueryColliders(hit_box.aabb(), [this, entity](const Entity other) {
+    if (other != entity) {
+      entities_.push_back(other);
+    }
+  });
+  std::ranges::sort(entities_, [](const Entity& a, const Entity& b) {
+    return a.index < b.index;
+  });
+  for (const Entity other : entities_) {
+    const ObjectType other_type = registry.Get<Type>(other)->type;
+    const internal::HitBox& other_hit_box =
+        registry.Get<Collider>(other)->hit_box;
+    if (!other_type.IsIn(collides_with) ||
+        !hit_box.CollidesWith(other_hit_box)) {
+      continue;
+    }
+    contact.response = Respond(other_type, projectile);
+    if (contact.response == Response::kNone) {
+      continue;
+    }
+    if (contact.response == Response::kReflect) {
+      std::tie(contact.direction_x, contact.direction_y) =
+          other_hit_box.Reflect(hit_box, velocity.direction_x,
+                                velocity.direction_y);
+    }
+    return contact;
+  }
+  return std::nullopt;
+}
+
+void CollisionSystem::Apply(Registry& registry, const Contact& contact) const {
+  if (contact.response == Response::kDespawn) {
+    registry.Destroy(contact.entity);
+    return;
+  }
+  if (contact.response == Response::kReflect) {
+    Velocity& velocity = *registry.Get<Velocity>(contact.entity);
+    const Vector direction = {contact.direction_x, contact.direction_y};
+    const Vector unit =
+        direction.IsZero() ? Vector{0, 0} : direction.ToUnitVector();
+    velocity.direction_x = unit.x;
+    velocity.direction_y = unit.y;
+  }
+  // Steps back, so that the entity does not end up inside the one it has
+  // collided with.
+  Transform& transform = *registry.Get<Transform>(contact.entity);
+  Collider& collider = *registry.Get<Collider>(contact.entity);
+  collider.hit_box.Move(transform.previous_center.x - transform.center.x,
+                        transform.previous_center.y - transform.center.y);
+  transform.center = transform.previous_center;
+  registry.UpdateCollider(contact.entity, collider.hit_box.aabb());
+}
+
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
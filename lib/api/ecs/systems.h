@@ -0,0 +1,85 @@
+#ifndef LIB_API_ECS_SYSTEMS_H
+#define LIB_API_ECS_SYSTEMS_H
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/world_query.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/internal/geometry/aabb.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+
+// Saves the previous center of every moving entity and moves it, together
+// with its hit box, like `objects::MovableObject::Move`.
+void MoveSystem(Registry& registry);
+
+// Advances the animations of sprites by one simulation step.
+void AnimationSystem(Registry& registry);
+
+// Adds every entity with a sprite or a drawn hit box to `snapshot`. Entities
+// outside of `screen` are left out when it is set.
+void RecordSystem(const Registry& registry,
+                  std::optional<internal::Aabb> screen,
+                  RenderSnapshot& snapshot);
+
+// Collisions of moving entities, with the objects of a level and with the
+// other entities. `Type::collides_with` selects what an entity collides with.
+// Like `objects::ContactList`, every collision is found before any entity
+// responds to them, and every entity responds to its first collision which
+// changes its state only, objects are checked before entities:
+//  * Entities with a `Projectile` despawn or reflect, see
+//    `objects::ProjectileObject`.
+//  * Other moving entities step back to where they were before the step.
+// Entities never change objects: objects do not collide with entities.
+class CollisionSystem {
+ public:
+  // `world` finds the objects, it has to see where they are after the step.
+  void Run(Registry& registry, const objects::WorldQuery& world);
+
+ private:
+  enum class Response {
+    kNone,
+    kDespawn,
+    kReflect,
+    kStepBack,
+  };
+
+  struct Contact {
+    Entity entity;
+    Response response;
+    // New direction when reflecting.
+    float direction_x;
+    float direction_y;
+  };
+
+  // Response of an entity to colliding with something of type `other`.
+  // `projectile` is null for entities without a `Projectile`.
+  [[nodiscard]] static Response Respond(
+      objects::ObjectType other, absl::Nullable<const Projectile*> projectile);
+  // Finds the first collision of the entity in `row` of `archetype` which it
+  // responds to.
+  [[nodiscard]] std::optional<Contact> FindContact(
+      const Registry& registry, const objects::WorldQuery& world,
+      const Archetype& archetype, size_t row);
+  void Apply(Registry& registry, const Contact& contact) const;
+
+  // Reused between runs so that no step allocates once they are large
+  // enough.
+  std::vector<Contact> contacts_;
+  std::vector<objects::Object*> objects_;
+  std::vector<Entity> entities_;
+};
+
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_ECS_SYSTEMS_H
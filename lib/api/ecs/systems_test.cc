@@ -0,0 +1,215 @@
+#include "lib/api/ecs/systems.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
+#include "lib/api/graphics.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/api/sprites/sprite.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace ecs {
+namespace {
+
+using objects::MakeLayerMask;
+using objects::Object;
+using objects::ObjectType;
+using objects::ObjectTypeFactory;
+using objects::StaticObject;
+
+class FakeSprite : public sprites::Sprite {
+ public:
+  void RotateAndDraw(WorldPosition /*draw_destination*/, int /*degree*/,
+                     int /*frame_to_draw*/) const override {}
+  [[nodiscard]] int total_frames() const override { return 3; }
+  [[nodiscard]] int sprite_width() const override { return 10; }
+  [[nodiscard]] int sprite_height() const override { return 20; }
+  [[nodiscard]] const GraphicsInterface* GraphicsForTesting() const override {
+    return nullptr;
+  }
+};
+
+EntityDesc MakeMoving(const WorldPosition center, const float direction_x,
+                      const float direction_y, const ObjectType type,
+                      const objects::LayerMask collides_with) {
+  return {.center = center,
+          .velocity = Velocity{.speed = 2,
+                               .direction_x = direction_x,
+                               .direction_y = direction_y},
+          .collider = Collider{.hit_box = internal::HitBox::CreateHitBox(
+                                   FCircle{.center = center.ToFPoint(),
+                                           .radius = 1})},
+          .type = Type{.type = type, .collides_with = collides_with}};
+}
+
+EntityDesc MakeWall(const FLine& line) {
+  return {.center = {(line.a.x + line.b.x) / 2, (line.a.y + line.b.y) / 2},
+          .collider = Collider{.hit_box = internal::HitBox::CreateHitBox(line)},
+          .type = Type{.type = ObjectTypeFactory::MakeWorldBorder()}};
+}
+
+class CollisionSystemTest : public ::testing::Test {
+ protected:
+  CollisionSystemTest() : world_(objects_) {}
+
+  void AddObject(const ObjectType type, const FLine& line) {
+    owned_objects_.push_back(std::make_unique<StaticObject>(
+        type,
+        StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                       .should_draw_hit_box = false},
+        line));
+    objects_.push_back(owned_objects_.back().get());
+  }
+
+  void Step() {
+    MoveSystem(registry_);
+    collisions_.Run(registry_, world_);
+  }
+
+  Registry registry_;
+  CollisionSystem collisions_;
+  std::vector<std::unique_ptr<Object>> owned_objects_;
+  std::vector<Object*> objects_;
+  objects::WorldQuery world_;
+};
+
+TEST(MoveSystemTest, MovesTransformAndHitBox) {
+  Registry registry;
+  const Entity entity = registry.Create(MakeMoving(
+      {0, 0}, 1, 0, ObjectTypeFactory::MakeProjectilePlayer(), 0));
+  const Entity still = registry.Create({.center = {5, 5}});
+
+  MoveSystem(registry);
+
+  EXPECT_EQ(registry.Get<Transform>(entity)->previous_center,
+            (WorldPosition{0, 0}));
+  EXPECT_EQ(registry.Get<Transform>(entity)->center, (WorldPosition{2, 0}));
+  EXPECT_FLOAT_EQ(registry.Get<Collider>(entity)->hit_box.center_x(), 2);
+  EXPECT_EQ(registry.Get<Transform>(still)->center, (WorldPosition{5, 5}));
+  int found = 0;
+  registry.QueryColliders(
+      {.min_x = 2.5f, .min_y = -1, .max_x = 3, .max_y = 1},
+      [&found](Entity /*entity*/) { ++found; });
+  EXPECT_EQ(found, 1);
+}
+
+TEST(AnimationSystemTest, AdvancesFrames) {
+  const FakeSprite fake_sprite;
+  Registry registry;
+  const Entity animated = registry.Create(
+      {.center = {0, 0},
+       .sprite = Sprite{.sprite = &fake_sprite, .steps_per_frame = 2}});
+  const Entity still = registry.Create(
+      {.center = {0, 0}, .sprite = Sprite{.sprite = &fake_sprite}});
+
+  for (int step = 0; step < 5; ++step) {
+    AnimationSystem(registry);
+  }
+
+  EXPECT_EQ(registry.Get<Sprite>(animated)->frame, 2);
+  EXPECT_EQ(registry.Get<Sprite>(still)->frame, 0);
+  AnimationSystem(registry);
+  EXPECT_EQ(registry.Get<Sprite>(animated)->frame, 0);
+}
+
+TEST(RecordSystemTest, RecordsEntitiesOnScreen) {
+  const FakeSprite fake_sprite;
+  Registry registry;
+  registry.Create({.center = {10, 10},
+                   .sprite = Sprite{.sprite = &fake_sprite, .frame = 1}});
+  registry.Create(
+      {.center = {500, 500}, .sprite = Sprite{.sprite = &fake_sprite}});
+  registry.Create(
+      {.center = {20, 20},
+       .collider = Collider{.hit_box = internal::HitBox::CreateHitBox(
+                                FCircle{.center = {20, 20}, .radius = 2}),
+                            .should_draw_hit_box = true},
+       .type = Type{.type = ObjectTypeFactory::MakeEnemy()}});
+  // Nothing to draw.
+  registry.Create({.center = {30, 30}});
+  RenderSnapshot snapshot;
+
+  RecordSystem(registry, internal::Aabb{0, 0, 100, 100}, snapshot);
+
+  ASSERT_EQ(snapshot.items().size(), 2);
+  EXPECT_EQ(snapshot.items()[0].center, (WorldPosition{10, 10}));
+  EXPECT_EQ(snapshot.items()[0].y_base, 20);
+  EXPECT_EQ(snapshot.items()[0].sprite, &fake_sprite);
+  EXPECT_EQ(snapshot.items()[0].frame, 1);
+  EXPECT_EQ(snapshot.items()[1].center, (WorldPosition{20, 20}));
+  EXPECT_TRUE(snapshot.items()[1].hit_box.has_value());
+  snapshot.Clear();
+  RecordSystem(registry, /*screen=*/std::nullopt, snapshot);
+  EXPECT_EQ(snapshot.items().size(), 3);
+}
+
+TEST_F(CollisionSystemTest, RespondsLikeProjectileObject) {
+  const ObjectType projectile_type = ObjectTypeFactory::MakeProjectilePlayer();
+  const objects::LayerMask walls =
+      MakeLayerMask({ObjectTypeFactory::MakeWorldBorder()});
+  const objects::LayerMask enemies =
+      MakeLayerMask({ObjectTypeFactory::MakeEnemy()});
+  EntityDesc reflected = MakeMoving({0, 0}, 1, 0, projectile_type, walls);
+  reflected.projectile =
+      Projectile{.reflect_on_colliding_with_these_objects = walls};
+  EntityDesc despawned = MakeMoving({0, 20}, 1, 0, projectile_type, enemies);
+  despawned.projectile =
+      Projectile{.despawn_on_colliding_with_these_objects = enemies};
+  EntityDesc leaves_screen = MakeMoving({0, 40}, 0, 1, projectile_type, 0);
+  leaves_screen.projectile = Projectile{.despawn_outside_screen_area = true};
+  const Entity reflected_entity = registry_.Create(reflected);
+  const Entity despawned_entity = registry_.Create(despawned);
+  const Entity leaves_screen_entity = registry_.Create(leaves_screen);
+  registry_.Create(MakeWall({.a = {3, -5}, .b = {3, 5}}));
+  AddObject(ObjectTypeFactory::MakeEnemy(), {.a = {3, 15}, .b = {3, 25}});
+  AddObject(ObjectTypeFactory::MakeScreenBottom(),
+            {.a = {-10, 43}, .b = {10, 43}});
+
+  Step();
+
+  ASSERT_TRUE(registry_.Contains(reflected_entity));
+  EXPECT_EQ(registry_.Get<Transform>(reflected_entity)->center,
+            (WorldPosition{0, 0}));
+  EXPECT_FLOAT_EQ(registry_.Get<Velocity>(reflected_entity)->direction_x, -1);
+  EXPECT_FLOAT_EQ(
+      registry_.Get<Collider>(reflected_entity)->hit_box.center_x(), 0);
+  EXPECT_FALSE(registry_.Contains(despawned_entity));
+  EXPECT_FALSE(registry_.Contains(leaves_screen_entity));
+  Step();
+  EXPECT_EQ(registry_.Get<Transform>(reflected_entity)->center,
+            (WorldPosition{-2, 0}));
+}
+
+TEST_F(CollisionSystemTest, StepsBackLikeMovableObject) {
+  const Entity blocked = registry_.Create(MakeMoving(
+      {0, 0}, 1, 0, ObjectTypeFactory::MakePlayer(),
+      MakeLayerMask({ObjectTypeFactory::MakeWorldBorder()})));
+  // Not in the layers of `blocked`.
+  const Entity passes = registry_.Create(
+      MakeMoving({0, 20}, 1, 0, ObjectTypeFactory::MakePlayer(), 0));
+  AddObject(ObjectTypeFactory::MakeWorldBorder(), {.a = {3, -5}, .b = {3, 5}});
+  AddObject(ObjectTypeFactory::MakeWorldBorder(),
+            {.a = {3, 15}, .b = {3, 25}});
+
+  Step();
+  Step();
+
+  EXPECT_EQ(registry_.Get<Transform>(blocked)->center, (WorldPosition{0, 0}));
+  EXPECT_FLOAT_EQ(registry_.Get<Velocity>(blocked)->direction_x, 1);
+  EXPECT_EQ(registry_.Get<Transform>(passes)->center, (WorldPosition{4, 20}));
+}
+
+}  // namespace
+}  // namespace ecs
+}  // namespace api
+}  // namespace lib
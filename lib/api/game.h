@@ -27,6 +27,9 @@ class Game {
     int screen_height;
     bool full_screen;
     std::string title;
+    // Frames drawn per second, 0 draws as fast as possible. Levels simulate
+    // at their own rate, see `LevelBuilder::WithSimulationRate`.
+    int target_fps = 120;
   };
 
   static Game& Create(GameOpts opts) {
@@ -54,7 +57,8 @@ class Game {
     Game::screen_width_ = GetScreenWidth();
     Game::screen_height_ = GetScreenHeight();
 
-    static Game game(opts.native_screen_width, opts.native_screen_height);
+    static Game game(opts.native_screen_width, opts.native_screen_height,
+                     opts.target_fps);
     return game;
   }
   ~Game();
@@ -79,9 +83,11 @@ class Game {
   Factories& factories() { return factories_; }
 
  private:
-  Game(const int native_screen_width, const int native_screen_height)
+  Game(const int native_screen_width, const int native_screen_height,
+       const int target_fps)
       : native_screen_width_(native_screen_width),
         native_screen_height_(native_screen_height),
+        target_fps_(target_fps),
         factories_(Factories{
             sprites::SpriteFactory(static_cast<float>(native_screen_width_),
                                    static_cast<float>(native_screen_height_)),
@@ -94,6 +100,7 @@ class Game {
   static inline int screen_height_ = 0;
   const int native_screen_width_;
   const int native_screen_height_;
+  const int target_fps_;
 
   Factories factories_;
 };
@@ -0,0 +1,190 @@
+#include "lib/api/input_log.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/api/common_types.h"
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+
+namespace {
+
+constexpr std::string_view kMagic = "FEIL";
+constexpr uint8_t kVersion = 1;
+
+constexpr uint8_t kPrimaryPressed = 1 << 0;
+constexpr uint8_t kSecondaryPressed = 1 << 1;
+constexpr uint8_t kCursorMoved = 1 << 2;
+
+// Integers are little endian, whatever the machine.
+template <typename T>
+void Write(const T value, std::string& out) {
+  for (size_t byte = 0; byte < sizeof(T); ++byte) {
+    out.push_back(static_cast<char>((value >> (8 * byte)) & 0xff));
+  }
+}
+
+void WriteFloat(const float value, std::string& out) {
+  Write(std::bit_cast<uint32_t>(value), out);
+}
+
+void WriteKeys(const std::vector<Button>& keys, std::string& out) {
+  Write(static_cast<uint16_t>(keys.size()), out);
+  for (const Button key : keys) {
+    Write(static_cast<uint16_t>(key), out);
+  }
+}
+
+class Reader {
+ public:
+  explicit Reader(const std::string_view data) : data_(data) {}
+
+  template <typename T>
+  [[nodiscard]] bool Read(T& value) {
+    if (data_.size() < sizeof(T)) {
+      return false;
+    }
+    value = 0;
+    for (size_t byte = 0; byte < sizeof(T); ++byte) {
+      value |= static_cast<T>(static_cast<uint8_t>(data_[byte])) << (8 * byte);
+    }
+    data_.remove_prefix(sizeof(T));
+    return true;
+  }
+
+  [[nodiscard]] bool ReadFloat(float& value) {
+    uint32_t bits;
+    if (!Read(bits)) {
+      return false;
+    }
+    value = std::bit_cast<float>(bits);
+    return true;
+  }
+
+  [[nodiscard]] bool ReadKeys(std::vector<Button>& keys) {
+    uint16_t count;
+    if (!Read(count)) {
+      return false;
+    }
+    keys.resize(count);
+    for (Button& key : keys) {
+      uint16_t read_key;
+      if (!Read(read_key)) {
+        return false;
+      }
+      key = read_key;
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool ReadMagic() {
+    if (!data_.starts_with(kMagic)) {
+      return false;
+    }
+    data_.remove_prefix(kMagic.size());
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+}  // namespace
+
+std::string InputLog::Serialize() const {
+  std::string out(kMagic);
+  Write(kVersion, out);
+  Write(static_cast<uint32_t>(steps_.size()), out);
+  ScreenPosition cursor_pos = {.x = 0, .y = 0};
+  for (const ScriptedInput& input : steps_) {
+    uint8_t flags = 0;
+    if (input.primary_pressed) {
+      flags |= kPrimaryPressed;
+    }
+    if (input.secondary_pressed) {
+      flags |= kSecondaryPressed;
+    }
+    // `ScreenPosition` compares with a tolerance, replays need the exact
+    // cursor.
+    if (input.cursor_pos.x != cursor_pos.x ||
+        input.cursor_pos.y != cursor_pos.y) {
+      flags |= kCursorMoved;
+    }
+    Write(flags, out);
+    if (flags & kCursorMoved) {
+      WriteFloat(input.cursor_pos.x, out);
+      WriteFloat(input.cursor_pos.y, out);
+      cursor_pos = input.cursor_pos;
+    }
+    WriteKeys(input.pressed, out);
+    WriteKeys(input.down, out);
+  }
+  return out;
+}
+
+std::optional<InputLog> InputLog::Parse(const std::string_view data) {
+  Reader reader(data);
+  uint8_t version;
+  uint32_t num_steps;
+  if (!reader.ReadMagic() || !reader.Read(version) || version != kVersion ||
+      !reader.Read(num_steps)) {
+    return std::nullopt;
+  }
+  InputLog log;
+  ScreenPosition cursor_pos = {.x = 0, .y = 0};
+  for (uint32_t step = 0; step < num_steps; ++step) {
+    ScriptedInput input;
+    uint8_t flags;
+    if (!reader.Read(flags)) {
+      return std::nullopt;
+    }
+    if ((flags & kCursorMoved) && (!reader.ReadFloat(cursor_pos.x) ||
+                                   !reader.ReadFloat(cursor_pos.y))) {
+      return std::nullopt;
+    }
+    input.primary_pressed = flags & kPrimaryPressed;
+    input.secondary_pressed = flags & kSecondaryPressed;
+    input.cursor_pos = cursor_pos;
+    if (!reader.ReadKeys(input.pressed) || !reader.ReadKeys(input.down)) {
+      return std::nullopt;
+    }
+    log.Record(std::move(input));
+  }
+  if (!reader.empty()) {
+    return std::nullopt;
+  }
+  return log;
+}
+
+bool InputLog::Save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  const std::string data = Serialize();
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return static_cast<bool>(file);
+}
+
+std::optional<InputLog> InputLog::Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  std::ostringstream data;
+  data << file.rdbuf();
+  return Parse(data.str());
+}
+
+}  // namespace api
+}  // namespace lib
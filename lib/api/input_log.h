@@ -0,0 +1,47 @@
+#ifndef LIB_API_INPUT_LOG_H
+#define LIB_API_INPUT_LOG_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+
+// Input of every simulation step of a run, recorded by `Level::RecordInput`
+// and replayed by `Level::RunHeadless`, or through `ScriptedControls` by
+// building an `InputScript` from `steps()`.
+//
+// Serialized into a compact binary log: a header followed by every step, the
+// cursor of a step only when it has moved since the step before.
+class InputLog {
+ public:
+  InputLog() = default;
+  explicit InputLog(std::vector<ScriptedInput> steps)
+      : steps_(std::move(steps)) {}
+
+  void Record(ScriptedInput input) { steps_.push_back(std::move(input)); }
+  [[nodiscard]] const std::vector<ScriptedInput>& steps() const {
+    return steps_;
+  }
+
+  [[nodiscard]] std::string Serialize() const;
+  // Not set when `data` is not a log of this version.
+  [[nodiscard]] static std::optional<InputLog> Parse(std::string_view data);
+  // Returns false when the file could not be written.
+  [[nodiscard]] bool Save(const std::string& path) const;
+  // Not set when the file could not be read or is not a log.
+  [[nodiscard]] static std::optional<InputLog> Load(const std::string& path);
+
+ private:
+  std::vector<ScriptedInput> steps_;
+};
+
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_INPUT_LOG_H
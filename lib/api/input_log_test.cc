@@ -0,0 +1,66 @@
+#include "lib/api/input_log.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+namespace {
+
+InputLog MakeLog() {
+  InputLog log;
+  log.Record({.pressed = {kKeySpace},
+              .down = {kKeyA, kKeyW},
+              .primary_pressed = true,
+              .cursor_pos = {.x = 3.5f, .y = 4}});
+  log.Record({.down = {kKeyD},
+              .secondary_pressed = true,
+              .cursor_pos = {.x = 3.5f, .y = 4}});
+  log.Record({});
+  return log;
+}
+
+TEST(InputLogTest, SerializeAndParse) {
+  const InputLog log = MakeLog();
+
+  const std::string data = log.Serialize();
+  const std::optional<InputLog> parsed = InputLog::Parse(data);
+
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->steps(), log.steps());
+  // Header of 9 bytes, the cursor is only written when it moves.
+  EXPECT_EQ(data.size(), 9 + (1 + 8 + 2 + 2 + 2 + 4) + (1 + 2 + 2 + 2) +
+                             (1 + 8 + 2 + 2));
+}
+
+TEST(InputLogTest, ParseRejectsMalformed) {
+  const std::string data = MakeLog().Serialize();
+
+  EXPECT_FALSE(InputLog::Parse("").has_value());
+  EXPECT_FALSE(InputLog::Parse("FEIX").has_value());
+  EXPECT_FALSE(InputLog::Parse(data.substr(0, data.size() - 1)).has_value());
+  EXPECT_FALSE(InputLog::Parse(data + "x").has_value());
+  std::string other_version = data;
+  other_version[4] = 2;
+  EXPECT_FALSE(InputLog::Parse(other_version).has_value());
+}
+
+TEST(InputLogTest, SaveAndLoad) {
+  const InputLog log = MakeLog();
+  const std::string path = ::testing::TempDir() + "/input_log";
+
+  ASSERT_TRUE(log.Save(path));
+  const std::optional<InputLog> loaded = InputLog::Load(path);
+
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->steps(), log.steps());
+  EXPECT_FALSE(InputLog::Load(path + "_missing").has_value());
+}
+
+}  // namespace
+}  // namespace api
+}  // namespace lib
@@ -3,48 +3,46 @@
 #include "lib/api/level.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <list>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "absl/log/check.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "lib/api/abilities/ability.h"
 #include "lib/api/common_types.h"
 #include "lib/api/controls.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
+#include "lib/api/ecs/systems.h"
+#include "lib/api/input_log.h"
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/profiler_overlay.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/api/stats.h"
+#include "lib/internal/background_thread.h"
+#include "lib/internal/frame_profiler.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/job_system.h"
+#include "lib/internal/slot_map.h"
+#include "lib/internal/state_hash.h"
 
 namespace lib {
 namespace api {
 
+using internal::FramePhase;
+using internal::ScopedPhaseTimer;
+
 using abilities::Ability;
 using api::ObjectAndAbilities;
 using objects::MovableObject;
 using objects::Object;
-using objects::StaticObject;
-
-namespace {
-
-StaticObject MakeSpriteBoundingBox(const Object& object) {
-  const float half_sprite_width =
-      static_cast<float>(object.active_sprite_instance()->SpriteWidth()) / 2.0f;
-  const float half_sprite_height =
-      static_cast<float>(object.active_sprite_instance()->SpriteHeight()) /
-      2.0f;
-  const float upper_left_x = object.center().x - half_sprite_width;
-  const float upper_left_y = object.center().y - half_sprite_height;
-
-  return StaticObject(
-      /*type=*/objects::ObjectTypeFactory::MakeSpriteBoundingBox(),
-      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
-                                     .should_draw_hit_box = false},
-      FRectangle{.top_left = {upper_left_x, upper_left_y},
-                 .width = static_cast<float>(
-                     object.active_sprite_instance()->SpriteWidth()),
-                 .height = static_cast<float>(
-                     object.active_sprite_instance()->SpriteHeight())});
-}
-
-}  // namespace
 
 LevelId Level::MaybeChangeLevel() const {
   if (controls_->IsPressed(kKeyEscape)) {
@@ -54,43 +52,135 @@ LevelId Level::MaybeChangeLevel() const {
   return id();
 }
 
-bool Level::ShouldDraw(const Object& object) const {
+std::optional<internal::Aabb> Level::ScreenArea() const {
   if (screen_edge_objects_.empty()) {
+    return std::nullopt;
+  }
+  return internal::Aabb{.min_x = screen_edge_objects_[0]->center().x,
+                        .min_y = screen_edge_objects_[2]->center().y,
+                        .max_x = screen_edge_objects_[1]->center().x,
+                        .max_y = screen_edge_objects_[3]->center().y};
+}
+
+bool Level::ShouldDraw(const Object& object) const {
+  const std::optional<internal::Aabb> screen = ScreenArea();
+  if (!screen.has_value()) {
     return true;
   }
   if (object.active_sprite_instance()) {
-    const StaticObject sprite_bounding_box = MakeSpriteBoundingBox(object);
-    for (const auto& screen_edge_object : screen_edge_objects_) {
-      if (screen_edge_object->CollidesWith(sprite_bounding_box)) {
-        return true;
-      }
+    // Compares the bounding box of the sprite with the screen directly,
+    // building an object for it would allocate its hit box.
+    const float half_sprite_width =
+        static_cast<float>(object.active_sprite_instance()->SpriteWidth()) /
+        2.0f;
+    const float half_sprite_height =
+        static_cast<float>(object.active_sprite_instance()->SpriteHeight()) /
+        2.0f;
+    return screen->Overlaps({.min_x = object.center().x - half_sprite_width,
+                             .min_y = object.center().y - half_sprite_height,
+                             .max_x = object.center().x + half_sprite_width,
+                             .max_y = object.center().y + half_sprite_height});
+  }
+  for (const auto& screen_edge_object : screen_edge_objects_) {
+    if (screen_edge_object->CollidesWith(object)) {
+      return true;
     }
-  } else {
-    for (const auto& screen_edge_object : screen_edge_objects_) {
-      if (screen_edge_object->CollidesWith(object)) {
-        return true;
-      }
+  }
+  return screen->Overlaps({.min_x = object.center().x,
+                           .min_y = object.center().y,
+                           .max_x = object.center().x,
+                           .max_y = object.center().y});
+}
+
+void Level::CleanUp() {
+  bool erased = false;
+  for (size_t i = 0; i < objects_.size();) {
+    Object& object = *objects_.values()[i].first;
+    if (!object.deleted()) {
+      ++i;
+      continue;
     }
+    if (collision_index_) {
+      collision_index_->Remove(object);
+    }
+    std::erase(clicked_objects_, &object);
+    object_pools_.Recycle(std::move(objects_.values()[i].first));
+    // The last object moves to `i`, it is checked next.
+    objects_.Erase(objects_.handle(i));
+    erased = true;
+  }
+  if (!erased) {
+    return;
+  }
+  object_pointers_.clear();
+  for (const auto& [object, abilities] : objects_) {
+    object_pointers_.push_back(object.get());
   }
-  return screen_edge_objects_[0]->center().x <= object.center().x &&
-         object.center().x <= screen_edge_objects_[1]->center().x &&
-         screen_edge_objects_[2]->center().y <= object.center().y &&
-         object.center().y <= screen_edge_objects_[3]->center().y;
 }
 
-void Level::CleanUpOrDie() {
-  auto object_it = objects_.begin();
-  auto ability_it = abilities_.begin();
-  CHECK(objects_.size() == abilities_.size())
-      << "Abilities and Objects are out of sync, abilities size: "
-      << abilities_.size() << ", objects size: " << objects_.size();
-  while (object_it != objects_.end() && ability_it != abilities_.end()) {
-    if (object_it->get()->deleted()) {
-      object_it = objects_.erase(object_it);
-      ability_it = abilities_.erase(ability_it);
+internal::SlotHandle Level::InsertObject(
+    std::unique_ptr<Object> object,
+    std::list<std::unique_ptr<Ability>> abilities) {
+  object_pointers_.push_back(object.get());
+  return objects_.Insert({std::move(object), std::move(abilities)});
+}
+
+Object* Level::FindObject(const internal::SlotHandle handle) const {
+  const ObjectAndAbilities* object_and_abilities = objects_.Find(handle);
+  return object_and_abilities == nullptr ? nullptr
+                                         : object_and_abilities->first.get();
+}
+
+const Object* Level::CameraObject() const {
+  const std::optional<internal::SlotHandle> bound = camera_.bound();
+  return bound.has_value() ? FindObject(*bound) : nullptr;
+}
+
+void Level::SetBroadphase(const objects::BroadphaseType type) {
+  collision_index_ = objects::BroadphaseCollisionIndex::Create(type);
+  world_query_.set_collision_index(collision_index_.get());
+}
+
+void Level::SetThreads(const int num_threads) {
+  CHECK(num_threads > 0) << "At least one thread is required, have: "
+                         << num_threads;
+  jobs_ = num_threads == 1 ? nullptr
+                           : std::make_unique<internal::JobSystem>(num_threads);
+}
+
+void Level::BuildCollisionIndex() {
+  for (Object* object : object_pointers_) {
+    AddToCollisionIndex(*object);
+  }
+}
+
+void Level::AddToCollisionIndex(Object& object) {
+  if (collision_index_) {
+    collision_index_->Add(object);
+  }
+}
+
+void Level::ResolveCollisions() {
+  contacts_.Clear();
+  contacts_.DetectAll(object_pointers_, jobs_.get());
+  for (const objects::Contact& contact : contacts_.contacts()) {
+    contact.other->Wake();
+    contact.object->Wake();
+  }
+  contacts_.Dispatch();
+}
+
+void Level::UpdateSleep() {
+  awake_objects_ = 0;
+  asleep_objects_ = 0;
+  for (Object* object : object_pointers_) {
+    if (frames_to_sleep_ > 0 && !object->asleep()) {
+      object->CountFrameAtRest(frames_to_sleep_);
+    }
+    if (object->asleep()) {
+      ++asleep_objects_;
     } else {
-      ++object_it;
-      ++ability_it;
+      ++awake_objects_;
     }
   }
 }
@@ -111,56 +201,259 @@ void Level::UpdateCoordinateAxes() const {
   }
 }
 
-void Level::Draw() const {
-  // Inefficient, no need to sort everything.
-  // Will work for now - can be improved in the future to only sort movable
-  // objects.
-  // Y-sorting.
-  std::vector<std::pair<int, Object*>> objects_by_y_base;
-  for (const auto& object : objects_) {
-    objects_by_y_base.emplace_back(object->YBase(), object.get());
-  }
-  std::ranges::sort(objects_by_y_base);
-  for (const auto& y_and_object : objects_by_y_base) {
-    if (!ShouldDraw(*y_and_object.second)) {
-      continue;
+void Level::RecordSnapshot(const float alpha, RenderSnapshot& snapshot) {
+  const ScopedPhaseTimer timer(profiler_, FramePhase::kRecord);
+  snapshot.Clear();
+  snapshot.set_alpha(alpha);
+  camera_.Follow(CameraObject(), alpha);
+  snapshot.set_camera_target(camera_.target());
+  for (const Object* object : object_pointers_) {
+    if (ShouldDraw(*object)) {
+      object->AddToSnapshot(snapshot);
     }
-    y_and_object.second->Draw();
   }
+  ecs::RecordSystem(entities_, ScreenArea(), snapshot);
+  snapshot.Finish();
 }
 
-void Level::DrawBackgrounds() const {
-  const WorldPosition center_world_pos = camera_.GetWorldPosition(
-      {.x = native_screen_width_ / 2.0f, .y = native_screen_height_ / 2.0f});
+void Level::DrawSnapshot(const RenderSnapshot& snapshot) const {
+  camera_.MaybeActivate(snapshot.camera_target());
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kBackgrounds);
+    DrawBackgrounds(snapshot.camera_target().value_or(
+        WorldPosition{.x = native_screen_width_ / 2.0f,
+                      .y = native_screen_height_ / 2.0f}));
+  }
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kDraw);
+    snapshot.Draw();
+  }
+  camera_.MaybeDeactivate();
+  if constexpr (internal::kProfilerEnabled) {
+    // A sprite or a hit box for most items, see `RenderSnapshot::Draw`.
+    profiler_.counters().draw_calls = static_cast<int>(
+        background_layers_.size() + snapshot.items().size());
+  }
+}
+
+void Level::DrawBackgrounds(const WorldPosition screen_center) const {
   for (const auto& background_layer : background_layers_) {
     background_layer->Draw(
-        /*draw_destination=*/{.x = center_world_pos.x,
-                              .y = center_world_pos.y});
+        /*draw_destination=*/{.x = screen_center.x, .y = screen_center.y});
   }
 }
 
-void Level::MaybeClick(const ViewPortContext& ctx) const {
-  // If not clicked or clicked outside the screen set every object's clicked
-  // state to false.
+void Level::MaybeClick(const ViewPortContext& ctx) {
+  for (Object* object : clicked_objects_) {
+    object->set_clicked(false);
+  }
+  clicked_objects_.clear();
+  // Not clicked or clicked outside the screen.
   std::optional<const WorldPosition> cursor_pos_world =
       GetMouseWorldPosition(camera_, ctx, *controls_);
   if (!controls_->IsPrimaryPressed() || !cursor_pos_world.has_value()) {
-    for (auto& object : objects_) {
-      object->set_clicked(false);
-    }
     return;
   }
 
-  const StaticObject mouse_pointer = StaticObject(
-      /*type=*/objects::ObjectTypeFactory::MakeMousePointer(),
-      /*options=*/
-      {.is_hit_box_active = true, .should_draw_hit_box = false},
-      cursor_pos_world->ToFPoint());
-  for (auto& object : objects_) {
-    if (object->CollidesWith(mouse_pointer)) {
-      object->set_clicked(true);
+  world_query_.QueryPoint(*cursor_pos_world, clicked_objects_);
+  for (Object* object : clicked_objects_) {
+    object->set_clicked(true);
+  }
+}
+
+void Level::UseAbilitiesAndUpdate(const ViewPortContext& ctx) {
+  const size_t num_chunks = jobs_ ? jobs_->NumChunks(objects_.size()) : 1;
+  while (spawn_buffers_.size() < num_chunks) {
+    spawn_buffers_.emplace_back(kSpawnBufferCapacity);
+  }
+  const auto use_abilities = [this, &ctx](const size_t chunk,
+                                          const size_t begin,
+                                          const size_t end) {
+    const abilities::AbilityContext ability_ctx = {
+        .camera = camera_,
+        .view_port_ctx = ctx,
+        .world = world_query_,
+        .spawns = spawn_buffers_[chunk],
+        .pools = &object_pools_,
+        .time_sec = static_cast<double>(simulated_steps_) *
+                    timestep_.step_seconds()};
+    for (size_t i = begin; i < end; ++i) {
+      for (const auto& ability : objects_.values()[i].second) {
+        ability->Use(ability_ctx);
+      }
+    }
+  };
+  // Only starts once every ability is used, so no update depends on which
+  // chunk of abilities happened to run first.
+  const auto update = [this](size_t /*chunk*/, const size_t begin,
+                             const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (!object_pointers_[i]->asleep()) {
+        object_pointers_[i]->Update(object_pointers_);
+      }
     }
+  };
+  if (collision_index_) {
+    collision_index_->set_defers_updates(true);
   }
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kAbilities);
+    if (jobs_) {
+      jobs_->ParallelForChunks(objects_.size(), use_abilities);
+    } else {
+      use_abilities(/*chunk=*/0, /*begin=*/0, objects_.size());
+    }
+  }
+  const ScopedPhaseTimer timer(profiler_, FramePhase::kUpdate);
+  if (jobs_) {
+    jobs_->ParallelForChunks(objects_.size(), update);
+  } else {
+    update(/*chunk=*/0, /*begin=*/0, objects_.size());
+  }
+  if (collision_index_) {
+    collision_index_->set_defers_updates(false);
+    for (Object* object : object_pointers_) {
+      object->FlushCollisionIndexUpdate();
+    }
+  }
+}
+
+void Level::Step(const ViewPortContext& ctx) {
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kCleanUp);
+    // Get rid of deleted objects.
+    CleanUp();
+  }
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kUpdate);
+    for (Object* object : object_pointers_) {
+      object->SavePreviousCenter();
+    }
+    camera_.Follow(CameraObject());
+    UpdateScreenEdges();
+    UpdateCoordinateAxes();
+    MaybeClick(ctx);
+  }
+
+  UseAbilitiesAndUpdate(ctx);
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kUpdate);
+    ecs::MoveSystem(entities_);
+    ecs::AnimationSystem(entities_);
+  }
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kCollisions);
+    ResolveCollisions();
+    entity_collisions_.Run(entities_, world_query_);
+    UpdateSleep();
+  }
+
+  {
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kAbilities);
+    // Add all accumulated objects which abilities have spawned, in the order
+    // of the objects which spawned them.
+    for (abilities::SpawnBuffer& spawn_buffer : spawn_buffers_) {
+      for (auto& [object, abilities] : spawn_buffer.spawned()) {
+        AddToCollisionIndex(*object);
+        InsertObject(std::move(object), std::move(abilities));
+      }
+      spawn_buffer.Clear();
+    }
+  }
+  ++simulated_steps_;
+  if constexpr (internal::kProfilerEnabled) {
+    internal::FrameCounters& counters = profiler_.counters();
+    counters.objects = static_cast<int>(objects_.size());
+    counters.hit_box_tests += static_cast<int>(contacts_.hit_box_tests());
+    counters.contacts += static_cast<int>(contacts_.contacts().size());
+  }
+}
+
+LevelId Level::Simulate(const int steps, const ViewPortContext& ctx,
+                        Stats& stats) {
+  LevelId changed_id = id_;
+  for (int step = 0; step < steps && changed_id == id_; ++step) {
+    if (input_log_ != nullptr) {
+      input_log_->Record(CollectedInput());
+    }
+    Step(ctx);
+    stats.AddCollisions(contacts_.contacts());
+    changed_id = MaybeChangeLevel();
+    ClearPresses();
+  }
+  return changed_id;
+}
+
+HeadlessRun Level::RunHeadless(const HeadlessOpts& opts, Stats& stats) {
+  CHECK(opts.steps >= 0) << "Steps can not be negative, have: " << opts.steps;
+  // The canvas is the whole screen, nothing is scaled.
+  const ViewPortContext view_port_ctx(native_screen_width_,
+                                      native_screen_height_,
+                                      native_screen_width_,
+                                      native_screen_height_);
+  HeadlessRun run = {.next_level = id_};
+  run.steps.reserve(opts.steps);
+  for (int step = 0; step < opts.steps && run.next_level == id_; ++step) {
+    if (opts.replay != nullptr) {
+      ReplayInput(static_cast<size_t>(step) < opts.replay->steps().size()
+                      ? opts.replay->steps()[step]
+                      : ScriptedInput{});
+    }
+    const absl::Time start = absl::Now();
+    run.next_level = Simulate(/*steps=*/1, view_port_ctx, stats);
+    if (opts.record_snapshots) {
+      RecordSnapshot(/*alpha=*/1, snapshots_[0]);
+    }
+    if constexpr (internal::kProfilerEnabled) {
+      profiler_.EndFrame();
+    }
+    run.steps.push_back(
+        {.duration = absl::Now() - start,
+         .objects = static_cast<int>(objects_.size()),
+         .awake_objects = awake_objects_,
+         .entities = static_cast<int>(entities_.size()),
+         .contacts = static_cast<int>(contacts_.contacts().size()),
+         .state_hash = opts.hash_state ? std::optional(StateHash())
+                                       : std::nullopt});
+    if (opts.script != nullptr) {
+      opts.script->Advance();
+    }
+  }
+  return run;
+}
+
+uint64_t Level::StateHash() const {
+  internal::StateHash state_hash;
+  state_hash.Add(static_cast<uint64_t>(simulated_steps_));
+  state_hash.Add(static_cast<uint64_t>(object_pointers_.size()));
+  for (const Object* object : object_pointers_) {
+    state_hash.Add(object->type().LayerBit());
+    state_hash.Add(object->center().x);
+    state_hash.Add(object->center().y);
+    state_hash.Add(object->previous_center().x);
+    state_hash.Add(object->previous_center().y);
+    state_hash.Add(object->deleted());
+    state_hash.Add(object->asleep());
+  }
+  state_hash.Add(static_cast<uint64_t>(entities_.size()));
+  entities_.ForEachArchetype(
+      ecs::kTransformComponent,
+      [&state_hash](const ecs::Archetype& archetype) {
+        for (const ecs::Transform& transform :
+             archetype.column<ecs::Transform>()) {
+          state_hash.Add(transform.center.x);
+          state_hash.Add(transform.center.y);
+        }
+        if (!archetype.Has<ecs::Velocity>()) {
+          return;
+        }
+        for (const ecs::Velocity& velocity :
+             archetype.column<ecs::Velocity>()) {
+          state_hash.Add(velocity.direction_x);
+          state_hash.Add(velocity.direction_y);
+        }
+      });
+  return state_hash.hash();
 }
 
 LevelId Level::Run(Stats& stats) {
@@ -190,44 +483,19 @@ LevelId Level::Run(Stats& stats) {
       native_screen_width_ * view_port_ctx.scale(),
       native_screen_height_ * view_port_ctx.scale()};
 
-  // Loop while the level is unchanged.
-  while (changed_id == id_) {
+  const auto draw_frame = [this, &target, &source,
+                           &dest](const RenderSnapshot& snapshot) {
     BeginTextureMode(target);
     ClearBackground(RAYWHITE);
-    DrawFPS(0, 0);
-    // Get rid of deleted objects.
-    CleanUpOrDie();
-    camera_.MaybeActivate();
-    UpdateScreenEdges();
-    UpdateCoordinateAxes();
-    MaybeClick(view_port_ctx);
-
-    auto object_it = objects_.begin();
-    auto ability_it = abilities_.begin();
-    std::list<ObjectAndAbilities> new_objects_and_abilities;
-    while (object_it != objects_.end() && ability_it != abilities_.end()) {
-      for (const auto& ability : *ability_it) {
-        std::list<ObjectAndAbilities> new_objects_and_abilities_current =
-            ability->Use({.camera = camera_, .view_port_ctx = view_port_ctx});
-        new_objects_and_abilities.splice(new_objects_and_abilities.end(),
-                                         new_objects_and_abilities_current);
-      }
-
-      object_it->get()->Update(objects_);
-      ++object_it;
-      ++ability_it;
+    if constexpr (!internal::kProfilerEnabled) {
+      DrawFPS(0, 0);
     }
-
-    DrawBackgrounds();
-    Draw();
-
-    // Add all accumulated objects which abilities have spawned.
-    for (auto& [object, abilities] : new_objects_and_abilities) {
-      objects_.push_back(std::move(object));
-      abilities_.push_back(std::move(abilities));
+    DrawSnapshot(snapshot);
+    if constexpr (internal::kProfilerEnabled) {
+      // On top of the level, the profiler shows the frames before this one.
+      DrawProfilerOverlay(profiler_);
     }
-
-    camera_.MaybeDeactivate();
+    const ScopedPhaseTimer timer(profiler_, FramePhase::kPresent);
     EndTextureMode();
     BeginDrawing();
     ClearBackground(BLACK);
@@ -235,7 +503,40 @@ LevelId Level::Run(Stats& stats) {
     DrawTexturePro(target.texture, source, dest, /*origin=*/{0, 0},
                    /*rotation=*/0.0f, WHITE);
     EndDrawing();
-    changed_id = MaybeChangeLevel();
+  };
+
+  std::unique_ptr<internal::BackgroundThread> simulation =
+      pipelined_ ? std::make_unique<internal::BackgroundThread>() : nullptr;
+  timestep_.Reset();
+  // Index of the snapshot drawn next, the other one is recorded.
+  int drawn = 0;
+  RecordSnapshot(timestep_.alpha(), snapshots_[drawn]);
+  // Loop while the level is unchanged.
+  while (changed_id == id_) {
+    CollectInput();
+    const int steps = timestep_.Advance(GetFrameTime());
+    const float alpha = timestep_.alpha();
+    RenderSnapshot& recorded = snapshots_[1 - drawn];
+    const auto simulate = [this, steps, alpha, &view_port_ctx, &stats,
+                           &changed_id, &recorded]() {
+      changed_id = Simulate(steps, view_port_ctx, stats);
+      RecordSnapshot(alpha, recorded);
+    };
+
+    if (simulation == nullptr) {
+      simulate();
+      drawn = 1 - drawn;
+      draw_frame(snapshots_[drawn]);
+    } else {
+      // The objects are not touched by the main thread until `Wait` returns.
+      simulation->Start(simulate);
+      draw_frame(snapshots_[drawn]);
+      simulation->Wait();
+      drawn = 1 - drawn;
+    }
+    if constexpr (internal::kProfilerEnabled) {
+      profiler_.EndFrame();
+    }
   }
   UnloadRenderTexture(target);
   return changed_id;
@@ -1,34 +1,96 @@
 #ifndef LIB_API_LEVEL_H
 #define LIB_API_LEVEL_H
 
+#include <array>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <optional>
 #include <vector>
 
+#include "absl/base/nullability.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/memory/memory.h"
+#include "absl/time/time.h"
 #include "gtest/gtest_prod.h"
 #include "lib/api/abilities/ability.h"
 #include "lib/api/camera.h"
 #include "lib/api/common_types.h"
 #include "lib/api/controls.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
+#include "lib/api/ecs/systems.h"
+#include "lib/api/input_log.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/contact_list.h"
 #include "lib/api/objects/coordinate_object.h"
 #include "lib/api/objects/object.h"
+#include "lib/api/objects/object_pool.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/screen_edge_object.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/api/scripted_controls.h"
 #include "lib/api/sprites/sprite_instance.h"
 #include "lib/api/stats.h"
+#include "lib/internal/fixed_timestep.h"
+#include "lib/internal/frame_profiler.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/job_system.h"
+#include "lib/internal/slot_map.h"
 
 namespace lib {
 namespace api {
 
 constexpr float kWorldBorderLength = 1000000;
+// Simulation steps per second. Velocities are distances per step, so this
+// keeps the speeds of the frame rate the game used to be locked to.
+constexpr int kDefaultSimulationRate = 120;
+// Half a second at the default simulation rate.
+constexpr int kDefaultFramesToSleep = 60;
+// Spawned objects a chunk of objects can hold without growing its buffer.
+constexpr size_t kSpawnBufferCapacity = 64;
 
 typedef uint32_t LevelId;
 
+// Cost and size of a single simulation step of `Level::RunHeadless`. Sizes
+// are counted after the step.
+struct StepStats {
+  absl::Duration duration;
+  int objects;
+  int awake_objects;
+  int entities;
+  int contacts;
+  // Only set when `HeadlessOpts::hash_state` is, see `Level::StateHash`.
+  std::optional<uint64_t> state_hash;
+};
+
+struct HeadlessOpts {
+  // Steps to simulate, fewer when the level changes before.
+  int steps;
+  // Advanced after every step. Not set when neither the level nor its
+  // abilities use `ScriptedControls`.
+  absl::Nullable<InputScript*> script = nullptr;
+  // Records a snapshot after every step without drawing it, so that the
+  // cost of recording is measured as well.
+  bool record_snapshots = false;
+  // Input to feed `Controls` with before every step, steps past the end of the
+  // log have no input. Not set when the input comes from `script`.
+  absl::Nullable<const InputLog*> replay = nullptr;
+  // Hashes the state of the level after every step, so that a replay can be
+  // compared with the run it was recorded from.
+  bool hash_state = false;
+};
+
+struct HeadlessRun {
+  // Level to run next, the level itself when it has not changed.
+  LevelId next_level;
+  // One for every simulated step.
+  std::vector<StepStats> steps;
+};
+
 static constexpr LevelId kInvalidLevel =
     std::numeric_limits<uint32_t>::max() - 1;
 static constexpr LevelId kExitLevel = std::numeric_limits<uint32_t>::max() - 2;
@@ -52,28 +114,99 @@ class LevelBuilder {
       std::unique_ptr<objects::Object> object,
       std::list<std::unique_ptr<abilities::Ability>> abilities,
       const bool attach_camera = false) {
-    if (attach_camera) {
-      level_->camera_.Bind(object.get());
-    }
-
     for (const auto& ability : abilities) {
       ability->set_user(object.get());
     }
 
-    level_->objects_.emplace_back(std::move(object));
-    level_->abilities_.emplace_back(std::move(abilities));
+    const internal::SlotHandle handle =
+        level_->InsertObject(std::move(object), std::move(abilities));
+    if (attach_camera) {
+      level_->camera_.Bind(handle);
+    }
 
     return *this;
   }
 
   LevelBuilder& AddObject(std::unique_ptr<objects::Object> object,
                           const bool attach_camera = false) {
-    if (attach_camera) {
-      level_->camera_.Bind(object.get());
-    }
+    return AddObjectAndAbilities(std::move(object), /*abilities=*/{},
+                                 attach_camera);
+  }
 
-    level_->objects_.emplace_back(std::move(object));
-    level_->abilities_.emplace_back();
+  // Adds an entity instead of an object, see `ecs::Registry`. Collisions are
+  // one way: entities respond to the objects they run into, but objects never
+  // see entities, e.g. a `MovableObject` walks through a wall entity. Add
+  // anything objects have to collide with as an object.
+  LevelBuilder& AddEntity(const ecs::EntityDesc& entity) {
+    level_->entities_.Create(entity);
+
+    return *this;
+  }
+
+  // Selects how colliding objects are found, grid is used by default.
+  LevelBuilder& WithBroadphase(const objects::BroadphaseType type) {
+    level_->SetBroadphase(type);
+
+    return *this;
+  }
+
+  // Uses abilities, updates objects and finds collisions on `num_threads`
+  // threads, including the main thread. Spawned objects and collisions are
+  // delivered in the same order as with a single thread, which is the default.
+  LevelBuilder& WithThreads(const int num_threads) {
+    level_->SetThreads(num_threads);
+
+    return *this;
+  }
+
+  // Simulates `steps_per_second` steps every second, independent of how many
+  // frames are drawn. Frames between two steps draw the objects in between
+  // their positions after each of the steps.
+  LevelBuilder& WithSimulationRate(const int steps_per_second) {
+    level_->timestep_ = internal::FixedTimestep(steps_per_second);
+
+    return *this;
+  }
+
+  // Simulates the next frame on its own thread while the main thread draws
+  // the one before, so a frame is shown one frame later than without it.
+  // Objects are only ever touched by the simulation, they are drawn from a
+  // `RenderSnapshot`. The input and the level change are handled once per
+  // frame.
+  LevelBuilder& WithPipelinedRendering() {
+    level_->pipelined_ = true;
+
+    return *this;
+  }
+
+  // Objects which have not moved for `frames` simulation steps and are not
+  // touched by an awake object fall asleep: they are not updated and do not
+  // look for collisions until they are woken up. 0 keeps every object awake.
+  LevelBuilder& WithSleepAfterFrames(const int frames) {
+    CHECK(frames >= 0) << "Frames can not be negative, have: " << frames;
+    level_->frames_to_sleep_ = frames;
+
+    return *this;
+  }
+
+  // Input of the level itself, e.g. for leaving it or clicking objects. Real
+  // input from raylib is used by default.
+  LevelBuilder& WithControls(
+      std::unique_ptr<const ControlsInterface> controls) {
+    level_->controls_ = std::move(controls);
+
+    return *this;
+  }
+
+  // Deleted objects of type `ObjectT` are kept and reused by the abilities
+  // which spawn them, instead of being destroyed and allocated again. Starts
+  // with `prewarm_count` objects constructed from `args`, see
+  // `objects::ObjectPool`.
+  template <typename ObjectT, typename... Args>
+  LevelBuilder& WithObjectPool(const size_t prewarm_count,
+                               const Args&... args) {
+    level_->object_pools_.template Add<ObjectT>().Prewarm(prewarm_count,
+                                                          args...);
 
     return *this;
   }
@@ -154,7 +287,11 @@ class LevelBuilder {
     return AddObject(std::move(x_axis)).AddObject(std::move(y_axis));
   }
 
-  virtual std::unique_ptr<LevelT> Build() { return std::move(level_); }
+  virtual std::unique_ptr<LevelT> Build() {
+    level_->BuildCollisionIndex();
+
+    return std::move(level_);
+  }
 
  protected:
   const float native_screen_width_;
@@ -168,20 +305,122 @@ class Level {
   virtual ~Level() = default;
 
   LevelId Run(Stats& stats);
+  // Simulates the level without a window, e.g. on a build server, in a
+  // benchmark or in a soak test. Steps follow each other as fast as possible,
+  // with no frame limiter, and nothing is drawn. Input comes from the controls
+  // the level and its abilities were built with, see `ScriptedControls`.
+  HeadlessRun RunHeadless(const HeadlessOpts& opts, Stats& stats);
+  // Records the input `Controls` reports before every step into `log`, until
+  // called again with null. The level does not take ownership.
+  void RecordInput(absl::Nullable<InputLog*> log) { input_log_ = log; }
+  // Hash of the objects and entities of the level. Equal for two levels built
+  // the same way and simulated with the same input, on any machine.
+  [[nodiscard]] uint64_t StateHash() const;
   [[nodiscard]] LevelId id() const { return id_; }
+  // Objects awake and asleep after the last simulation step.
+  [[nodiscard]] int awake_objects() const { return awake_objects_; }
+  [[nodiscard]] int asleep_objects() const { return asleep_objects_; }
+  // Pools added by `LevelBuilder::WithObjectPool`, with their hit and miss
+  // counts.
+  [[nodiscard]] const objects::ObjectPools& object_pools() const {
+    return object_pools_;
+  }
+  // Entities added by `LevelBuilder::AddEntity`, moved, collided and drawn
+  // after the objects every step.
+  [[nodiscard]] const ecs::Registry& entities() const { return entities_; }
+  // Where the last frames spent their time, drawn over the level by `Run`.
+  // Every step of `RunHeadless` is a frame.
+  [[nodiscard]] const internal::FrameProfiler& profiler() const {
+    return profiler_;
+  }
+  // Closest object on a ray or hit by a moving shape, see
+  // `objects::WorldQuery`.
+  [[nodiscard]] std::optional<objects::RaycastHit> Raycast(
+      const WorldPosition& origin, const FPoint& direction, float max_distance,
+      objects::LayerMask layers = objects::kAllLayers,
+      absl::Nullable<const objects::Object*> ignored = nullptr) const {
+    return world_query_.Raycast(origin, direction, max_distance, layers,
+                                ignored);
+  }
+  [[nodiscard]] std::optional<objects::RaycastHit> ShapeCast(
+      const FCircle& circle, const FPoint& direction, float max_distance,
+      objects::LayerMask layers = objects::kAllLayers,
+      absl::Nullable<const objects::Object*> ignored = nullptr) const {
+    return world_query_.ShapeCast(circle, direction, max_distance, layers,
+                                  ignored);
+  }
+  [[nodiscard]] std::optional<objects::RaycastHit> ShapeCast(
+      const FRectangle& rectangle, const FPoint& direction, float max_distance,
+      objects::LayerMask layers = objects::kAllLayers,
+      absl::Nullable<const objects::Object*> ignored = nullptr) const {
+    return world_query_.ShapeCast(rectangle, direction, max_distance, layers,
+                                  ignored);
+  }
+  // Region and nearest neighbour queries, see `objects::WorldQuery`.
+  void QueryAABB(const FRectangle& area,
+                 std::vector<objects::Object*>& results,
+                 objects::LayerMask layers = objects::kAllLayers) const {
+    world_query_.QueryAABB(area, results, layers);
+  }
+  void QueryRadius(const WorldPosition& center, float radius,
+                   std::vector<objects::Object*>& results,
+                   objects::LayerMask layers = objects::kAllLayers) const {
+    world_query_.QueryRadius(center, radius, results, layers);
+  }
+  void QueryKNearest(const WorldPosition& position, size_t k,
+                     std::vector<objects::Object*>& results,
+                     objects::LayerMask layers = objects::kAllLayers) const {
+    world_query_.QueryKNearest(position, k, results, layers);
+  }
 
  private:
   template <typename LevelT>
   friend class LevelBuilder;
 
   [[nodiscard]] virtual LevelId MaybeChangeLevel() const;
+  // The area of the world on the screen, not set without screen objects.
+  [[nodiscard]] std::optional<internal::Aabb> ScreenArea() const;
   [[nodiscard]] bool ShouldDraw(const objects::Object& object) const;
-  void CleanUpOrDie();
+  // Erases the deleted objects together with their abilities.
+  void CleanUp();
+  internal::SlotHandle InsertObject(
+      std::unique_ptr<objects::Object> object,
+      std::list<std::unique_ptr<abilities::Ability>> abilities);
+  // Null once the object behind `handle` has been erased.
+  [[nodiscard]] absl::Nullable<objects::Object*> FindObject(
+      internal::SlotHandle handle) const;
+  [[nodiscard]] absl::Nullable<const objects::Object*> CameraObject() const;
+  void SetBroadphase(objects::BroadphaseType type);
+  void SetThreads(int num_threads);
+  // Registers every object added so far, static objects never change after.
+  void BuildCollisionIndex();
+  void AddToCollisionIndex(objects::Object& object);
+  // Finds the collisions of every object first and only then lets the objects
+  // respond to them. Objects which touch each other are woken up.
+  void ResolveCollisions();
+  // Counts the frames objects are at rest for and puts them to sleep.
+  void UpdateSleep();
   void UpdateScreenEdges() const;
   void UpdateCoordinateAxes() const;
-  void Draw() const;
-  void DrawBackgrounds() const;
-  void MaybeClick(const ViewPortContext& ctx) const;
+  // Uses the abilities of every object, then updates the awake objects. Both
+  // run in chunks of objects on `jobs_` when it is set. Every chunk spawns
+  // into its own buffer of `spawn_buffers_`.
+  void UseAbilitiesAndUpdate(const ViewPortContext& ctx);
+  // Advances the simulation by one fixed step.
+  void Step(const ViewPortContext& ctx);
+  // Runs `steps` steps, stops early when the level changes. Returns the level
+  // to run next.
+  [[nodiscard]] LevelId Simulate(int steps, const ViewPortContext& ctx,
+                                 Stats& stats);
+  // Records every object on the screen, `alpha` of the way from its center
+  // before the last step to its current center.
+  void RecordSnapshot(float alpha, RenderSnapshot& snapshot);
+  // Only reads `snapshot` and the background layers, never the objects.
+  void DrawSnapshot(const RenderSnapshot& snapshot) const;
+  void DrawBackgrounds(WorldPosition screen_center) const;
+  // Marks the objects under the cursor as clicked while the primary button is
+  // pressed, and unmarks the objects clicked before.
+  void MaybeClick(const ViewPortContext& ctx);
 
   LevelId id_;
 
@@ -190,16 +429,35 @@ class Level {
         const float native_screen_height)
       : id_(id),
         camera_(native_screen_width, native_screen_height),
+        collision_index_(objects::BroadphaseCollisionIndex::Create(
+            objects::BroadphaseType::kSpatialHashGrid)),
+        world_query_(object_pointers_),
+        timestep_(kDefaultSimulationRate),
         controls_(std::make_unique<Controls>()),
         native_screen_width_(native_screen_width),
-        native_screen_height_(native_screen_height) {}
+        native_screen_height_(native_screen_height) {
+    world_query_.set_collision_index(collision_index_.get());
+  }
   // This separation is required so that cyclic dependency is not introduced
   // between Object and Ability classes.
   FRIEND_TEST(LevelTest, ObjectsAreAdded);
   FRIEND_TEST(LevelTest, ObjectsAndAbilitiesAreAdded);
   FRIEND_TEST(LevelTest, ScreenEdgeObjects);
   FRIEND_TEST(LevelTest, CoordinateObjects);
-  FRIEND_TEST(LevelTest, CleanupOrDie);
+  FRIEND_TEST(LevelTest, CleanUp);
+  FRIEND_TEST(LevelTest, CameraHandleOfErasedObject);
+  FRIEND_TEST(LevelTest, WithBroadphase);
+  FRIEND_TEST(LevelTest, WithThreads);
+  FRIEND_TEST(LevelTest, RecyclesPooledObjects);
+  FRIEND_TEST(LevelTest, StepsEntities);
+  FRIEND_TEST(LevelTest, ObjectsDoNotCollideWithEntities);
+  FRIEND_TEST(LevelTest, ThreadsSpawnInOrder);
+  FRIEND_TEST(LevelTest, MaybeClick);
+  FRIEND_TEST(LevelTest, SleepAndWake);
+  FRIEND_TEST(LevelTest, StepSavesPreviousCenters);
+  FRIEND_TEST(LevelTest, RecordSnapshot);
+  FRIEND_TEST(LevelTest, StaticObjectsArePartitioned);
+  FRIEND_TEST(LevelTest, ResolveCollisions);
   FRIEND_TEST(LevelTest, WorldBorderObjects);
   FRIEND_TEST(LevelTest, DrawsNoScreenEdgeObjects);
   FRIEND_TEST(LevelTest, DoesNotDrawOutsideScreenOnlyHitBox);
@@ -209,15 +467,53 @@ class Level {
   FRIEND_TEST(LevelTest, DrawsPartiallyOutsideScreen);
   FRIEND_TEST(LevelTest, DrawsFullyInsideScreen);
   FRIEND_TEST(LevelTest, DrawBackground);
-  FRIEND_TEST(LevelDeathTest, CleanUpOrDieOutOfSync);
   FRIEND_TEST(TitleScreenLevelTest, StartAndExitAddedOk);
-  std::list<std::unique_ptr<objects::Object>> objects_;
-  std::list<std::list<std::unique_ptr<abilities::Ability>>> abilities_;
+  FRIEND_TEST(LevelAllocationTest, SteadyStateFrameDoesNotAllocate);
+  // Every object stored together with its abilities. Erasing an object moves
+  // the last one into its place.
+  internal::SlotMap<ObjectAndAbilities> objects_;
+  // The objects of `objects_` in the same order, which is what the objects
+  // and the collision detection iterate.
+  std::vector<objects::Object*> object_pointers_;
   std::vector<objects::ScreenEdgeObject*> screen_edge_objects_;
   std::list<objects::CoordinateObject*> coordinate_objects_;
   std::list<objects::StaticObject*> world_border_objects_;
   Camera camera_;
-  std::unique_ptr<const Controls> controls_;
+  // Broadphase for `objects_`, every object in `objects_` is registered once
+  // the level is built. Not set when all pairs of objects are checked.
+  std::unique_ptr<objects::BroadphaseCollisionIndex> collision_index_;
+  // Collisions of the current frame.
+  objects::ContactList contacts_;
+  // Runs abilities, updates and collision detection in parallel. Not set when
+  // a single thread is used.
+  std::unique_ptr<internal::JobSystem> jobs_;
+  // Deleted objects are given back to their pool instead of being destroyed.
+  objects::ObjectPools object_pools_;
+  // Objects spawned by the abilities of each chunk of `objects_`, added to
+  // the level at the end of the step.
+  std::vector<abilities::SpawnBuffer> spawn_buffers_;
+  // Queries `objects_` through `collision_index_`.
+  objects::WorldQuery world_query_;
+  // Stepped after `objects_`, so entities see where the objects are after
+  // the step. Objects never see entities.
+  ecs::Registry entities_;
+  ecs::CollisionSystem entity_collisions_;
+  internal::FixedTimestep timestep_;
+  // Steps simulated so far, the clock of the abilities. Independent of the
+  // frame rate, so replays see the same time as the recorded run.
+  int64_t simulated_steps_ = 0;
+  absl::Nullable<InputLog*> input_log_ = nullptr;
+  // Mutable to be timed by the drawing, which does not change the level.
+  mutable internal::FrameProfiler profiler_;
+  bool pipelined_ = false;
+  // One is drawn while the other one is recorded.
+  std::array<RenderSnapshot, 2> snapshots_;
+  int frames_to_sleep_ = kDefaultFramesToSleep;
+  int awake_objects_ = 0;
+  int asleep_objects_ = 0;
+  std::unique_ptr<const ControlsInterface> controls_;
+  // Objects marked as clicked by `MaybeClick`, the only ones it has to unmark.
+  std::vector<objects::Object*> clicked_objects_;
   std::vector<std::unique_ptr<sprites::SpriteInstance>> background_layers_;
 
   const float native_screen_width_;
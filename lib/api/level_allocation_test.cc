@@ -0,0 +1,193 @@
+// Counts every heap allocation of the process, so it is a test binary of its
+// own.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <new>
+
+#include "gtest/gtest.h"
+#include "lib/api/abilities/ability.h"
+#include "lib/api/common_types.h"
+#include "lib/api/controls.h"
+#include "lib/api/controls_mock.h"
+#include "lib/api/level.h"
+#include "lib/api/objects/movable_object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/api/render_snapshot.h"
+#include "lib/api/sprites/sprite_factory.h"
+#include "lib/api/stats.h"
+
+namespace {
+
+std::atomic<bool> counting = false;
+std::atomic<int> allocations = 0;
+
+void* CountedAllocate(const std::size_t size) {
+  if (counting) {
+    ++allocations;
+  }
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void* CountedAllocate(const std::size_t size, const std::align_val_t align) {
+  if (counting) {
+    ++allocations;
+  }
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  void* memory = std::aligned_alloc(
+      alignment, (size + alignment - 1) / alignment * alignment);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+}  // namespace
+
+void* operator new(const std::size_t size) { return CountedAllocate(size); }
+void* operator new[](const std::size_t size) { return CountedAllocate(size); }
+void* operator new(const std::size_t size, const std::align_val_t align) {
+  return CountedAllocate(size, align);
+}
+void* operator new[](const std::size_t size, const std::align_val_t align) {
+  return CountedAllocate(size, align);
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+void operator delete(void* memory, std::align_val_t) noexcept {
+  std::free(memory);
+}
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  std::free(memory);
+}
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  std::free(memory);
+}
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  std::free(memory);
+}
+
+namespace lib {
+namespace api {
+
+using abilities::Ability;
+using abilities::MoveAbility;
+using objects::MovableObject;
+using objects::ObjectTypeFactory;
+using objects::StaticObject;
+
+namespace {
+
+constexpr float kNativeScreenWidth = 1000;
+constexpr float kNativeScreenHeight = 500;
+
+class DummyLevel : public Level {
+ public:
+  explicit DummyLevel(const LevelId id, const float native_screen_width,
+                      const float native_screen_height)
+      : Level(id, native_screen_width, native_screen_height) {}
+
+  [[nodiscard]] LevelId MaybeChangeLevel() const override {
+    return kInvalidLevel;
+  }
+};
+
+// Moves back and forth between the walls.
+class BouncingObject : public MovableObject {
+ public:
+  BouncingObject(const FPoint center, const float direction_x)
+      : MovableObject(ObjectTypeFactory::MakePlayer(),
+                      MovableObjectOpts{.is_hit_box_active = true,
+                                        .should_draw_hit_box = true,
+                                        .attach_camera = false,
+                                        .velocity = 3},
+                      FCircle{center, 4}) {
+    SetDirectionGlobal(direction_x, 0);
+  }
+
+  bool OnCollisionCallback(Object& other_object) override {
+    SetDirectionGlobal(-direction_x(), 0);
+    return true;
+  }
+};
+
+}  // namespace
+
+class LevelAllocationTest : public ::testing::TestWithParam<int> {
+ public:
+  LevelAllocationTest()
+      : sprite_factory_(/*id=*/7, /*texture_width=*/30, /*texture_height=*/20,
+                        kNativeScreenWidth, kNativeScreenHeight) {}
+
+ protected:
+  sprites::SpriteFactory sprite_factory_;
+  Stats stats_;
+};
+
+TEST_P(LevelAllocationTest, SteadyStateFrameDoesNotAllocate) {
+  LevelBuilder<DummyLevel> builder(kInvalidLevel, kNativeScreenWidth,
+                                   kNativeScreenHeight);
+  builder.WithScreenObjects()
+      .WithCoordinates()
+      .WithWorldBorderX(0)
+      .WithWorldBorderX(kNativeScreenWidth)
+      .WithThreads(GetParam());
+  for (int i = 0; i < 100; ++i) {
+    std::list<std::unique_ptr<Ability>> abilities;
+    abilities.push_back(std::make_unique<MoveAbility>(
+        std::make_unique<ControlsMock>(),
+        MoveAbility::MoveAbilityOpts{.key_left = kKeyA, .key_right = kKeyD}));
+    builder.AddObjectAndAbilities(
+        std::make_unique<BouncingObject>(
+            FPoint{10.0f + static_cast<float>(i % 50) * 19,
+                   10.0f + static_cast<float>(i / 50) * 100},
+            i % 2 == 0 ? 1.0f : -1.0f),
+        std::move(abilities));
+  }
+  builder.AddObject(std::make_unique<StaticObject>(
+      ObjectTypeFactory::MakeEnemy(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      FRectangle{.top_left = {400, 300}, .width = 30, .height = 20},
+      sprite_factory_.MakeStaticSprite("a/b/picture.png")));
+  const std::unique_ptr<DummyLevel> level = builder.Build();
+  level->controls_ = std::make_unique<ControlsMock>();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+  RenderSnapshot snapshot;
+  const auto frame = [&]() {
+    (void)level->Simulate(/*steps=*/2, ctx, stats_);
+    level->RecordSnapshot(/*alpha=*/0.5f, snapshot);
+  };
+  // Buffers grow to their steady state size. Every object bounces between the
+  // walls in about 330 frames, after that the same contacts come again.
+  for (int i = 0; i < 400; ++i) {
+    frame();
+  }
+
+  counting = true;
+  for (int i = 0; i < 100; ++i) {
+    frame();
+  }
+  counting = false;
+
+  EXPECT_EQ(allocations, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, LevelAllocationTest,
+                         ::testing::Values(1, 4));
+
+}  // namespace api
+}  // namespace lib
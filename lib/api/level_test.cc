@@ -1,33 +1,54 @@
 #include "lib/api/level.h"
 
 #include <filesystem>
+#include <list>
 #include <memory>
+#include <optional>
+#include <vector>
 
-#include "gmock/gmock-matchers.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "lib/api/abilities/ability.h"
+#include "lib/api/abilities/projectile_ability.h"
 #include "lib/api/common_types.h"
 #include "lib/api/controls.h"
 #include "lib/api/controls_mock.h"
+#include "lib/api/ecs/components.h"
+#include "lib/api/ecs/registry.h"
 #include "lib/api/graphics_mock.h"
+#include "lib/api/input_log.h"
+#include "lib/api/objects/movable_object.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_pool.h"
 #include "lib/api/objects/object_type.h"
+#include "lib/api/objects/projectile_object.h"
 #include "lib/api/objects/screen_edge_object.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/objects/world_query.h"
+#include "lib/api/scripted_controls.h"
 #include "lib/api/sprites/sprite_factory.h"
 #include "lib/api/sprites/sprite_instance.h"
+#include "lib/api/stats.h"
+#include "lib/internal/hit_box.h"
+#include "lib/internal/slot_map.h"
 
 namespace lib {
 namespace api {
 
 using abilities::Ability;
 using abilities::MoveAbility;
+using abilities::ProjectileAbility;
+using objects::MovableObject;
+using objects::Object;
 using objects::ObjectType;
 using objects::ObjectTypeFactory;
+using objects::ProjectileObject;
 using objects::StaticObject;
 using sprites::SpriteFactory;
 using sprites::SpriteInstance;
 using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 
 namespace {
 
@@ -48,6 +69,75 @@ class DummyLevel : public Level {
   }
 };
 
+class DummyMovableObject : public MovableObject {
+ public:
+  explicit DummyMovableObject(const objects::HitBoxVariant& hit_box)
+      : MovableObject(ObjectTypeFactory::MakePlayer(),
+                      MovableObjectOpts{.is_hit_box_active = true,
+                                        .should_draw_hit_box = false,
+                                        .attach_camera = false,
+                                        .velocity = 5},
+                      hit_box) {}
+
+  bool OnCollisionCallback(Object& other_object) override {
+    collided_with.push_back(&other_object);
+    return false;
+  }
+
+  std::vector<Object*> collided_with;
+};
+
+// Spawns a static object below its user every time it is used.
+class SpawnBelowAbility : public Ability {
+ public:
+  SpawnBelowAbility()
+      : Ability(std::make_unique<ControlsMock>(), {.cooldown_sec = 0}) {}
+
+  void Use(const abilities::AbilityContext& ctx) override {
+    ctx.spawns.Spawn(std::make_unique<StaticObject>(
+        ObjectTypeFactory::MakeEnemy(),
+        StaticObject::StaticObjectOpts{.is_hit_box_active = false,
+                                       .should_draw_hit_box = false},
+        FCircle{.center = {user()->center().x, 400}, .radius = 1}));
+  }
+};
+
+// Spawns a projectile at its user every time it is used, taken from the pool
+// of the level.
+class SpawnPooledProjectileAbility : public Ability {
+ public:
+  SpawnPooledProjectileAbility()
+      : Ability(std::make_unique<ControlsMock>(), {.cooldown_sec = 0}) {}
+
+  void Use(const abilities::AbilityContext& ctx) override {
+    ctx.spawns.Spawn(ctx.pools->Get<ProjectileObject>()->Acquire(
+        ObjectTypeFactory::MakeProjectilePlayer(),
+        ProjectileObject::ProjectileObjectOpts{
+            .hit_box_center = user()->center().ToFPoint(),
+            .hit_box_radius = 1}));
+  }
+};
+
+// A player which moves with D and shoots with space, at most once a second.
+// Both abilities read the input of the level.
+std::unique_ptr<Level> BuildShooterLevel() {
+  LevelBuilder<Level> builder(kFirstLevel, kNativeScreenWidth,
+                              kNativeScreenHeight);
+  std::list<std::unique_ptr<Ability>> abilities;
+  abilities.push_back(std::make_unique<MoveAbility>(
+      std::make_unique<Controls>(),
+      MoveAbility::MoveAbilityOpts{.key_right = kKeyD}));
+  abilities.push_back(std::make_unique<ProjectileAbility>(
+      std::make_unique<Controls>(), ObjectTypeFactory::MakeProjectilePlayer(),
+      ProjectileAbility::ProjectileAbilityOpts{.cooldown_sec = 1},
+      ProjectileObject::ProjectileObjectOpts{.velocity = 3,
+                                             .hit_box_radius = 1}));
+  builder.AddObjectAndAbilities(
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 1}),
+      std::move(abilities));
+  return builder.Build();
+}
+
 }  // namespace
 
 class LevelTest : public ::testing::Test {
@@ -67,23 +157,6 @@ class LevelTest : public ::testing::Test {
 
 using LevelDeathTest = LevelTest;
 
-TEST_F(LevelDeathTest, CleanUpOrDieOutOfSync) {
-  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
-                                         kNativeScreenHeight);
-
-  dummy_builder.AddObject(std::make_unique<StaticObject>(
-      /*type=*/ObjectTypeFactory::MakePlayer(),
-      StaticObject::StaticObjectOpts{.is_hit_box_active = false,
-                                     .should_draw_hit_box = false},
-      FLine{.a = {0, 0}, .b = {0, 1}}));
-  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
-  dummy_level->abilities_.clear();
-
-  EXPECT_DEATH(dummy_level->CleanUpOrDie(),
-               HasSubstr("Abilities and Objects are out of sync, abilities "
-                         "size: 0, objects size: 1"));
-}
-
 TEST_F(LevelDeathTest, ScreenEdgeObjectsAreAddedTwice) {
   LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
                                          kNativeScreenHeight);
@@ -100,7 +173,7 @@ TEST_F(LevelDeathTest, CoordinateObjectsAreAddedTwice) {
                HasSubstr("WithCoordinates() has already been called."));
 }
 
-TEST_F(LevelTest, CleanupOrDie) {
+TEST_F(LevelTest, CleanUp) {
   LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
                                          kNativeScreenHeight);
   std::unique_ptr<StaticObject> static_object = std::make_unique<StaticObject>(
@@ -119,12 +192,506 @@ TEST_F(LevelTest, CleanupOrDie) {
   dummy_builder.AddObjectAndAbilities(std::move(static_object),
                                       std::move(abilities));
   const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  ASSERT_EQ(dummy_level->collision_index_->size(), 1);
   static_object_raw->set_deleted(true);
 
-  dummy_level->CleanUpOrDie();
+  dummy_level->CleanUp();
 
   ASSERT_EQ(dummy_level->objects_.size(), 0);
-  ASSERT_EQ(dummy_level->abilities_.size(), 0);
+  ASSERT_EQ(dummy_level->object_pointers_.size(), 0);
+  ASSERT_EQ(dummy_level->collision_index_->size(), 0);
+}
+
+TEST_F(LevelTest, CameraHandleOfErasedObject) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> followed =
+      std::make_unique<DummyMovableObject>(FCircle{{10, 20}, 5});
+  DummyMovableObject* followed_raw = followed.get();
+  dummy_builder.AddObject(std::move(followed), /*attach_camera=*/true)
+      .AddObject(std::make_unique<DummyMovableObject>(FCircle{{50, 50}, 5}));
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  const internal::SlotHandle handle = *dummy_level->camera_.bound();
+  ASSERT_EQ(dummy_level->CameraObject(), followed_raw);
+  RenderSnapshot snapshot;
+  dummy_level->RecordSnapshot(/*alpha=*/1, snapshot);
+
+  followed_raw->set_deleted(true);
+  dummy_level->CleanUp();
+  dummy_level->RecordSnapshot(/*alpha=*/1, snapshot);
+
+  EXPECT_EQ(dummy_level->FindObject(handle), nullptr);
+  EXPECT_EQ(dummy_level->CameraObject(), nullptr);
+  ASSERT_EQ(dummy_level->object_pointers_.size(), 1);
+  EXPECT_EQ(dummy_level->object_pointers_[0]->center(),
+            (WorldPosition{50, 50}));
+  EXPECT_EQ(snapshot.camera_target(), (WorldPosition{10, 20}));
+}
+
+TEST_F(LevelTest, WithBroadphase) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  dummy_builder.WithWorldBorderX(0).WithBroadphase(
+      objects::BroadphaseType::kAllPairs);
+  const std::unique_ptr<DummyLevel> all_pairs_level = dummy_builder.Build();
+
+  EXPECT_EQ(all_pairs_level->collision_index_, nullptr);
+
+  LevelBuilder<DummyLevel> tree_builder(kInvalidLevel, kNativeScreenWidth,
+                                        kNativeScreenHeight);
+  tree_builder.WithWorldBorderX(0)
+      .WithBroadphase(objects::BroadphaseType::kAabbTree)
+      .WithWorldBorderY(0);
+  const std::unique_ptr<DummyLevel> tree_level = tree_builder.Build();
+
+  ASSERT_NE(tree_level->collision_index_, nullptr);
+  EXPECT_EQ(tree_level->collision_index_->size(), 2);
+}
+
+TEST_F(LevelTest, StaticObjectsArePartitioned) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  dummy_builder.WithScreenObjects().WithWorldBorderX(0).WithWorldBorderY(0);
+
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+
+  ASSERT_NE(dummy_level->collision_index_, nullptr);
+  EXPECT_EQ(dummy_level->collision_index_->size(), 6);
+  EXPECT_EQ(dummy_level->collision_index_->static_size(), 2);
+}
+
+TEST_F(LevelTest, ResolveCollisions) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> movable =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 5});
+  DummyMovableObject* movable_raw = movable.get();
+  std::unique_ptr<StaticObject> static_object = std::make_unique<StaticObject>(
+      /*type=*/ObjectTypeFactory::MakeEnemy(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      FPoint{1, 1});
+  StaticObject* static_object_raw = static_object.get();
+  dummy_builder.AddObject(std::move(static_object))
+      .AddObject(std::move(movable))
+      .WithWorldBorderX(100);
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+
+  dummy_level->ResolveCollisions();
+
+  ASSERT_EQ(dummy_level->contacts_.contacts().size(), 1);
+  EXPECT_THAT(movable_raw->collided_with, ElementsAre(static_object_raw));
+}
+
+TEST_F(LevelTest, Raycast) {
+  for (const objects::BroadphaseType type :
+       {objects::BroadphaseType::kAllPairs,
+        objects::BroadphaseType::kSpatialHashGrid}) {
+    LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                           kNativeScreenHeight);
+    std::unique_ptr<DummyMovableObject> movable =
+        std::make_unique<DummyMovableObject>(FCircle{{50, 0}, 5});
+    const DummyMovableObject* movable_raw = movable.get();
+    std::unique_ptr<StaticObject> static_object =
+        std::make_unique<StaticObject>(
+            /*type=*/ObjectTypeFactory::MakeEnemy(),
+            StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                           .should_draw_hit_box = false},
+            FRectangle{{10, -5}, 10, 10});
+    const StaticObject* static_object_raw = static_object.get();
+    dummy_builder.WithBroadphase(type)
+        .AddObject(std::move(static_object))
+        .AddObject(std::move(movable));
+    const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+
+    const std::optional<objects::RaycastHit> hit =
+        dummy_level->Raycast({0, 0}, {1, 0}, /*max_distance=*/100);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->object, static_object_raw);
+    EXPECT_FLOAT_EQ(hit->distance, 10);
+    EXPECT_EQ(dummy_level
+                  ->ShapeCast(FCircle{{0, 0}, 1}, {1, 0}, 100,
+                              ObjectTypeFactory::MakePlayer().LayerBit())
+                  ->object,
+              movable_raw);
+    EXPECT_EQ(dummy_level->Raycast({0, 0}, {0, 1}, 100), std::nullopt);
+  }
+}
+
+TEST_F(LevelTest, MaybeClick) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<StaticObject> button = std::make_unique<StaticObject>(
+      /*type=*/ObjectTypeFactory::MakeButton(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      FRectangle{{90, 90}, 20, 20});
+  const StaticObject* button_raw = button.get();
+  std::unique_ptr<StaticObject> other_button = std::make_unique<StaticObject>(
+      /*type=*/ObjectTypeFactory::MakeButton(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      FRectangle{{300, 300}, 20, 20});
+  StaticObject* other_button_raw = other_button.get();
+  dummy_builder.AddObject(std::move(button)).AddObject(std::move(other_button));
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+  const auto press = [&dummy_level](const bool is_pressed,
+                                    const ScreenPosition cursor_pos) {
+    dummy_level->controls_ = std::make_unique<ControlsMock>(
+        /*is_pressed=*/false, /*is_down=*/false, is_pressed,
+        /*is_secondary_pressed=*/false, cursor_pos);
+  };
+
+  press(true, {.x = 100, .y = 100});
+  dummy_level->MaybeClick(ctx);
+  EXPECT_TRUE(button_raw->clicked());
+  EXPECT_FALSE(other_button_raw->clicked());
+  EXPECT_THAT(dummy_level->clicked_objects_, ElementsAre(button_raw));
+
+  press(true, {.x = 310, .y = 310});
+  dummy_level->MaybeClick(ctx);
+  EXPECT_FALSE(button_raw->clicked());
+  EXPECT_TRUE(other_button_raw->clicked());
+
+  press(false, {.x = 310, .y = 310});
+  dummy_level->MaybeClick(ctx);
+  EXPECT_FALSE(button_raw->clicked());
+  EXPECT_FALSE(other_button_raw->clicked());
+  EXPECT_TRUE(dummy_level->clicked_objects_.empty());
+
+  press(true, {.x = 310, .y = 310});
+  dummy_level->MaybeClick(ctx);
+  other_button_raw->set_deleted(true);
+  dummy_level->CleanUp();
+  EXPECT_TRUE(dummy_level->clicked_objects_.empty());
+}
+
+TEST_F(LevelTest, SleepAndWake) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> resting =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 5});
+  DummyMovableObject* resting_raw = resting.get();
+  std::unique_ptr<DummyMovableObject> moving =
+      std::make_unique<DummyMovableObject>(FCircle{{20, 0}, 5});
+  DummyMovableObject* moving_raw = moving.get();
+  dummy_builder.AddObject(std::move(resting))
+      .AddObject(std::move(moving))
+      .WithSleepAfterFrames(2);
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+
+  dummy_level->UpdateSleep();
+  EXPECT_EQ(dummy_level->awake_objects(), 2);
+  dummy_level->UpdateSleep();
+  EXPECT_EQ(dummy_level->awake_objects(), 0);
+  EXPECT_EQ(dummy_level->asleep_objects(), 2);
+
+  // Moves next to the resting object.
+  moving_raw->SetDirectionGlobal(-1, 0);
+  moving_raw->set_velocity(11);
+  moving_raw->Update(dummy_level->object_pointers_);
+  EXPECT_TRUE(resting_raw->asleep());
+  dummy_level->ResolveCollisions();
+  dummy_level->UpdateSleep();
+
+  EXPECT_FALSE(resting_raw->asleep());
+  EXPECT_FALSE(moving_raw->asleep());
+  EXPECT_EQ(dummy_level->awake_objects(), 2);
+  EXPECT_EQ(dummy_level->asleep_objects(), 0);
+}
+
+TEST_F(LevelTest, StepSavesPreviousCenters) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> movable =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 5});
+  DummyMovableObject* movable_raw = movable.get();
+  dummy_builder.AddObject(std::move(movable)).WithSimulationRate(60);
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  dummy_level->controls_ = std::make_unique<ControlsMock>(
+      /*is_pressed=*/false, /*is_down=*/false, /*is_primary_pressed=*/false,
+      /*is_secondary_pressed=*/false, ScreenPosition{.x = 0, .y = 0});
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+  movable_raw->SetDirectionGlobal(1, 0);
+
+  dummy_level->Step(ctx);
+  EXPECT_EQ(movable_raw->previous_center(), (WorldPosition{0, 0}));
+  EXPECT_EQ(movable_raw->center(), (WorldPosition{5, 0}));
+  dummy_level->Step(ctx);
+
+  EXPECT_EQ(movable_raw->previous_center(), (WorldPosition{5, 0}));
+  EXPECT_EQ(movable_raw->InterpolatedCenter(0.5f), (WorldPosition{7.5f, 0}));
+  EXPECT_DOUBLE_EQ(dummy_level->timestep_.step_seconds(), 1.0 / 60);
+}
+
+TEST_F(LevelTest, RecordSnapshot) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> lower =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 50}, 5});
+  DummyMovableObject* lower_raw = lower.get();
+  dummy_builder
+      .AddObject(std::move(lower),
+                 /*attach_camera=*/true)
+      .AddObject(std::make_unique<DummyMovableObject>(FCircle{{0, 10}, 5}));
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  lower_raw->SetDirectionGlobal(1, 0);
+  lower_raw->Update(dummy_level->object_pointers_);
+  RenderSnapshot snapshot;
+
+  dummy_level->RecordSnapshot(/*alpha=*/0.5f, snapshot);
+
+  ASSERT_EQ(snapshot.items().size(), 2);
+  EXPECT_EQ(snapshot.items()[0].y_base, 10);
+  EXPECT_EQ(snapshot.items()[1].y_base, 50);
+  EXPECT_EQ(snapshot.items()[1].previous_center, (WorldPosition{0, 50}));
+  EXPECT_EQ(snapshot.items()[1].center, (WorldPosition{5, 50}));
+  EXPECT_EQ(snapshot.alpha(), 0.5f);
+  EXPECT_EQ(snapshot.camera_target(), (WorldPosition{2.5f, 50}));
+}
+
+TEST_F(LevelTest, ThreadsSpawnInOrder) {
+  constexpr int kObjects = 50;
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::vector<DummyMovableObject*> movables;
+  for (int i = 0; i < kObjects; ++i) {
+    std::unique_ptr<DummyMovableObject> movable =
+        std::make_unique<DummyMovableObject>(
+            FCircle{{static_cast<float>(i * 10), 0}, 1});
+    movable->SetDirectionGlobal(0, 1);
+    movables.push_back(movable.get());
+    std::list<std::unique_ptr<Ability>> abilities;
+    abilities.push_back(std::make_unique<SpawnBelowAbility>());
+    dummy_builder.AddObjectAndAbilities(std::move(movable),
+                                        std::move(abilities));
+  }
+  dummy_builder.WithThreads(4);
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  dummy_level->controls_ = std::make_unique<ControlsMock>();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+
+  dummy_level->Step(ctx);
+
+  ASSERT_EQ(dummy_level->objects_.size(), 2 * kObjects);
+  for (int i = 0; i < kObjects; ++i) {
+    EXPECT_EQ(movables[i]->center(),
+              (WorldPosition{static_cast<float>(i * 10), 5}));
+    EXPECT_EQ(dummy_level->object_pointers_[kObjects + i]->center(),
+              (WorldPosition{static_cast<float>(i * 10), 400}));
+  }
+}
+
+TEST_F(LevelTest, RecyclesPooledObjects) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::list<std::unique_ptr<Ability>> abilities;
+  abilities.push_back(std::make_unique<SpawnPooledProjectileAbility>());
+  dummy_builder
+      .AddObjectAndAbilities(
+          std::make_unique<DummyMovableObject>(FCircle{{10, 10}, 1}),
+          std::move(abilities))
+      .WithObjectPool<ProjectileObject>(
+          /*prewarm_count=*/1, ObjectTypeFactory::MakeProjectilePlayer(),
+          ProjectileObject::ProjectileObjectOpts{.hit_box_radius = 1});
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  dummy_level->controls_ = std::make_unique<ControlsMock>();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+  const objects::ObjectPool<ProjectileObject>& pool =
+      *dummy_level->object_pools().Get<ProjectileObject>();
+
+  dummy_level->Step(ctx);
+  ASSERT_EQ(dummy_level->objects_.size(), 2);
+  Object* projectile = dummy_level->object_pointers_[1];
+  projectile->set_deleted(true);
+  dummy_level->Step(ctx);
+
+  // The deleted projectile is spawned again instead of a new one.
+  ASSERT_EQ(dummy_level->objects_.size(), 2);
+  EXPECT_EQ(dummy_level->object_pointers_[1], projectile);
+  EXPECT_FALSE(projectile->deleted());
+  const objects::ObjectPoolStats stats = pool.stats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 0);
+  EXPECT_EQ(stats.recycled, 1);
+
+  dummy_level->Step(ctx);
+
+  EXPECT_EQ(pool.stats().misses, 1);
+}
+
+TEST_F(LevelTest, StepsEntities) {
+  const objects::LayerMask world_borders =
+      objects::MakeLayerMask({ObjectTypeFactory::MakeWorldBorder()});
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  dummy_builder.WithWorldBorderX(20).AddEntity(
+      {.center = {10, 0},
+       .velocity = ecs::Velocity{.speed = 5, .direction_x = 1},
+       .collider =
+           ecs::Collider{.hit_box = internal::HitBox::CreateHitBox(
+                             FCircle{.center = {10, 0}, .radius = 1}),
+                         .should_draw_hit_box = true},
+       .type = ecs::Type{.type = ObjectTypeFactory::MakeProjectilePlayer(),
+                         .collides_with = world_borders},
+       .projectile = ecs::Projectile{.reflect_on_colliding_with_these_objects =
+                                         world_borders}});
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  dummy_level->controls_ = std::make_unique<ControlsMock>();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+  std::vector<WorldPosition> centers;
+
+  for (int step = 0; step < 3; ++step) {
+    dummy_level->Step(ctx);
+    dummy_level->entities().ForEachArchetype(
+        ecs::kTransformComponent, [&centers](const ecs::Archetype& archetype) {
+          centers.push_back(archetype.column<ecs::Transform>()[0].center);
+        });
+  }
+  RenderSnapshot snapshot;
+  dummy_level->RecordSnapshot(/*alpha=*/1, snapshot);
+
+  // Reflected by the world border in the second step.
+  EXPECT_THAT(centers, ElementsAre(WorldPosition{15, 0}, WorldPosition{15, 0},
+                                   WorldPosition{10, 0}));
+  // Entities are recorded after the objects, the world border comes first.
+  ASSERT_EQ(snapshot.items().size(), 2);
+  EXPECT_EQ(snapshot.items()[1].previous_center, (WorldPosition{15, 0}));
+  EXPECT_EQ(snapshot.items()[1].center, (WorldPosition{10, 0}));
+  EXPECT_TRUE(snapshot.items()[1].hit_box.has_value());
+}
+
+TEST_F(LevelTest, ObjectsDoNotCollideWithEntities) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> movable =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 1});
+  movable->SetDirectionGlobal(1, 0);
+  DummyMovableObject* movable_raw = movable.get();
+  dummy_builder.AddObject(std::move(movable))
+      .AddEntity(
+          {.center = {7, 0},
+           .collider = ecs::Collider{.hit_box = internal::HitBox::CreateHitBox(
+                                         FLine{.a = {7, -5}, .b = {7, 5}})},
+           .type = ecs::Type{.type = ObjectTypeFactory::MakeWorldBorder()}});
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+  dummy_level->controls_ = std::make_unique<ControlsMock>();
+  const ViewPortContext ctx(kNativeScreenWidth, kNativeScreenHeight,
+                            kNativeScreenWidth, kNativeScreenHeight);
+
+  dummy_level->Step(ctx);
+  dummy_level->Step(ctx);
+
+  // Walks through the wall entity, an object wall would have stopped it.
+  EXPECT_THAT(movable_raw->collided_with, IsEmpty());
+  EXPECT_EQ(movable_raw->center(), (WorldPosition{10, 0}));
+}
+
+TEST_F(LevelTest, RunHeadless) {
+  const std::shared_ptr<InputScript> script = std::make_shared<InputScript>(
+      std::vector<ScriptedInput>{{.down = {kKeyD}},
+                                 {.down = {kKeyD}},
+                                 {},
+                                 {.pressed = {kKeyEscape}}});
+  LevelBuilder<Level> builder(kFirstLevel, kNativeScreenWidth,
+                              kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> movable =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 1});
+  DummyMovableObject* movable_raw = movable.get();
+  std::list<std::unique_ptr<Ability>> abilities;
+  abilities.push_back(std::make_unique<MoveAbility>(
+      std::make_unique<ScriptedControls>(script),
+      MoveAbility::MoveAbilityOpts{.key_right = kKeyD}));
+  builder.AddObjectAndAbilities(std::move(movable), std::move(abilities))
+      .WithControls(std::make_unique<ScriptedControls>(script));
+  const std::unique_ptr<Level> level = builder.Build();
+  Stats stats;
+
+  const HeadlessRun run = level->RunHeadless(
+      {.steps = 10, .script = script.get(), .record_snapshots = true}, stats);
+
+  // Stops in the step in which escape is pressed.
+  EXPECT_EQ(run.next_level, kExitLevel);
+  ASSERT_EQ(run.steps.size(), 4);
+  EXPECT_EQ(run.steps[0].objects, 1);
+  EXPECT_EQ(run.steps[0].awake_objects, 1);
+  EXPECT_EQ(run.steps[0].contacts, 0);
+  EXPECT_EQ(movable_raw->center(), (WorldPosition{10, 0}));
+  EXPECT_EQ(script->step(), 4);
+  if (internal::kProfilerEnabled) {
+    // Every step is a frame of the profiler.
+    EXPECT_EQ(level->profiler().frames(), 4);
+    EXPECT_EQ(level->profiler().last_counters().objects, 1);
+  }
+}
+
+TEST_F(LevelTest, RecordsAndReplaysInput) {
+  // Shoots in the first step, is on cooldown until a second of steps has
+  // been simulated and shoots again after.
+  std::vector<ScriptedInput> input(kDefaultSimulationRate + 10,
+                                   ScriptedInput{.down = {kKeyD}});
+  for (const size_t step : {size_t{0}, size_t{1}, input.size() - 1}) {
+    input[step].pressed = {kKeySpace};
+  }
+  const InputLog script(std::move(input));
+  const int steps = static_cast<int>(script.steps().size()) + 20;
+  const std::unique_ptr<Level> level = BuildShooterLevel();
+  InputLog recorded;
+  level->RecordInput(&recorded);
+  Stats stats;
+
+  const HeadlessRun run = level->RunHeadless(
+      {.steps = steps, .replay = &script, .hash_state = true}, stats);
+  level->RecordInput(nullptr);
+  const std::optional<InputLog> parsed = InputLog::Parse(recorded.Serialize());
+  ASSERT_TRUE(parsed.has_value());
+  const std::unique_ptr<Level> replayed_level = BuildShooterLevel();
+  const HeadlessRun replay = replayed_level->RunHeadless(
+      {.steps = steps, .replay = &*parsed, .hash_state = true}, stats);
+
+  ASSERT_EQ(recorded.steps().size(), steps);
+  EXPECT_EQ(recorded.steps()[1], script.steps()[1]);
+  EXPECT_EQ(recorded.steps().back(), ScriptedInput{});
+  EXPECT_EQ(run.steps.back().objects, 3);
+  ASSERT_EQ(replay.steps.size(), run.steps.size());
+  for (size_t step = 0; step < run.steps.size(); ++step) {
+    ASSERT_TRUE(run.steps[step].state_hash.has_value());
+    EXPECT_EQ(replay.steps[step].state_hash, run.steps[step].state_hash)
+        << "step " << step;
+  }
+  EXPECT_NE(run.steps[0].state_hash, run.steps[1].state_hash);
+  EXPECT_EQ(replayed_level->StateHash(), level->StateHash());
+}
+
+TEST_F(LevelTest, WithThreads) {
+  LevelBuilder<DummyLevel> dummy_builder(kInvalidLevel, kNativeScreenWidth,
+                                         kNativeScreenHeight);
+  std::unique_ptr<DummyMovableObject> movable =
+      std::make_unique<DummyMovableObject>(FCircle{{0, 0}, 5});
+  DummyMovableObject* movable_raw = movable.get();
+  dummy_builder.AddObject(std::move(movable))
+      .WithWorldBorderX(1)
+      .WithWorldBorderY(100)
+      .WithThreads(4);
+  const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
+
+  dummy_level->ResolveCollisions();
+
+  ASSERT_NE(dummy_level->jobs_, nullptr);
+  EXPECT_EQ(dummy_level->jobs_->num_threads(), 4);
+  ASSERT_EQ(dummy_level->contacts_.contacts().size(), 1);
+  EXPECT_EQ(movable_raw->collided_with.size(), 1);
+
+  LevelBuilder<DummyLevel> single_thread_builder(
+      kInvalidLevel, kNativeScreenWidth, kNativeScreenHeight);
+  single_thread_builder.WithThreads(1);
+  EXPECT_EQ(single_thread_builder.Build()->jobs_, nullptr);
 }
 
 TEST_F(LevelTest, ObjectsAreAdded) {
@@ -144,10 +711,8 @@ TEST_F(LevelTest, ObjectsAreAdded) {
   const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
 
   ASSERT_EQ(dummy_level->objects_.size(), 2);
-  auto it = dummy_level->objects_.begin();
-  EXPECT_TRUE((*it)->type().IsPlayer());
-  ++it;
-  EXPECT_TRUE((*it)->type().IsEnemy());
+  EXPECT_TRUE(dummy_level->object_pointers_[0]->type().IsPlayer());
+  EXPECT_TRUE(dummy_level->object_pointers_[1]->type().IsEnemy());
 }
 
 TEST_F(LevelTest, ObjectsAndAbilitiesAreAdded) {
@@ -171,8 +736,10 @@ TEST_F(LevelTest, ObjectsAndAbilitiesAreAdded) {
   const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
 
   ASSERT_EQ(dummy_level->objects_.size(), 1);
-  ASSERT_EQ(dummy_level->abilities_.size(), 1);
-  EXPECT_TRUE(dummy_level->objects_.front()->type().IsPlayer());
+  const auto& [object, object_abilities] = dummy_level->objects_.values()[0];
+  EXPECT_TRUE(object->type().IsPlayer());
+  ASSERT_EQ(object_abilities.size(), 1);
+  EXPECT_EQ(object_abilities.front()->user(), object.get());
 }
 
 TEST_F(LevelTest, ScreenEdgeObjects) {
@@ -185,7 +752,7 @@ TEST_F(LevelTest, ScreenEdgeObjects) {
   ASSERT_EQ(dummy_level->screen_edge_objects_.size(), 4);
   std::vector<ObjectType> object_types;
   std::vector<ObjectType> screen_edge_types;
-  for (const auto& object : dummy_level->objects_) {
+  for (const objects::Object* object : dummy_level->object_pointers_) {
     object_types.push_back(object->type());
   }
   for (const auto& object : dummy_level->screen_edge_objects_) {
@@ -214,7 +781,7 @@ TEST_F(LevelTest, CoordinateObjects) {
   ASSERT_EQ(dummy_level->coordinate_objects_.size(), 2);
   std::vector<ObjectType> object_types;
   std::vector<ObjectType> coordinate_types;
-  for (const auto& object : dummy_level->objects_) {
+  for (const objects::Object* object : dummy_level->object_pointers_) {
     object_types.push_back(object->type());
   }
   for (const auto& object : dummy_level->coordinate_objects_) {
@@ -619,7 +1186,8 @@ TEST_F(LevelTest, DrawBackground) {
   dummy_builder.AddBackgroundLayer(std::move(sprite_1));
   const std::unique_ptr<DummyLevel> dummy_level = dummy_builder.Build();
 
-  dummy_level->DrawBackgrounds();
+  dummy_level->DrawBackgrounds(
+      {.x = kNativeScreenWidth / 2, .y = kNativeScreenHeight / 2});
 
   {
     EXPECT_EQ(graphics_0->loaded_texture(), resource_path_0);
@@ -0,0 +1,162 @@
+#include "lib/api/objects/broadphase_collision_index.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/api/objects/object.h"
+#include "lib/internal/aabb_tree.h"
+#include "lib/internal/broadphase.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+#include "lib/internal/spatial_hash_grid.h"
+#include "lib/internal/sweep_and_prune.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+namespace {
+
+using internal::ProxyId;
+
+std::unique_ptr<internal::Broadphase> MakeBroadphase(
+    const BroadphaseType type) {
+  switch (type) {
+    case BroadphaseType::kAllPairs:
+      return nullptr;
+    case BroadphaseType::kSpatialHashGrid:
+      return std::make_unique<internal::SpatialHashGrid>(
+          kDefaultBroadphaseCellSize);
+    case BroadphaseType::kAabbTree:
+      return std::make_unique<internal::AabbTree>();
+    case BroadphaseType::kSweepAndPrune:
+      return std::make_unique<internal::SweepAndPrune>();
+  }
+  CHECK(false) << "Unknown broadphase type.";
+  return nullptr;
+}
+
+}  // namespace
+
+std::unique_ptr<BroadphaseCollisionIndex> BroadphaseCollisionIndex::Create(
+    const BroadphaseType type) {
+  if (type == BroadphaseType::kAllPairs) {
+    return nullptr;
+  }
+  return std::make_unique<BroadphaseCollisionIndex>(MakeBroadphase(type),
+                                                    MakeBroadphase(type));
+}
+
+BroadphaseCollisionIndex::BroadphaseCollisionIndex(
+    std::unique_ptr<internal::Broadphase> broadphase,
+    std::unique_ptr<internal::Broadphase> static_broadphase)
+    : broadphase_(std::move(broadphase)),
+      static_broadphase_(std::move(static_broadphase)),
+      next_id_(0) {
+  CHECK(broadphase_ != nullptr) << "Broadphase must be set.";
+  CHECK(static_broadphase_ != nullptr) << "Static broadphase must be set.";
+}
+
+void BroadphaseCollisionIndex::Add(Object& object) {
+  const ProxyId id = next_id_++;
+  const auto [it, inserted] = ids_.try_emplace(&object, id);
+  CHECK(inserted) << "Object has already been added.";
+  objects_[id] = &object;
+  BroadphaseFor(object).Insert(id,
+                               object.bounding_box().Expand(kBroadphaseMargin));
+  object.set_collision_index(this);
+}
+
+void BroadphaseCollisionIndex::Remove(Object& object) {
+  const auto it = ids_.find(&object);
+  if (it == ids_.end()) {
+    return;
+  }
+  BroadphaseFor(object).Remove(it->second);
+  objects_.erase(it->second);
+  ids_.erase(it);
+  object.set_collision_index(nullptr);
+}
+
+void BroadphaseCollisionIndex::Update(const Object& object) {
+  const auto it = ids_.find(&object);
+  CHECK(it != ids_.end()) << "Object has not been added.";
+  CHECK(!object.IsStatic()) << "Static objects cannot move.";
+  broadphase_->Update(it->second,
+                      object.bounding_box().Expand(kBroadphaseMargin));
+}
+
+bool BroadphaseCollisionIndex::ForEachCandidate(
+    const Object& object, const absl::FunctionRef<bool(Object&)> callback) {
+  // Reused between queries to avoid allocating every frame. Thread local, so
+  // that objects can look for candidates from several threads at once.
+  thread_local std::vector<ProxyId> candidates;
+  candidates.clear();
+  const internal::Aabb query = object.bounding_box().Expand(kBroadphaseMargin);
+  const auto add_candidate = [](const ProxyId id) {
+    candidates.push_back(id);
+  };
+  broadphase_->Query(query, add_candidate);
+  // Static objects never look for candidates themselves, so static-vs-static
+  // pairs are never evaluated.
+  if (!object.IsStatic()) {
+    static_broadphase_->Query(query, add_candidate);
+  }
+  std::ranges::sort(candidates);
+  for (const ProxyId id : candidates) {
+    Object* candidate = objects_.at(id);
+    if (candidate == &object) {
+      continue;
+    }
+    if (callback(*candidate)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void BroadphaseCollisionIndex::ForEachOnRay(
+    const internal::Ray& ray, const float thickness,
+    const absl::FunctionRef<void(Object&)> callback) const {
+  thread_local std::vector<ProxyId> candidates;
+  candidates.clear();
+  const auto add_candidate = [](const ProxyId id) {
+    candidates.push_back(id);
+  };
+  broadphase_->QueryRay(ray, thickness, add_candidate);
+  static_broadphase_->QueryRay(ray, thickness, add_candidate);
+  std::ranges::sort(candidates);
+  for (const ProxyId id : candidates) {
+    callback(*objects_.at(id));
+  }
+}
+
+void BroadphaseCollisionIndex::ForEachInBox(
+    const internal::Aabb& aabb,
+    const absl::FunctionRef<void(Object&)> callback) const {
+  thread_local std::vector<ProxyId> candidates;
+  candidates.clear();
+  const auto add_candidate = [](const ProxyId id) {
+    candidates.push_back(id);
+  };
+  broadphase_->Query(aabb, add_candidate);
+  static_broadphase_->Query(aabb, add_candidate);
+  std::ranges::sort(candidates);
+  for (const ProxyId id : candidates) {
+    callback(*objects_.at(id));
+  }
+}
+
+internal::Broadphase& BroadphaseCollisionIndex::BroadphaseFor(
+    const Object& object) {
+  return object.IsStatic() ? *static_broadphase_ : *broadphase_;
+}
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,83 @@
+#ifndef LIB_API_OBJECTS_BROADPHASE_COLLISION_INDEX_H
+#define LIB_API_OBJECTS_BROADPHASE_COLLISION_INDEX_H
+
+#include <memory>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "lib/api/objects/collision_index.h"
+#include "lib/api/objects/object.h"
+#include "lib/internal/broadphase.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+// Side of a single grid cell in world units.
+static constexpr float kDefaultBroadphaseCellSize = 128;
+// Bounding boxes are grown by this much so that touching shapes, which the
+// narrowphase considers colliding within `eps`, are never discarded.
+static constexpr float kBroadphaseMargin = 1;
+
+enum class BroadphaseType {
+  // No broadphase, every object is checked against every other object.
+  kAllPairs,
+  // Uniform grid, best when objects have similar sizes.
+  kSpatialHashGrid,
+  // Dynamic AABB tree, handles objects of very different sizes.
+  kAabbTree,
+  // Sweep and prune, best when objects move little between frames.
+  kSweepAndPrune,
+};
+
+// Static objects are kept in their own broadphase which is never updated and
+// never queried on their behalf - they are only found as candidates of
+// objects which move.
+class BroadphaseCollisionIndex : public CollisionIndex {
+ public:
+  // Returns nullptr for `BroadphaseType::kAllPairs`.
+  static std::unique_ptr<BroadphaseCollisionIndex> Create(BroadphaseType type);
+
+  BroadphaseCollisionIndex(
+      std::unique_ptr<internal::Broadphase> broadphase,
+      std::unique_ptr<internal::Broadphase> static_broadphase);
+
+  void Add(Object& object) override;
+  void Remove(Object& object) override;
+  void Update(const Object& object) override;
+  bool ForEachCandidate(const Object& object,
+                        absl::FunctionRef<bool(Object&)> callback) override;
+  // Calls `callback` for every object, static or not, which a shape fitting
+  // into a `thickness` sized box moving along `ray` might hit, in the order
+  // the objects were added.
+  void ForEachOnRay(const internal::Ray& ray, float thickness,
+                    absl::FunctionRef<void(Object&)> callback) const;
+  // Calls `callback` for every object, static or not, which might overlap
+  // `aabb`, in the order the objects were added.
+  void ForEachInBox(const internal::Aabb& aabb,
+                    absl::FunctionRef<void(Object&)> callback) const;
+
+  [[nodiscard]] size_t size() const { return objects_.size(); }
+  [[nodiscard]] size_t static_size() const {
+    return static_broadphase_->size();
+  }
+
+ private:
+  [[nodiscard]] internal::Broadphase& BroadphaseFor(const Object& object);
+
+  std::unique_ptr<internal::Broadphase> broadphase_;
+  std::unique_ptr<internal::Broadphase> static_broadphase_;
+  // Ids are handed out in increasing order, so sorting candidates by id
+  // yields them in the order the objects were added.
+  internal::ProxyId next_id_;
+  absl::flat_hash_map<const Object*, internal::ProxyId> ids_;
+  absl::flat_hash_map<internal::ProxyId, Object*> objects_;
+};
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_OBJECTS_BROADPHASE_COLLISION_INDEX_H
@@ -0,0 +1,229 @@
+#include "lib/api/objects/broadphase_collision_index.h"
+
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/contact_list.h"
+#include "lib/api/objects/movable_object.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+class DummyMovableObject : public MovableObject {
+ public:
+  DummyMovableObject(const float velocity, const HitBoxVariant& hit_box)
+      : MovableObject(
+            /*type=*/ObjectTypeFactory::MakePlayer(),
+            MovableObjectOpts{.is_hit_box_active = true,
+                              .should_draw_hit_box = false,
+                              .attach_camera = false,
+                              .velocity = velocity},
+            hit_box) {}
+
+  bool OnCollisionCallback(Object& other_object) override {
+    collided_with.push_back(&other_object);
+    return false;
+  }
+
+  std::vector<Object*> collided_with;
+};
+
+std::unique_ptr<StaticObject> MakeStaticObject(const HitBoxVariant& hit_box) {
+  return std::make_unique<StaticObject>(
+      ObjectTypeFactory::MakeEnemy(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      hit_box);
+}
+
+std::vector<Object*> Candidates(BroadphaseCollisionIndex& index,
+                                const Object& object) {
+  std::vector<Object*> candidates;
+  index.ForEachCandidate(object, [&candidates](Object& candidate) {
+    candidates.push_back(&candidate);
+    return false;
+  });
+  return candidates;
+}
+
+// Moves `movable` and delivers its collisions.
+void UpdateAndCollide(DummyMovableObject& movable) {
+  ContactList contacts;
+  movable.Update({});
+  contacts.Detect(movable, {});
+  contacts.Dispatch();
+}
+
+class BroadphaseCollisionIndexTest
+    : public ::testing::TestWithParam<BroadphaseType> {};
+
+TEST_P(BroadphaseCollisionIndexTest, CandidatesAreNearbyInInsertionOrder) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> far =
+      MakeStaticObject(FRectangle{{1000, 1000}, 5, 5});
+  std::unique_ptr<StaticObject> second =
+      MakeStaticObject(FRectangle{{3, 3}, 5, 5});
+  std::unique_ptr<StaticObject> first =
+      MakeStaticObject(FRectangle{{-30, -30}, 60, 60});
+  DummyMovableObject object(/*velocity=*/0, FPoint{4, 4});
+  index->Add(*far);
+  index->Add(*first);
+  index->Add(object);
+  index->Add(*second);
+
+  EXPECT_THAT(Candidates(*index, object),
+              ElementsAre(first.get(), second.get()));
+}
+
+TEST_P(BroadphaseCollisionIndexTest, ForEachCandidateStopsOnTrue) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> first = MakeStaticObject(FPoint{1, 1});
+  std::unique_ptr<StaticObject> second = MakeStaticObject(FPoint{1, 1});
+  DummyMovableObject object(/*velocity=*/0, FPoint{1, 1});
+  index->Add(*first);
+  index->Add(*second);
+  index->Add(object);
+
+  int calls = 0;
+  EXPECT_TRUE(index->ForEachCandidate(object, [&calls](Object&) {
+    ++calls;
+    return true;
+  }));
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_P(BroadphaseCollisionIndexTest, Remove) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> other = MakeStaticObject(FPoint{1, 1});
+  DummyMovableObject object(/*velocity=*/0, FPoint{1, 1});
+  index->Add(*other);
+  index->Add(object);
+
+  index->Remove(*other);
+
+  EXPECT_EQ(index->size(), 1);
+  EXPECT_EQ(index->static_size(), 0);
+  EXPECT_THAT(Candidates(*index, object), IsEmpty());
+}
+
+TEST_P(BroadphaseCollisionIndexTest, StaticObjectsAreOnlyPassive) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> first = MakeStaticObject(FPoint{1, 1});
+  DummyMovableObject movable(/*velocity=*/0, FPoint{1, 1});
+  std::unique_ptr<StaticObject> second = MakeStaticObject(FPoint{1, 1});
+  index->Add(*first);
+  index->Add(movable);
+  index->Add(*second);
+
+  EXPECT_EQ(index->size(), 3);
+  EXPECT_EQ(index->static_size(), 2);
+  EXPECT_THAT(Candidates(*index, movable),
+              ElementsAre(first.get(), second.get()));
+  EXPECT_THAT(Candidates(*index, *first), ElementsAre(&movable));
+}
+
+TEST_P(BroadphaseCollisionIndexTest, MovingObjectUpdatesIndex) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> wall =
+      MakeStaticObject(FLine{{100, -50}, {100, 50}});
+  DummyMovableObject movable(/*velocity=*/50, FCircle{{0, 0}, 5});
+  index->Add(*wall);
+  index->Add(movable);
+  movable.SetDirectionGlobal(1, 0);
+
+  UpdateAndCollide(movable);
+  EXPECT_THAT(movable.collided_with, IsEmpty());
+  UpdateAndCollide(movable);
+  EXPECT_THAT(movable.collided_with, ElementsAre(wall.get()));
+}
+
+TEST_P(BroadphaseCollisionIndexTest, TouchingObjectsAreCandidates) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  std::unique_ptr<StaticObject> line =
+      MakeStaticObject(FLine{{10, 0}, {10, 9}});
+  DummyMovableObject movable(/*velocity=*/1, FRectangle{{0, 0}, 10, 5});
+  index->Add(*line);
+  index->Add(movable);
+
+  UpdateAndCollide(movable);
+
+  EXPECT_THAT(movable.collided_with, ElementsAre(line.get()));
+}
+
+TEST_P(BroadphaseCollisionIndexTest, ForEachOnRayInInsertionOrder) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  DummyMovableObject far(/*velocity=*/0, FCircle{{100, 0}, 5});
+  std::unique_ptr<StaticObject> wall =
+      MakeStaticObject(FLine{{50, -5}, {50, 5}});
+  DummyMovableObject off_ray(/*velocity=*/0, FCircle{{20, 30}, 5});
+  index->Add(far);
+  index->Add(*wall);
+  index->Add(off_ray);
+  const internal::Ray ray = {
+      .origin = {0, 0}, .direction = {1, 0}, .max_distance = 200};
+
+  std::vector<Object*> on_ray;
+  index->ForEachOnRay(ray, /*thickness=*/0, [&on_ray](Object& object) {
+    on_ray.push_back(&object);
+  });
+  std::vector<Object*> on_thick_ray;
+  index->ForEachOnRay(ray, /*thickness=*/30, [&on_thick_ray](Object& object) {
+    on_thick_ray.push_back(&object);
+  });
+
+  EXPECT_THAT(on_ray, ElementsAre(&far, wall.get()));
+  EXPECT_THAT(on_thick_ray, ElementsAre(&far, wall.get(), &off_ray));
+}
+
+TEST_P(BroadphaseCollisionIndexTest, ForEachInBoxInInsertionOrder) {
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(GetParam());
+  DummyMovableObject inside(/*velocity=*/0, FCircle{{10, 10}, 5});
+  std::unique_ptr<StaticObject> wall =
+      MakeStaticObject(FLine{{0, -50}, {0, 50}});
+  DummyMovableObject outside(/*velocity=*/0, FCircle{{100, 100}, 5});
+  index->Add(inside);
+  index->Add(*wall);
+  index->Add(outside);
+
+  std::vector<Object*> in_box;
+  index->ForEachInBox({.min_x = -20, .min_y = -20, .max_x = 20, .max_y = 20},
+                      [&in_box](Object& object) { in_box.push_back(&object); });
+
+  EXPECT_THAT(in_box, ElementsAre(&inside, wall.get()));
+}
+
+INSTANTIATE_TEST_SUITE_P(Broadphases, BroadphaseCollisionIndexTest,
+                         ::testing::Values(BroadphaseType::kSpatialHashGrid,
+                                           BroadphaseType::kAabbTree,
+                                           BroadphaseType::kSweepAndPrune));
+
+TEST(BroadphaseCollisionIndexCreateTest, AllPairsHasNoIndex) {
+  EXPECT_EQ(BroadphaseCollisionIndex::Create(BroadphaseType::kAllPairs),
+            nullptr);
+}
+
+}  // namespace
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,45 @@
+#ifndef LIB_API_OBJECTS_COLLISION_INDEX_H
+#define LIB_API_OBJECTS_COLLISION_INDEX_H
+
+#include "absl/functional/function_ref.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+class Object;
+
+// Broadphase which `Object` uses to find objects it could collide with.
+// This separation is required so that cyclic dependency is not introduced
+// between Object and the broadphase implementations.
+class CollisionIndex {
+ public:
+  virtual ~CollisionIndex() = default;
+
+  virtual void Add(Object& object) = 0;
+  virtual void Remove(Object& object) = 0;
+  // Has to be called every time hit box of the `object` changes.
+  virtual void Update(const Object& object) = 0;
+  // Calls `callback` for every other object which might collide with `object`
+  // in the order the objects were added. Stops and returns true as soon as
+  // `callback` returns true.
+  virtual bool ForEachCandidate(const Object& object,
+                                absl::FunctionRef<bool(Object&)> callback) = 0;
+
+  // While set, objects only remember that their hit box changed and call
+  // `Update` from `Object::FlushCollisionIndexUpdate`, so that objects can
+  // move on several threads at once.
+  void set_defers_updates(const bool defers_updates) {
+    defers_updates_ = defers_updates;
+  }
+  [[nodiscard]] bool defers_updates() const { return defers_updates_; }
+
+ private:
+  bool defers_updates_ = false;
+};
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_OBJECTS_COLLISION_INDEX_H
@@ -0,0 +1,166 @@
+#include "lib/api/objects/contact_list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/types/span.h"
+#include "lib/api/objects/object.h"
+#include "lib/internal/job_system.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+namespace {
+
+Contact MakeContact(Object& object, Object& other) {
+  return {.object = &object,
+          .other = &other,
+          .type = object.type(),
+          .other_type = other.type()};
+}
+
+}  // namespace
+
+void ContactList::Detect(Object& object,
+                         absl::Span<Object* const> other_objects) {
+  object.ForEachCollision(other_objects, [this, &object](Object& other) {
+    contacts_.push_back(MakeContact(object, other));
+  });
+}
+
+void ContactList::DetectAll(absl::Span<Object* const> objects,
+                            absl::Nullable<internal::JobSystem*> jobs) {
+  // `clear` frees the memory of large tables.
+  orders_.erase(orders_.begin(), orders_.end());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    orders_[objects[i]] = i;
+  }
+  const size_t num_chunks = jobs == nullptr
+                                ? std::min(objects.size(), size_t{1})
+                                : jobs->NumChunks(objects.size());
+  if (chunk_contacts_.size() < num_chunks) {
+    chunk_contacts_.resize(num_chunks);
+    chunk_hit_box_tests_.resize(num_chunks);
+  }
+  const auto detect_chunk = [this, &objects](const size_t chunk,
+                                             const size_t begin,
+                                             const size_t end) {
+    std::vector<OrderedContact>& chunk_contacts = chunk_contacts_[chunk];
+    chunk_contacts.clear();
+    chunk_hit_box_tests_[chunk] = 0;
+    for (size_t i = begin; i < end; ++i) {
+      DetectOnce(*objects[i], i, objects, chunk_contacts,
+                 chunk_hit_box_tests_[chunk]);
+    }
+  };
+  if (jobs == nullptr) {
+    if (num_chunks == 1) {
+      detect_chunk(0, 0, objects.size());
+    }
+  } else {
+    jobs->ParallelForChunks(objects.size(), detect_chunk);
+  }
+
+  // A pair is found by the object which comes first, restore the order in
+  // which every object would have found its own contacts. No two contacts
+  // have the same orders, so the result does not depend on the chunks.
+  ordered_contacts_.clear();
+  hit_box_tests_ = 0;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    hit_box_tests_ += chunk_hit_box_tests_[chunk];
+    ordered_contacts_.insert(ordered_contacts_.end(),
+                             chunk_contacts_[chunk].begin(),
+                             chunk_contacts_[chunk].end());
+  }
+  std::ranges::sort(ordered_contacts_, [](const OrderedContact& a,
+                                          const OrderedContact& b) {
+    return std::tie(a.object_order, a.other_order) <
+           std::tie(b.object_order, b.other_order);
+  });
+  for (const OrderedContact& ordered_contact : ordered_contacts_) {
+    contacts_.push_back(ordered_contact.contact);
+  }
+}
+
+void ContactList::DetectOnce(Object& object, const size_t order,
+                             absl::Span<Object* const> objects,
+                             std::vector<OrderedContact>& contacts,
+                             size_t& hit_box_tests) const {
+  if (!object.LooksForCollisions()) {
+    return;
+  }
+
+  object.ForEachCandidate(objects, [this, &object, order, &contacts,
+                                    &hit_box_tests](Object& other) {
+    if (!object.LooksForCollisionsWith(other)) {
+      return;
+    }
+    const bool mutual = other.LooksForCollisionsWith(object);
+    const size_t other_order = orders_.at(&other);
+    // Already compared when `other` looked for its collisions.
+    if (mutual && other_order < order) {
+      return;
+    }
+    ++hit_box_tests;
+    if (!object.CollidesWith(other)) {
+      return;
+    }
+    contacts.push_back({.object_order = order,
+                        .other_order = other_order,
+                        .contact = MakeContact(object, other)});
+    if (mutual) {
+      contacts.push_back({.object_order = other_order,
+                          .other_order = order,
+                          .contact = MakeContact(other, object)});
+    }
+  });
+}
+
+void ContactList::Dispatch() {
+  // Sorting by the detection order as well keeps contacts with the same type
+  // pair in order, without the heap allocated buffer of `std::stable_sort`.
+  order_.clear();
+  for (size_t i = 0; i < contacts_.size(); ++i) {
+    order_.push_back(i);
+  }
+  std::ranges::sort(order_, [this](const size_t a, const size_t b) {
+    const Contact& contact_a = contacts_[a];
+    const Contact& contact_b = contacts_[b];
+    if (contact_a.type != contact_b.type) {
+      return contact_a.type < contact_b.type;
+    }
+    if (contact_a.other_type != contact_b.other_type) {
+      return contact_a.other_type < contact_b.other_type;
+    }
+    return a < b;
+  });
+  sorted_contacts_.clear();
+  for (const size_t i : order_) {
+    sorted_contacts_.push_back(contacts_[i]);
+  }
+  contacts_.swap(sorted_contacts_);
+  resolved_.erase(resolved_.begin(), resolved_.end());
+  for (const Contact& contact : contacts_) {
+    // Deleted objects do not collide anymore, also when an earlier callback
+    // of this dispatch has deleted them.
+    if (contact.object->deleted() || contact.other->deleted() ||
+        resolved_.contains(contact.object)) {
+      continue;
+    }
+    if (contact.object->ResolveCollision(*contact.other)) {
+      resolved_.insert(contact.object);
+    }
+  }
+}
+
+void ContactList::Clear() {
+  contacts_.clear();
+}
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,88 @@
+#ifndef LIB_API_OBJECTS_CONTACT_LIST_H
+#define LIB_API_OBJECTS_CONTACT_LIST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/span.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/internal/job_system.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+// `object` has collided with `other`. Types are copied so that contacts can be
+// sorted without touching the objects.
+struct Contact {
+  Object* object;
+  Object* other;
+  ObjectType type;
+  ObjectType other_type;
+};
+
+// Collisions of a single frame. Detection only records contacts and does not
+// change any object, collision callbacks are delivered afterwards in one go.
+class ContactList {
+ public:
+  // Records every collision of `object` with `other_objects`.
+  void Detect(Object& object, absl::Span<Object* const> other_objects);
+  // Records the collisions of every object in `objects`. The result is the
+  // same as calling `Detect` for every object in order, but when two objects
+  // look for collisions with each other their hit boxes are only compared
+  // once. With `jobs` the objects are split into chunks which are detected
+  // in parallel.
+  void DetectAll(absl::Span<Object* const> objects,
+                 absl::Nullable<internal::JobSystem*> jobs = nullptr);
+  // Delivers the recorded contacts sorted by type pair. Contacts with the same
+  // type pair are delivered in the order they were detected. Once a callback
+  // changes the object state, remaining contacts of that object are skipped.
+  void Dispatch();
+  void Clear();
+
+  [[nodiscard]] absl::Span<const Contact> contacts() const {
+    return contacts_;
+  }
+  // Pairs of hit boxes compared by the last `DetectAll`, whether they
+  // collided or not.
+  [[nodiscard]] size_t hit_box_tests() const { return hit_box_tests_; }
+
+ private:
+  // Contact with the positions of both objects in the objects passed to
+  // `DetectAll`, which give the order `Detect` would have found it in.
+  struct OrderedContact {
+    size_t object_order;
+    size_t other_order;
+    Contact contact;
+  };
+
+  // Records the collisions of `object`, and of the objects which collide with
+  // `object` and come after it, into `contacts`.
+  void DetectOnce(Object& object, size_t order,
+                  absl::Span<Object* const> objects,
+                  std::vector<OrderedContact>& contacts,
+                  size_t& hit_box_tests) const;
+
+  std::vector<Contact> contacts_;
+  size_t hit_box_tests_ = 0;
+  // Reused between frames to avoid allocating every frame.
+  absl::flat_hash_map<const Object*, size_t> orders_;
+  std::vector<std::vector<OrderedContact>> chunk_contacts_;
+  std::vector<size_t> chunk_hit_box_tests_;
+  std::vector<OrderedContact> ordered_contacts_;
+  // Reused by `Dispatch` to avoid allocating every frame.
+  std::vector<size_t> order_;
+  std::vector<Contact> sorted_contacts_;
+  // Reused between frames to avoid allocating every frame.
+  absl::flat_hash_set<const Object*> resolved_;
+};
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_OBJECTS_CONTACT_LIST_H
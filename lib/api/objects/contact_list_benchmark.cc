@@ -0,0 +1,134 @@
+// Measures how collision detection scales with the number of threads on a
+// level with 10k objects.
+//
+//   bazel run -c opt //lib/api/objects:contact_list_benchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/types/span.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/contact_list.h"
+#include "lib/api/objects/movable_object.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/internal/job_system.h"
+
+ABSL_FLAG(int, max_threads,
+          static_cast<int>(std::max(1u, std::thread::hardware_concurrency())),
+          "Largest number of threads to measure.");
+ABSL_FLAG(int, frames, 50, "Frames measured for every number of threads.");
+
+namespace lib {
+namespace api {
+namespace objects {
+namespace {
+
+constexpr int kMovableObjects = 8000;
+constexpr int kStaticObjects = 2000;
+constexpr float kWorldSize = 4000;
+
+class BenchmarkObject : public MovableObject {
+ public:
+  BenchmarkObject(const ObjectType type, const HitBoxVariant& hit_box)
+      : MovableObject(type,
+                      MovableObjectOpts{.is_hit_box_active = true,
+                                        .should_draw_hit_box = false,
+                                        .attach_camera = false,
+                                        .velocity = 0},
+                      hit_box) {}
+
+  bool OnCollisionCallback(Object&) override { return false; }
+};
+
+std::list<std::unique_ptr<Object>> MakeObjects() {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> coordinate(0, kWorldSize);
+  std::uniform_real_distribution<float> size(2, 12);
+  std::list<std::unique_ptr<Object>> objects;
+  for (int i = 0; i < kMovableObjects; ++i) {
+    objects.push_back(std::make_unique<BenchmarkObject>(
+        i % 2 == 0 ? ObjectTypeFactory::MakePlayer()
+                   : ObjectTypeFactory::MakeEnemy(),
+        FCircle{{coordinate(gen), coordinate(gen)}, size(gen)}));
+  }
+  for (int i = 0; i < kStaticObjects; ++i) {
+    objects.push_back(std::make_unique<StaticObject>(
+        ObjectTypeFactory::MakeEnemy(),
+        StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                       .should_draw_hit_box = false},
+        FRectangle{.top_left = {coordinate(gen), coordinate(gen)},
+                   .width = size(gen),
+                   .height = size(gen)}));
+  }
+  return objects;
+}
+
+// Average milliseconds per frame of detecting every collision.
+double MeasureFrame(absl::Span<Object* const> objects,
+                    internal::JobSystem& jobs, const int frames,
+                    size_t& num_contacts) {
+  ContactList contacts;
+  // Warm up, so that scratch buffers are allocated before measuring.
+  contacts.DetectAll(objects, &jobs);
+  const auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; ++frame) {
+    contacts.Clear();
+    contacts.DetectAll(objects, &jobs);
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  num_contacts = contacts.contacts().size();
+  return elapsed.count() / frames;
+}
+
+void Run() {
+  const std::list<std::unique_ptr<Object>> owned_objects = MakeObjects();
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(BroadphaseType::kSpatialHashGrid);
+  std::vector<Object*> objects;
+  for (const auto& object : owned_objects) {
+    index->Add(*object);
+    objects.push_back(object.get());
+  }
+
+  const int frames = absl::GetFlag(FLAGS_frames);
+  std::printf("%zu objects, %d frames\n", objects.size(), frames);
+  std::printf("%8s %12s %10s %10s\n", "threads", "ms/frame", "speedup",
+              "contacts");
+  double single_thread_ms = 0;
+  for (int threads = 1; threads <= absl::GetFlag(FLAGS_max_threads);
+       ++threads) {
+    internal::JobSystem jobs(threads);
+    size_t num_contacts = 0;
+    const double ms = MeasureFrame(objects, jobs, frames, num_contacts);
+    if (threads == 1) {
+      single_thread_ms = ms;
+    }
+    std::printf("%8d %12.3f %9.2fx %10zu\n", threads, ms,
+                single_thread_ms / ms, num_contacts);
+  }
+}
+
+}  // namespace
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  lib::api::objects::Run();
+
+  return 0;
+}
@@ -0,0 +1,333 @@
+#include "lib/api/objects/contact_list.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/movable_object.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/internal/job_system.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+class DummyMovableObject : public MovableObject {
+ public:
+  DummyMovableObject(const ObjectType type, const HitBoxVariant& hit_box,
+                     const bool changes_state = false)
+      : MovableObject(type,
+                      MovableObjectOpts{.is_hit_box_active = true,
+                                        .should_draw_hit_box = false,
+                                        .attach_camera = false,
+                                        .velocity = 5},
+                      hit_box),
+        changes_state_(changes_state) {}
+
+  bool OnCollisionCallback(Object& other_object) override {
+    collided_with.push_back(&other_object);
+    return changes_state_;
+  }
+
+  std::vector<Object*> collided_with;
+
+ private:
+  const bool changes_state_;
+};
+
+// Deletes every object it collides with, like a ball destroying a brick.
+class DestroyingObject : public DummyMovableObject {
+ public:
+  explicit DestroyingObject(const HitBoxVariant& hit_box)
+      : DummyMovableObject(ObjectTypeFactory::MakePlayer(), hit_box) {}
+
+  bool OnCollisionCallback(Object& other_object) override {
+    other_object.set_deleted(true);
+    return DummyMovableObject::OnCollisionCallback(other_object);
+  }
+};
+
+std::unique_ptr<StaticObject> MakeStaticObject(const ObjectType type,
+                                               const HitBoxVariant& hit_box) {
+  return std::make_unique<StaticObject>(
+      type,
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      hit_box);
+}
+
+// What the objects are passed to the contact list as.
+std::vector<Object*> Pointers(
+    const std::list<std::unique_ptr<Object>>& objects) {
+  std::vector<Object*> pointers;
+  for (const auto& object : objects) {
+    pointers.push_back(object.get());
+  }
+  return pointers;
+}
+
+bool TypePairLess(const Contact& a, const Contact& b) {
+  if (a.type == b.type) {
+    return a.other_type < b.other_type;
+  }
+  return a.type < b.type;
+}
+
+std::vector<std::pair<Object*, Object*>> ContactPairs(
+    const ContactList& contacts) {
+  std::vector<std::pair<Object*, Object*>> pairs;
+  for (const Contact& contact : contacts.contacts()) {
+    pairs.emplace_back(contact.object, contact.other);
+  }
+  return pairs;
+}
+
+TEST(ContactListTest, DetectDoesNotChangeObjects) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5},
+      /*changes_state=*/true));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  auto* movable = static_cast<DummyMovableObject*>(objects.front().get());
+  ContactList contacts;
+
+  contacts.Detect(*movable, Pointers(objects));
+
+  ASSERT_EQ(contacts.contacts().size(), 1);
+  EXPECT_EQ(contacts.contacts()[0].object, movable);
+  EXPECT_EQ(contacts.contacts()[0].other, objects.back().get());
+  EXPECT_TRUE(contacts.contacts()[0].type.IsPlayer());
+  EXPECT_TRUE(contacts.contacts()[0].other_type.IsEnemy());
+  EXPECT_THAT(movable->collided_with, IsEmpty());
+  EXPECT_FALSE(movable->deleted());
+}
+
+TEST(ContactListTest, StaticObjectsDoNotDetect) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5}));
+  ContactList contacts;
+
+  contacts.Detect(*objects.front(), Pointers(objects));
+
+  EXPECT_THAT(contacts.contacts(), IsEmpty());
+}
+
+TEST(ContactListTest, DispatchSortsByTypePair) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakeEnemy(), FCircle{{0, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeButton(), FPoint{1, 1}));
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{1, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeButton(), FPoint{0, 1}));
+  auto* enemy = static_cast<DummyMovableObject*>(objects.front().get());
+  Object* first_button = std::next(objects.begin())->get();
+  auto* player =
+      static_cast<DummyMovableObject*>(std::next(objects.begin(), 2)->get());
+  Object* second_button = objects.back().get();
+  ContactList contacts;
+  for (const auto& object : objects) {
+    contacts.Detect(*object, Pointers(objects));
+  }
+
+  contacts.Dispatch();
+
+  EXPECT_EQ(contacts.contacts().size(), 6);
+  EXPECT_TRUE(std::ranges::is_sorted(contacts.contacts(), TypePairLess));
+  EXPECT_THAT(enemy->collided_with,
+              ElementsAre(player, first_button, second_button));
+  EXPECT_THAT(player->collided_with,
+              ElementsAre(enemy, first_button, second_button));
+}
+
+TEST(ContactListTest, DispatchStopsAfterStateChange) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5},
+      /*changes_state=*/true));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{0, 1}));
+  auto* movable = static_cast<DummyMovableObject*>(objects.front().get());
+  movable->SetDirectionGlobal(1, 0);
+  movable->Update(Pointers(objects));
+  ContactList contacts;
+  contacts.Detect(*movable, Pointers(objects));
+
+  contacts.Dispatch();
+
+  EXPECT_THAT(movable->collided_with,
+              ElementsAre(std::next(objects.begin())->get()));
+  EXPECT_EQ(movable->center(), (WorldPosition{.x = 0, .y = 0}));
+}
+
+TEST(ContactListTest, DispatchSkipsDeletedObjects) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  auto* movable = static_cast<DummyMovableObject*>(objects.front().get());
+  ContactList contacts;
+  contacts.Detect(*movable, Pointers(objects));
+  movable->set_deleted(true);
+
+  contacts.Dispatch();
+
+  EXPECT_THAT(movable->collided_with, IsEmpty());
+}
+
+TEST(ContactListTest, DispatchSkipsObjectsDeletedByEarlierCallback) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DestroyingObject>(FCircle{{0, 0}, 5}));
+  objects.push_back(std::make_unique<DestroyingObject>(FCircle{{2, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  auto* first = static_cast<DestroyingObject*>(objects.front().get());
+  auto* second =
+      static_cast<DestroyingObject*>(std::next(objects.begin())->get());
+  Object* brick = objects.back().get();
+  ContactList contacts;
+  contacts.Detect(*first, {brick});
+  contacts.Detect(*second, {brick});
+
+  contacts.Dispatch();
+
+  EXPECT_TRUE(brick->deleted());
+  EXPECT_THAT(first->collided_with, ElementsAre(brick));
+  // The brick was deleted by the callback of `first`.
+  EXPECT_THAT(second->collided_with, IsEmpty());
+}
+
+TEST(ContactListTest, DetectAllMatchesDetect) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> coordinate(0, 200);
+  std::list<std::unique_ptr<Object>> objects;
+  for (int i = 0; i < 300; ++i) {
+    const FPoint center{static_cast<float>(coordinate(gen)),
+                        static_cast<float>(coordinate(gen))};
+    if (i % 5 == 0) {
+      objects.push_back(
+          MakeStaticObject(ObjectTypeFactory::MakeEnemy(), center));
+    } else {
+      objects.push_back(std::make_unique<DummyMovableObject>(
+          i % 2 == 0 ? ObjectTypeFactory::MakePlayer()
+                     : ObjectTypeFactory::MakeEnemy(),
+          FCircle{center, 6}));
+    }
+  }
+  ContactList each_object;
+  for (const auto& object : objects) {
+    each_object.Detect(*object, Pointers(objects));
+  }
+  ASSERT_THAT(each_object.contacts(), Not(IsEmpty()));
+
+  ContactList all;
+  all.DetectAll(Pointers(objects));
+
+  EXPECT_THAT(ContactPairs(all), ElementsAreArray(ContactPairs(each_object)));
+}
+
+TEST(ContactListTest, DetectAllFindsBothSidesOfPair) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5}));
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakeEnemy(), FCircle{{3, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{-2, 0}));
+  Object* player = objects.front().get();
+  Object* enemy = std::next(objects.begin())->get();
+  Object* wall = objects.back().get();
+  ContactList contacts;
+
+  contacts.DetectAll(Pointers(objects));
+
+  EXPECT_THAT(ContactPairs(contacts),
+              ElementsAre(std::pair(player, enemy), std::pair(player, wall),
+                          std::pair(enemy, player), std::pair(enemy, wall)));
+  // The player and the enemy are only compared once.
+  EXPECT_EQ(contacts.hit_box_tests(), 3);
+}
+
+TEST(ContactListTest, DetectAllInParallelMatchesSequential) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> coordinate(0, 400);
+  std::list<std::unique_ptr<Object>> objects;
+  for (int i = 0; i < 1000; ++i) {
+    const FPoint center{static_cast<float>(coordinate(gen)),
+                        static_cast<float>(coordinate(gen))};
+    if (i % 4 == 0) {
+      objects.push_back(
+          MakeStaticObject(ObjectTypeFactory::MakeEnemy(), center));
+    } else {
+      objects.push_back(std::make_unique<DummyMovableObject>(
+          i % 2 == 0 ? ObjectTypeFactory::MakePlayer()
+                     : ObjectTypeFactory::MakeEnemy(),
+          FCircle{center, 6}));
+    }
+  }
+  const std::unique_ptr<BroadphaseCollisionIndex> index =
+      BroadphaseCollisionIndex::Create(BroadphaseType::kSpatialHashGrid);
+  for (const auto& object : objects) {
+    index->Add(*object);
+  }
+  ContactList sequential;
+  sequential.DetectAll(Pointers(objects));
+  ASSERT_THAT(sequential.contacts(), Not(IsEmpty()));
+
+  for (const int num_threads : {1, 2, 3, 8}) {
+    internal::JobSystem jobs(num_threads);
+    ContactList parallel;
+
+    parallel.DetectAll(Pointers(objects), &jobs);
+
+    EXPECT_THAT(ContactPairs(parallel),
+                ElementsAreArray(ContactPairs(sequential)))
+        << num_threads;
+    EXPECT_EQ(parallel.hit_box_tests(), sequential.hit_box_tests())
+        << num_threads;
+  }
+}
+
+TEST(ContactListTest, Clear) {
+  std::list<std::unique_ptr<Object>> objects;
+  objects.push_back(std::make_unique<DummyMovableObject>(
+      ObjectTypeFactory::MakePlayer(), FCircle{{0, 0}, 5}));
+  objects.push_back(
+      MakeStaticObject(ObjectTypeFactory::MakeEnemy(), FPoint{1, 1}));
+  ContactList contacts;
+  contacts.Detect(*objects.front(), Pointers(objects));
+
+  contacts.Clear();
+
+  EXPECT_THAT(contacts.contacts(), IsEmpty());
+}
+
+}  // namespace
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
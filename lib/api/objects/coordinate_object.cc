@@ -2,18 +2,74 @@
 
 #include "lib/api/objects/coordinate_object.h"
 
-#include <list>
 #include <string>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
+#include "lib/api/render_snapshot.h"
 
 namespace lib {
 namespace api {
 namespace objects {
 
+namespace {
+
+void DrawX(const WorldPosition screen_top_left_pos, const float screen_width,
+           const float screen_height) {
+  float increment = 0;
+  while (increment < screen_height) {
+    DrawText(
+        std::to_string(static_cast<int>(screen_top_left_pos.y + increment))
+            .c_str(),
+        /*posX=*/
+        static_cast<int>(screen_top_left_pos.x - kAxisOffset +
+                         kNumbersOffsetY),
+        /*posY=*/static_cast<int>(screen_top_left_pos.y + increment),
+        /*fontSize=*/kFontSize,
+        /*color=*/BLACK);
+    if (increment != 0) {
+      DrawLineEx(
+          Vector2(screen_top_left_pos.x, screen_top_left_pos.y + increment),
+          Vector2(screen_top_left_pos.x + screen_width,
+                  screen_top_left_pos.y + increment),
+          /*thick=*/3.0f, BLACK);
+    }
+
+    increment += kDistanceBetweenGrid;
+  }
+}
+
+void DrawY(const WorldPosition screen_top_left_pos, const float screen_width,
+           const float screen_height) {
+  float increment = 0;
+  while (increment < screen_width) {
+    DrawText(
+        std::to_string(static_cast<int>(screen_top_left_pos.x + increment))
+            .c_str(),
+        /*posX=*/static_cast<int>(screen_top_left_pos.x + increment),
+        /*posY=*/
+        static_cast<int>(screen_top_left_pos.y - kAxisOffset +
+                         kNumbersOffsetX),
+        /*fontSize=*/
+        kFontSize,
+        /*color=*/BLACK);
+    if (increment != 0) {
+      DrawLineEx(
+          Vector2(screen_top_left_pos.x + increment, screen_top_left_pos.y),
+          Vector2(screen_top_left_pos.x + increment,
+                  screen_top_left_pos.y + screen_height),
+          /*thick=*/3.0f, BLACK);
+    }
+
+    increment += kDistanceBetweenGrid;
+  }
+}
+
+}  // namespace
+
 std::unique_ptr<CoordinateObject> CoordinateObject::MakeX(
     const float screen_width, const float screen_height) {
   return absl::WrapUnique(new CoordinateObject(
@@ -45,68 +101,22 @@ CoordinateObject::CoordinateObject(const ScreenPosition screen_position_start,
       screen_width_(screen_width),
       screen_height_(screen_height) {}
 
-void CoordinateObject::Update(
-    const std::list<std::unique_ptr<Object>>& other_objects) {}
+void CoordinateObject::Update(absl::Span<Object* const> other_objects) {}
 bool CoordinateObject::OnCollisionCallback(Object& other_object) {
   return false;
 }
 
-void CoordinateObject::DrawX() const {
-  float increment = 0;
-  while (increment < screen_height_) {
-    DrawText(
-        std::to_string(static_cast<int>(screen_top_left_pos_.y + increment))
-            .c_str(),
-        /*posX=*/
-        static_cast<int>(screen_top_left_pos_.x - kAxisOffset +
-                         kNumbersOffsetY),
-        /*posY=*/static_cast<int>(screen_top_left_pos_.y + increment),
-        /*fontSize=*/kFontSize,
-        /*color=*/BLACK);
-    if (increment != 0) {
-      DrawLineEx(
-          Vector2(screen_top_left_pos_.x, screen_top_left_pos_.y + increment),
-          Vector2(screen_top_left_pos_.x + screen_width_,
-                  screen_top_left_pos_.y + increment),
-          /*thick=*/3.0f, BLACK);
-    }
-
-    increment += kDistanceBetweenGrid;
-  }
-}
-
-void CoordinateObject::DrawY() const {
-  float increment = 0;
-  while (increment < screen_width_) {
-    DrawText(
-        std::to_string(static_cast<int>(screen_top_left_pos_.x + increment))
-            .c_str(),
-        /*posX=*/static_cast<int>(screen_top_left_pos_.x + increment),
-        /*posY=*/
-        static_cast<int>(screen_top_left_pos_.y - kAxisOffset +
-                         kNumbersOffsetX),
-        /*fontSize=*/
-        kFontSize,
-        /*color=*/BLACK);
-    if (increment != 0) {
-      DrawLineEx(
-          Vector2(screen_top_left_pos_.x + increment, screen_top_left_pos_.y),
-          Vector2(screen_top_left_pos_.x + increment,
-                  screen_top_left_pos_.y + screen_height_),
-          /*thick=*/3.0f, BLACK);
-    }
-
-    increment += kDistanceBetweenGrid;
-  }
-}
-
-void CoordinateObject::Draw() const {
-  hit_box().Draw();
-  if (is_x_axis_) {
-    DrawX();
-    return;
-  }
-  DrawY();
+void CoordinateObject::AddToSnapshot(RenderSnapshot& snapshot) const {
+  snapshot.SetCustomDraw(
+      AddItemToSnapshot(snapshot),
+      [is_x_axis = is_x_axis_, screen_top_left_pos = screen_top_left_pos_,
+       screen_width = screen_width_, screen_height = screen_height_]() {
+        if (is_x_axis) {
+          DrawX(screen_top_left_pos, screen_width, screen_height);
+          return;
+        }
+        DrawY(screen_top_left_pos, screen_width, screen_height);
+      });
 }
 
 void CoordinateObject::ReAdjustToScreen(const WorldPosition screen_top_left_pos,
@@ -118,15 +128,13 @@ void CoordinateObject::ReAdjustToScreen(const WorldPosition screen_top_left_pos,
                           screen_top_left_pos.y + kAxisOffset};
 
   if (is_x_axis_) {
-    mutable_hit_box().Move(
-        screen_width_ / 2 + screen_top_left_pos_.x - center().x,
-        screen_top_left_pos_.y - center().y);
+    MoveHitBox(screen_width_ / 2 + screen_top_left_pos_.x - center().x,
+               screen_top_left_pos_.y - center().y);
     return;
   }
 
-  mutable_hit_box().Move(
-      screen_top_left_pos_.x - center().x,
-      screen_top_left_pos_.y + screen_height_ / 2 - center().y);
+  MoveHitBox(screen_top_left_pos_.x - center().x,
+             screen_top_left_pos_.y + screen_height_ / 2 - center().y);
 }
 
 }  // namespace objects
@@ -1,11 +1,12 @@
 #ifndef LIB_API_OBJECTS_COORDINATE_OBJECT_H
 #define LIB_API_OBJECTS_COORDINATE_OBJECT_H
 
-#include <list>
 #include <memory>
 
+#include "absl/types/span.h"
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object.h"
+#include "lib/api/render_snapshot.h"
 
 namespace lib {
 namespace api {
@@ -27,7 +28,8 @@ class CoordinateObject : public Object {
   void ReAdjustToScreen(WorldPosition screen_top_left_pos, float screen_width,
                         float screen_height);
 
-  void Update(const std::list<std::unique_ptr<Object>>& other_objects) override;
+  void Update(absl::Span<Object* const> other_objects) override;
+  void AddToSnapshot(RenderSnapshot& snapshot) const override;
 
  private:
   CoordinateObject(ScreenPosition screen_position_start,
@@ -35,9 +37,6 @@ class CoordinateObject : public Object {
                    float screen_height, bool is_x_axis);
 
   bool OnCollisionCallback(Object& other_object) override;
-  void Draw() const override;
-  void DrawX() const;
-  void DrawY() const;
 
   bool is_x_axis_;
   WorldPosition screen_top_left_pos_;
@@ -1,6 +1,5 @@
 #include "lib/api/objects/coordinate_object.h"
 
-#include <list>
 #include <memory>
 
 #include "gmock/gmock-matchers.h"
@@ -46,13 +45,11 @@ TEST(CoordinateObjectTest, UpdateDoesNothing) {
       CoordinateObject::MakeX(/*screen_width*/ 10, /*screen_height=*/20);
   const std::unique_ptr<CoordinateObject> y_object =
       CoordinateObject::MakeY(/*screen_width*/ 10, /*screen_height=*/20);
-  std::unique_ptr<CoordinateObject> dummy_object =
+  const std::unique_ptr<CoordinateObject> dummy_object =
       CoordinateObject::MakeX(/*screen_width*/ 30, /*screen_height=*/20);
-  std::list<std::unique_ptr<Object>> objs;
-  objs.push_back(std::move(dummy_object));
 
-  x_object->Update(objs);
-  y_object->Update(objs);
+  x_object->Update({dummy_object.get()});
+  y_object->Update({dummy_object.get()});
 
   EXPECT_EQ(x_object->center(), (WorldPosition{.x = 5.0, .y = kAxisOffset}));
   EXPECT_EQ(y_object->center(), (WorldPosition{.x = kAxisOffset, .y = 10.0}));
@@ -1,9 +1,10 @@
 #include "lib/api/objects/movable_object.h"
 
-#include <list>
 #include <memory>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/sprites/sprite_instance.h"
@@ -25,7 +26,24 @@ MovableObject::MovableObject(
              hit_box, std::move(sprite_instance)),
       velocity_(options.velocity) {}
 
+void MovableObject::Reset(
+    const ObjectType type, const MovableObjectOpts& options,
+    const HitBoxVariant& hit_box,
+    std::unique_ptr<sprites::SpriteInstance> sprite_instance) {
+  Object::Reset(type,
+                {.is_hit_box_active = options.is_hit_box_active,
+                 .should_draw_hit_box = options.should_draw_hit_box},
+                hit_box, std::move(sprite_instance));
+  velocity_ = options.velocity;
+  direction_x_ = 0;
+  direction_y_ = 0;
+  last_direction_x_ = 0;
+  last_direction_y_ = 0;
+  frozen_until_next_set_direction_ = false;
+}
+
 void MovableObject::SetDirectionGlobal(const float x, const float y) {
+  Wake();
   frozen_until_next_set_direction_ = false;
   const Vector v = Vector{x, y};
   if (v.IsZero()) {
@@ -39,6 +57,7 @@ void MovableObject::SetDirectionGlobal(const float x, const float y) {
 }
 
 void MovableObject::SetDirectionRelative(const float x, const float y) {
+  Wake();
   frozen_until_next_set_direction_ = false;
   const WorldPosition world_position = center();
   const Vector v = Vector{x - world_position.x, y - world_position.y};
@@ -58,21 +77,15 @@ void MovableObject::Move() {
   }
   last_direction_x_ = direction_x_;
   last_direction_y_ = direction_y_;
-  this->mutable_hit_box().Move(velocity_ * direction_x_,
-                               velocity_ * direction_y_);
+  MoveHitBox(velocity_ * direction_x_, velocity_ * direction_y_);
 }
 
 void MovableObject::ResetLastMove() {
-  this->mutable_hit_box().Move(-last_direction_x_ * velocity_,
-                               -last_direction_y_ * velocity_);
+  MoveHitBox(-last_direction_x_ * velocity_, -last_direction_y_ * velocity_);
 }
 
-void MovableObject::Update(
-    const std::list<std::unique_ptr<Object>>& other_objects) {
+void MovableObject::Update(absl::Span<Object* const> other_objects) {
   Move();
-  if (UpdateInternal(other_objects)) {
-    this->ResetLastMove();
-  }
 }
 
 // TODO(f1lo): This never returns true?
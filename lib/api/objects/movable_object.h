@@ -1,9 +1,9 @@
 #ifndef LIB_API_OBJECTS_MOVABLE_OBJECT_H
 #define LIB_API_OBJECTS_MOVABLE_OBJECT_H
 
-#include <list>
 #include <memory>
 
+#include "absl/types/span.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/sprites/sprite_instance.h"
@@ -26,21 +26,32 @@ class MovableObject : public Object {
       const HitBoxVariant& hit_box,
       std::unique_ptr<sprites::SpriteInstance> sprite_instance = nullptr);
 
-  void Update(const std::list<std::unique_ptr<Object>>& other_objects) override;
+  void Update(absl::Span<Object* const> other_objects) override;
 
-  void set_velocity(const float velocity) { velocity_ = velocity; }
+  void set_velocity(const float velocity) {
+    Wake();
+    velocity_ = velocity;
+  }
   void freeze_until_next_set_direction() {
     frozen_until_next_set_direction_ = true;
   }
   [[nodiscard]] float velocity() const { return velocity_; }
+  // Setting the direction wakes the object up.
   void SetDirectionGlobal(float x, float y);
   void SetDirectionRelative(float x, float y);
   [[nodiscard]] float direction_x() const { return direction_x_; }
   [[nodiscard]] float direction_y() const { return direction_y_; }
 
  protected:
+  // See `Object::Reset`.
+  void Reset(ObjectType type, const MovableObjectOpts& options,
+             const HitBoxVariant& hit_box,
+             std::unique_ptr<sprites::SpriteInstance> sprite_instance);
   virtual void Move();
   virtual void ResetLastMove();
+  // Steps back, so that the object does not end up inside the one it has
+  // collided with.
+  void OnStateChangingCollision() override { ResetLastMove(); }
 
  private:
   [[nodiscard]] bool IsFrozen() const;
@@ -1,7 +1,5 @@
 #include "lib/api/objects/movable_object.h"
 
-#include <list>
-#include <memory>
 
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -53,6 +51,19 @@ TEST(MovableObjectTest, SetDirectionRelative) {
   EXPECT_FLOAT_EQ(movable_object.direction_y(), 1.0f);
 }
 
+TEST(MovableObjectTest, SetDirectionWakes) {
+  DummyMovableObject movable_object = DummyMovableObject(
+      /*velocity=*/5, /*hit_box=*/FPoint{1, 2});
+  movable_object.CountFrameAtRest(/*frames_to_sleep=*/1);
+  ASSERT_TRUE(movable_object.asleep());
+
+  movable_object.SetDirectionGlobal(0, 0);
+  EXPECT_FALSE(movable_object.asleep());
+  movable_object.CountFrameAtRest(/*frames_to_sleep=*/1);
+  movable_object.SetDirectionRelative(1, 4);
+  EXPECT_FALSE(movable_object.asleep());
+}
+
 TEST(MovableObjectTest, Move) {
   DummyMovableObject movable_object = DummyMovableObject(
       /*velocity=*/5, /*hit_box=*/FPoint{1, 2});
@@ -116,18 +127,30 @@ TEST(MovableObjectTest, NoDirectionSet) {
   EXPECT_EQ(movable_object.center(), (WorldPosition{.x = 0, .y = 1}));
 }
 
-TEST(MovableObjectTest, UpdateWorks) {
+TEST(MovableObjectTest, UpdateOnlyMoves) {
   DummyMovableObject movable_object_1 = DummyMovableObject(
       /*velocity=*/5, FLine{.a = {1, 0}, .b = {5, 0}});
-  std::unique_ptr<DummyMovableObject> movable_object_2 =
-      std::make_unique<DummyMovableObject>(
-          /*velocity=*/5, FLine{.a = {2, -1}, .b = {4, 2}});
-  std::list<std::unique_ptr<Object>> objs;
-  objs.push_back(std::move(movable_object_2));
+  DummyMovableObject movable_object_2 = DummyMovableObject(
+      /*velocity=*/5, FLine{.a = {2, -1}, .b = {4, 2}});
+  movable_object_1.SetDirectionGlobal(0, 1);
 
-  movable_object_1.Update(objs);
+  movable_object_1.Update({&movable_object_2});
+
+  EXPECT_EQ(movable_object_1.center(), (WorldPosition{.x = 3, .y = 5}));
+  EXPECT_FALSE(movable_object_1.deleted());
+}
+
+TEST(MovableObjectTest, StateChangingCollisionResetsLastMove) {
+  DummyMovableObject movable_object_1 = DummyMovableObject(
+      /*velocity=*/5, FLine{.a = {1, 0}, .b = {5, 0}});
+  DummyMovableObject movable_object_2 = DummyMovableObject(
+      /*velocity=*/5, FLine{.a = {2, 4}, .b = {4, 6}});
+  movable_object_1.SetDirectionGlobal(0, 1);
+  movable_object_1.Update({});
 
+  EXPECT_TRUE(movable_object_1.ResolveCollision(movable_object_2));
   EXPECT_TRUE(movable_object_1.deleted());
+  EXPECT_EQ(movable_object_1.center(), (WorldPosition{.x = 3, .y = 0}));
 }
 
 }  // namespace
@@ -1,10 +1,18 @@
 #include "lib/api/objects/object.h"
 
-#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
 
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "absl/types/span.h"
 #include "lib/api/common_types.h"
+#include "lib/api/objects/collision_index.h"
 #include "lib/api/objects/object_type.h"
+#include "lib/api/render_snapshot.h"
 #include "lib/api/sprites/sprite_instance.h"
+#include "lib/internal/geometry/ray.h"
 #include "lib/internal/hit_box.h"
 
 namespace lib {
@@ -18,28 +26,68 @@ Object::Object(const ObjectType type, const Opts& options,
                const HitBoxVariant& hit_box,
                std::unique_ptr<sprites::SpriteInstance> sprite_instance)
     : type_(type),
+      collides_with_(kAllLayers),
       deleted_(false),
       clicked_(false),
+      asleep_(false),
+      frames_at_rest_(0),
       is_hit_box_active_(options.is_hit_box_active),
       should_draw_hit_box_(options.should_draw_hit_box),
       hit_box_(std::visit(
           [](auto&& hit_box_variant) -> HitBox {
             return HitBox::CreateHitBox(hit_box_variant);
           },
-          hit_box)) {
+          hit_box)),
+      previous_center_(center()),
+      collision_index_(nullptr) {
   if (sprite_instance) {
     active_sprite_instance_ = std::move(sprite_instance);
   }
 }
 
+void Object::Reset(const ObjectType type, const Opts& options,
+                   const HitBoxVariant& hit_box,
+                   std::unique_ptr<sprites::SpriteInstance> sprite_instance) {
+  CHECK(collision_index_ == nullptr)
+      << "Object has to be removed from the collision index before reset.";
+  type_ = type;
+  collides_with_ = kAllLayers;
+  deleted_ = false;
+  clicked_ = false;
+  asleep_ = false;
+  frames_at_rest_ = 0;
+  is_hit_box_active_ = options.is_hit_box_active;
+  should_draw_hit_box_ = options.should_draw_hit_box;
+  hit_box_ = std::visit(
+      [](auto&& hit_box_variant) -> HitBox {
+        return HitBox::CreateHitBox(hit_box_variant);
+      },
+      hit_box);
+  previous_center_ = center();
+  active_sprite_instance_ = std::move(sprite_instance);
+  index_update_pending_ = false;
+}
+
 void Object::Draw() const {
+  RenderSnapshot snapshot;
+  AddToSnapshot(snapshot);
+  snapshot.Draw();
+}
+
+void Object::AddToSnapshot(RenderSnapshot& snapshot) const {
+  AddItemToSnapshot(snapshot);
+}
+
+RenderItem& Object::AddItemToSnapshot(RenderSnapshot& snapshot) const {
+  RenderItem& item = snapshot.Add(YBase(), previous_center_, center());
   if (active_sprite_instance_) {
-    active_sprite_instance_->Draw(center());
+    item.sprite = active_sprite_instance_->sprite();
+    item.frame = active_sprite_instance_->AdvanceFrame();
   }
-
   if (should_draw_hit_box()) {
-    hit_box().Draw();
+    item.hit_box = hit_box();
   }
+  return item;
 }
 
 bool Object::CollidesWith(const Object& other) const {
@@ -54,6 +102,42 @@ bool Object::CollidesWith(const Object& other) const {
   return hit_box_.CollidesWith(other.hit_box_);
 }
 
+bool Object::CollidesWith(const internal::HitBox& hit_box) const {
+  if (deleted() || !is_hit_box_active()) {
+    return false;
+  }
+
+  return hit_box_.CollidesWith(hit_box);
+}
+
+std::optional<internal::RayHit> Object::Raycast(
+    const internal::Ray& ray) const {
+  if (deleted() || !is_hit_box_active()) {
+    return std::nullopt;
+  }
+
+  return hit_box_.Raycast(ray);
+}
+
+std::optional<internal::RayHit> Object::CircleCast(const internal::Ray& ray,
+                                                   const float radius) const {
+  if (deleted() || !is_hit_box_active()) {
+    return std::nullopt;
+  }
+
+  return hit_box_.CircleCast(ray, radius);
+}
+
+std::optional<internal::RayHit> Object::BoxCast(
+    const internal::Ray& ray, const float half_width,
+    const float half_height) const {
+  if (deleted() || !is_hit_box_active()) {
+    return std::nullopt;
+  }
+
+  return hit_box_.BoxCast(ray, half_width, half_height);
+}
+
 std::pair<float, float> Object::Reflect(const Object& other, float x,
                                         float y) const {
   // Hitbox not present or object deleted.
@@ -64,24 +148,109 @@ std::pair<float, float> Object::Reflect(const Object& other, float x,
   return hit_box_.Reflect(other.hit_box_, x, y);
 }
 
-bool Object::UpdateInternal(
-    const std::list<std::unique_ptr<Object>>& other_objects) {
-  for (const auto& other_object : other_objects) {
-    // Skip for the same object.
-    if (this == other_object.get()) {
-      continue;
-    }
-    // No collision - skip.
-    if (!this->CollidesWith(*other_object.get())) {
-      continue;
-    }
-    // Exit after first collision which changes the object state.
-    if (this->OnCollisionCallback(*other_object.get())) {
-      return true;
+std::pair<float, float> Object::Reflect(const internal::HitBox& hit_box,
+                                        const float x, const float y) const {
+  if (deleted() || !is_hit_box_active()) {
+    return {x, y};
+  }
+
+  return hit_box_.Reflect(hit_box, x, y);
+}
+
+void Object::ForEachCollision(
+    absl::Span<Object* const> other_objects,
+    const absl::FunctionRef<void(Object&)> callback) const {
+  if (!LooksForCollisions()) {
+    return;
+  }
+
+  ForEachCandidate(other_objects, [this, callback](Object& other_object) {
+    if (LooksForCollisionsWith(other_object) &&
+        this->CollidesWith(other_object)) {
+      callback(other_object);
     }
+  });
+}
+
+void Object::ForEachCandidate(
+    absl::Span<Object* const> other_objects,
+    const absl::FunctionRef<void(Object&)> callback) const {
+  // Candidates of the index are visited in the order they were added to it,
+  // which matches `other_objects` until the level erases an object.
+  if (collision_index_ != nullptr) {
+    collision_index_->ForEachCandidate(*this, [callback](Object& candidate) {
+      callback(candidate);
+      return false;
+    });
+    return;
+  }
+  for (Object* other_object : other_objects) {
+    callback(*other_object);
+  }
+}
+
+bool Object::LooksForCollisions() const {
+  // Hitbox not present or object deleted - nothing can collide.
+  if (deleted() || !is_hit_box_active()) {
+    return false;
+  }
+  // Sleeping objects wait for an awake object to run into them.
+  if (asleep()) {
+    return false;
+  }
+
+  return !IsStatic() && collides_with_ != LayerMask{0};
+}
+
+bool Object::LooksForCollisionsWith(const Object& other) const {
+  // Filtered out by collision layers - skip without touching the geometry.
+  return this != &other && LooksForCollisions() &&
+         other.type().IsIn(collides_with_);
+}
+
+bool Object::ResolveCollision(Object& other_object) {
+  if (!OnCollisionCallback(other_object)) {
+    return false;
   }
+  OnStateChangingCollision();
+  return true;
+}
+
+void Object::CountFrameAtRest(const int frames_to_sleep) {
+  if (++frames_at_rest_ >= frames_to_sleep) {
+    asleep_ = true;
+  }
+}
+
+void Object::MoveHitBox(const float x, const float y) {
+  hit_box_.Move(x, y);
+  if (x != 0 || y != 0) {
+    Wake();
+  }
+  if (collision_index_ == nullptr) {
+    return;
+  }
+  if (collision_index_->defers_updates()) {
+    index_update_pending_ = true;
+    return;
+  }
+  collision_index_->Update(*this);
+}
+
+void Object::FlushCollisionIndexUpdate() {
+  if (!index_update_pending_) {
+    return;
+  }
+  index_update_pending_ = false;
+  if (collision_index_ != nullptr) {
+    collision_index_->Update(*this);
+  }
+}
 
-  return false;
+WorldPosition Object::InterpolatedCenter(const float alpha) const {
+  const WorldPosition current = center();
+  return {.x = previous_center_.x + (current.x - previous_center_.x) * alpha,
+          .y = previous_center_.y + (current.y - previous_center_.y) * alpha};
 }
 
 int Object::YBase() const {
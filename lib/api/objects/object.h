@@ -1,13 +1,18 @@
 #ifndef LIB_API_OBJECTS_OBJECT_H
 #define LIB_API_OBJECTS_OBJECT_H
 
-#include <list>
 #include <memory>
+#include <optional>
 
 #include "absl/base/nullability.h"
+#include "absl/functional/function_ref.h"
+#include "absl/types/span.h"
 #include "lib/api/common_types.h"
+#include "lib/api/objects/collision_index.h"
 #include "lib/api/objects/object_type.h"
+#include "lib/api/render_snapshot.h"
 #include "lib/api/sprites/sprite_instance.h"
+#include "lib/internal/geometry/ray.h"
 #include "lib/internal/hit_box.h"
 
 namespace lib {
@@ -28,25 +33,104 @@ class Object {
 
   virtual ~Object() = default;
 
-  virtual void Update(
-      const std::list<std::unique_ptr<Object>>& other_objects) = 0;
+  // May run in parallel with `Update` of other objects, so it must only change
+  // this object, keeping in mind that the others may be moving meanwhile.
+  virtual void Update(absl::Span<Object* const> other_objects) = 0;
+  // Draws what `AddToSnapshot` adds.
   virtual void Draw() const;
+  // Adds what the object looks like now, so that it can be drawn while the
+  // object is simulated further. The snapshot must not point back into the
+  // object. Objects drawing more than their sprite and hit box add it with
+  // `RenderSnapshot::SetCustomDraw`.
+  virtual void AddToSnapshot(RenderSnapshot& snapshot) const;
 
   [[nodiscard]] std::pair<float, float> Reflect(const Object& other, float x,
                                                 float y) const;
+  // Reflection of a shape which is not an object, e.g. a hit box of an
+  // `ecs::Collider`.
+  [[nodiscard]] std::pair<float, float> Reflect(
+      const internal::HitBox& hit_box, float x, float y) const;
   [[nodiscard]] bool CollidesWith(const Object& other) const;
+  // Collision with a shape which is not an object, e.g. a query area.
+  [[nodiscard]] bool CollidesWith(const internal::HitBox& hit_box) const;
   [[nodiscard]] int YBase() const;
+  // Collision detection, calls `callback` for every object this object
+  // collides with. Does not change the state of any object.
+  void ForEachCollision(absl::Span<Object* const> other_objects,
+                        absl::FunctionRef<void(Object&)> callback) const;
+  // Calls `callback` for every object this object might collide with, taken
+  // from the collision index when it is set and from `other_objects`
+  // otherwise. Candidates from the index come in the order they were added
+  // to it. Other candidates come in the order of `other_objects`, which
+  // differs once a level has erased objects.
+  void ForEachCandidate(absl::Span<Object* const> other_objects,
+                        absl::FunctionRef<void(Object&)> callback) const;
+  // Whether the object looks for collisions at all. Static objects and objects
+  // which collide with nothing are only ever the passive side of a collision.
+  [[nodiscard]] bool LooksForCollisions() const;
+  // Whether this object looks for collisions with `other`. Only checks the
+  // collision layers, not the geometry.
+  [[nodiscard]] bool LooksForCollisionsWith(const Object& other) const;
+  // Collision response for a collision found by `ForEachCollision`. Returns
+  // true if the collision has changed the state of the object.
+  bool ResolveCollision(Object& other_object);
+  // First hit of a ray, or of a circle or a box moving along the ray, with the
+  // hit box. Deleted objects and inactive hit boxes are never hit.
+  [[nodiscard]] std::optional<internal::RayHit> Raycast(
+      const internal::Ray& ray) const;
+  [[nodiscard]] std::optional<internal::RayHit> CircleCast(
+      const internal::Ray& ray, float radius) const;
+  [[nodiscard]] std::optional<internal::RayHit> BoxCast(
+      const internal::Ray& ray, float half_width, float half_height) const;
+  // Static objects never move and never look for collisions themselves,
+  // other objects can still collide with them.
+  [[nodiscard]] virtual bool IsStatic() const { return false; }
 
   // Object center in the world.
   [[nodiscard]] WorldPosition center() const {
     return {.x = hit_box().center_x(), .y = hit_box().center_y()};
   }
+  // Object center before the last simulation step.
+  [[nodiscard]] WorldPosition previous_center() const {
+    return previous_center_;
+  }
+  // Center between the previous and the current one, `alpha` 0 is the
+  // previous center and 1 the current one. Objects are drawn there when the
+  // frame falls between two simulation steps.
+  [[nodiscard]] WorldPosition InterpolatedCenter(float alpha) const;
+  // Axis aligned box around the hit box, used by the broadphase.
+  [[nodiscard]] internal::Aabb bounding_box() const { return hit_box_.aabb(); }
   [[nodiscard]] ObjectType type() const { return type_; }
+  // Layers of the objects this object can collide with. Other objects are
+  // skipped before any hit box geometry is checked.
+  [[nodiscard]] LayerMask collides_with() const { return collides_with_; }
   [[nodiscard]] bool deleted() const { return deleted_; }
   [[nodiscard]] bool clicked() const { return clicked_; }
+  [[nodiscard]] bool is_hit_box_active() const { return is_hit_box_active_; }
+  // Sleeping objects are not updated and do not look for collisions, awake
+  // objects can still collide with them.
+  [[nodiscard]] bool asleep() const { return asleep_; }
 
   void set_deleted(const bool deleted) { deleted_ = deleted; }
   void set_clicked(const bool clicked) { clicked_ = clicked; }
+  // Called before every simulation step.
+  void SavePreviousCenter() { previous_center_ = center(); }
+  // Wakes the object up and restarts counting the frames it is at rest.
+  void Wake() {
+    asleep_ = false;
+    frames_at_rest_ = 0;
+  }
+  // Called once per frame for awake objects, puts the object to sleep once it
+  // has not moved for `frames_to_sleep` frames in a row.
+  void CountFrameAtRest(int frames_to_sleep);
+  // When set, `ForEachCollision` only checks objects which the index reports
+  // as nearby instead of every object.
+  void set_collision_index(absl::Nullable<CollisionIndex*> collision_index) {
+    collision_index_ = collision_index;
+  }
+  // Updates the collision index if the hit box moved while the index deferred
+  // its updates.
+  void FlushCollisionIndexUpdate();
 
   [[nodiscard]] absl::Nullable<const sprites::SpriteInstance*>
   active_sprite_instance() const {
@@ -54,24 +138,42 @@ class Object {
   }
 
  protected:
-  [[nodiscard]] bool is_hit_box_active() const { return is_hit_box_active_; }
+  // Puts the object into the state the constructor does, for objects reused
+  // by an `ObjectPool`. The object must not be in a collision index.
+  void Reset(ObjectType type, const Opts& options, const HitBoxVariant& hit_box,
+             std::unique_ptr<sprites::SpriteInstance> sprite_instance);
   [[nodiscard]] bool should_draw_hit_box() const {
     return should_draw_hit_box_;
   }
   virtual bool OnCollisionCallback(Object& other_object) = 0;
-  bool UpdateInternal(const std::list<std::unique_ptr<Object>>& other_objects);
+  // Called after `OnCollisionCallback` has changed the object state.
+  virtual void OnStateChangingCollision() {}
 
-  internal::HitBox& mutable_hit_box() { return hit_box_; }
+  void set_collides_with(const LayerMask collides_with) {
+    collides_with_ = collides_with;
+  }
+  // Moves the hit box and keeps the collision index up to date. Any movement
+  // wakes the object up.
+  void MoveHitBox(float x, float y);
+  // Adds the sprite and the hit box, returns the item to add more drawing to.
+  RenderItem& AddItemToSnapshot(RenderSnapshot& snapshot) const;
   [[nodiscard]] const internal::HitBox& hit_box() const { return hit_box_; }
 
  private:
   ObjectType type_;
+  LayerMask collides_with_;
   bool deleted_;
   bool clicked_;
-  const bool is_hit_box_active_;
-  const bool should_draw_hit_box_;
+  bool asleep_;
+  int frames_at_rest_;
+  bool is_hit_box_active_;
+  bool should_draw_hit_box_;
   internal::HitBox hit_box_;
+  WorldPosition previous_center_;
   std::unique_ptr<sprites::SpriteInstance> active_sprite_instance_;
+  absl::Nullable<CollisionIndex*> collision_index_;
+  // The hit box moved since the last update of `collision_index_`.
+  bool index_update_pending_ = false;
 };
 
 }  // namespace objects
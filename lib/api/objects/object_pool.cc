@@ -0,0 +1,24 @@
+#include "lib/api/objects/object_pool.h"
+
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+#include "lib/api/objects/object.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+void ObjectPools::Recycle(std::unique_ptr<Object> object) {
+  const auto it = pools_.find(std::type_index(typeid(*object)));
+  if (it == pools_.end()) {
+    return;
+  }
+  it->second->Recycle(std::move(object));
+}
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,146 @@
+#ifndef LIB_API_OBJECTS_OBJECT_POOL_H
+#define LIB_API_OBJECTS_OBJECT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+#include "lib/api/objects/object.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+struct ObjectPoolStats {
+  // Objects acquired from the free objects.
+  int64_t hits = 0;
+  // Objects acquired while there were no free objects, newly allocated.
+  int64_t misses = 0;
+  // Deleted objects given back to the pool.
+  int64_t recycled = 0;
+  // Objects waiting to be acquired.
+  size_t free_objects = 0;
+};
+
+class ObjectPoolBase {
+ public:
+  virtual ~ObjectPoolBase() = default;
+
+  // Keeps `object` to be acquired again. `object` must have been removed from
+  // the level and its collision index.
+  virtual void Recycle(std::unique_ptr<Object> object) = 0;
+  [[nodiscard]] ObjectPoolStats stats() const {
+    absl::MutexLock lock(&mu_);
+    return stats_;
+  }
+
+ protected:
+  mutable absl::Mutex mu_;
+  ObjectPoolStats stats_ ABSL_GUARDED_BY(mu_);
+};
+
+// Reuses deleted objects of type `T` instead of destroying them and
+// allocating new ones. `T` has to have a `Reset` method which takes the same
+// arguments as one of its constructors and puts the object into the state
+// that constructor would. Thread safe, abilities acquire objects in parallel.
+template <typename T>
+class ObjectPool : public ObjectPoolBase {
+ public:
+  // Allocates `count` free objects up front, constructed from `args`.
+  template <typename... Args>
+  void Prewarm(const size_t count, const Args&... args) {
+    absl::MutexLock lock(&mu_);
+    for (size_t i = 0; i < count; ++i) {
+      free_objects_.push_back(std::make_unique<T>(args...));
+    }
+    stats_.free_objects = free_objects_.size();
+  }
+
+  // Returns a free object reset with `args`, or a new object constructed from
+  // them when there is none.
+  template <typename... Args>
+  [[nodiscard]] std::unique_ptr<T> Acquire(Args&&... args) {
+    std::unique_ptr<T> object;
+    {
+      absl::MutexLock lock(&mu_);
+      if (free_objects_.empty()) {
+        ++stats_.misses;
+      } else {
+        ++stats_.hits;
+        object = std::move(free_objects_.back());
+        free_objects_.pop_back();
+        stats_.free_objects = free_objects_.size();
+      }
+    }
+    if (object == nullptr) {
+      return std::make_unique<T>(std::forward<Args>(args)...);
+    }
+    object->Reset(std::forward<Args>(args)...);
+    return object;
+  }
+
+  void Recycle(std::unique_ptr<Object> object) override {
+    CHECK(typeid(*object) == typeid(T))
+        << "Object of type " << typeid(*object).name()
+        << " recycled into the pool of " << typeid(T).name();
+    absl::MutexLock lock(&mu_);
+    free_objects_.push_back(
+        std::unique_ptr<T>(static_cast<T*>(object.release())));
+    ++stats_.recycled;
+    stats_.free_objects = free_objects_.size();
+  }
+
+ private:
+  std::vector<std::unique_ptr<T>> free_objects_ ABSL_GUARDED_BY(mu_);
+};
+
+// Pools of a level, at most one per object type. Pools are only added while
+// the level is built, afterwards they can be used from several threads.
+class ObjectPools {
+ public:
+  // Returns the existing pool if `T` already has one.
+  template <typename T>
+  ObjectPool<T>& Add() {
+    std::unique_ptr<ObjectPoolBase>& pool = pools_[std::type_index(typeid(T))];
+    if (pool == nullptr) {
+      pool = std::make_unique<ObjectPool<T>>();
+    }
+    return static_cast<ObjectPool<T>&>(*pool);
+  }
+  // Null if `T` has no pool.
+  template <typename T>
+  [[nodiscard]] absl::Nullable<ObjectPool<T>*> Get() {
+    const auto it = pools_.find(std::type_index(typeid(T)));
+    return it == pools_.end() ? nullptr
+                              : static_cast<ObjectPool<T>*>(it->second.get());
+  }
+  template <typename T>
+  [[nodiscard]] absl::Nullable<const ObjectPool<T>*> Get() const {
+    const auto it = pools_.find(std::type_index(typeid(T)));
+    return it == pools_.end()
+               ? nullptr
+               : static_cast<const ObjectPool<T>*>(it->second.get());
+  }
+  // Gives `object` back to the pool of its type, destroys it if there is
+  // none.
+  void Recycle(std::unique_ptr<Object> object);
+  [[nodiscard]] bool empty() const { return pools_.empty(); }
+
+ private:
+  absl::flat_hash_map<std::type_index, std::unique_ptr<ObjectPoolBase>> pools_;
+};
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_OBJECTS_OBJECT_POOL_H
@@ -0,0 +1,105 @@
+#include "lib/api/objects/object_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/projectile_object.h"
+#include "lib/api/objects/static_object.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+namespace {
+
+ProjectileObject::ProjectileObjectOpts MakeOpts(const FPoint center) {
+  return {.should_draw_hit_box = false,
+          .despawn_outside_screen_area = true,
+          .velocity = 2,
+          .hit_box_center = center,
+          .hit_box_radius = 3,
+          .despawn_on_colliding_with_these_objects =
+              MakeLayerMask({ObjectTypeFactory::MakeEnemy()}),
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0};
+}
+
+TEST(ObjectPoolTest, ReusesRecycledObjects) {
+  ObjectPool<ProjectileObject> pool;
+  std::unique_ptr<ProjectileObject> projectile = pool.Acquire(
+      ObjectTypeFactory::MakeProjectilePlayer(), MakeOpts({1, 1}));
+  projectile->SetDirectionGlobal(1, 0);
+  projectile->set_deleted(true);
+  const ProjectileObject* recycled = projectile.get();
+
+  pool.Recycle(std::move(projectile));
+  std::unique_ptr<ProjectileObject> reused = pool.Acquire(
+      ObjectTypeFactory::MakeProjectilePlayer(), MakeOpts({5, 6}));
+
+  EXPECT_EQ(reused.get(), recycled);
+  EXPECT_FALSE(reused->deleted());
+  EXPECT_EQ(reused->center(), (WorldPosition{5, 6}));
+  EXPECT_EQ(reused->previous_center(), (WorldPosition{5, 6}));
+  EXPECT_EQ(reused->direction_x(), 0);
+  EXPECT_EQ(reused->velocity(), 2);
+  EXPECT_EQ(reused->collides_with(),
+            ProjectileObject(ObjectTypeFactory::MakeProjectilePlayer(),
+                             MakeOpts({5, 6}))
+                .collides_with());
+  const ObjectPoolStats stats = pool.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.recycled, 1);
+  EXPECT_EQ(stats.free_objects, 0);
+}
+
+TEST(ObjectPoolTest, Prewarm) {
+  ObjectPool<ProjectileObject> pool;
+
+  pool.Prewarm(3, ObjectTypeFactory::MakeProjectilePlayer(), MakeOpts({}));
+  EXPECT_EQ(pool.stats().free_objects, 3);
+  std::unique_ptr<ProjectileObject> projectile = pool.Acquire(
+      ObjectTypeFactory::MakeProjectilePlayer(), MakeOpts({1, 1}));
+
+  EXPECT_EQ(projectile->center(), (WorldPosition{1, 1}));
+  EXPECT_EQ(pool.stats().hits, 1);
+  EXPECT_EQ(pool.stats().misses, 0);
+  EXPECT_EQ(pool.stats().free_objects, 2);
+}
+
+TEST(ObjectPoolsTest, RecyclesIntoPoolOfDynamicType) {
+  ObjectPools pools;
+  pools.Add<ProjectileObject>();
+  std::unique_ptr<Object> projectile = std::make_unique<ProjectileObject>(
+      ObjectTypeFactory::MakeProjectilePlayer(), MakeOpts({}));
+  std::unique_ptr<Object> wall = std::make_unique<StaticObject>(
+      ObjectTypeFactory::MakeWorldBorder(),
+      StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                     .should_draw_hit_box = false},
+      FLine{.a = {0, 0}, .b = {0, 10}});
+
+  pools.Recycle(std::move(projectile));
+  pools.Recycle(std::move(wall));
+
+  ASSERT_NE(pools.Get<ProjectileObject>(), nullptr);
+  EXPECT_EQ(pools.Get<ProjectileObject>()->stats().recycled, 1);
+  EXPECT_EQ(pools.Get<StaticObject>(), nullptr);
+}
+
+TEST(ObjectPoolDeathTest, RecycleOtherType) {
+  ObjectPool<ProjectileObject> pool;
+
+  EXPECT_DEATH(pool.Recycle(std::make_unique<StaticObject>(
+                   ObjectTypeFactory::MakeWorldBorder(),
+                   StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                                  .should_draw_hit_box = false},
+                   FLine{.a = {0, 0}, .b = {0, 10}})),
+               "recycled into the pool of");
+}
+
+}  // namespace
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
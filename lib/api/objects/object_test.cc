@@ -1,11 +1,14 @@
 #include "lib/api/objects/object.h"
 
-#include <list>
 #include <memory>
+#include <vector>
 
-#include "gmock/gmock-matchers.h"
+#include "absl/functional/function_ref.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "lib/api/common_types.h"
+#include "lib/api/objects/collision_index.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/internal/hit_box.h"
 
@@ -14,21 +17,37 @@ namespace api {
 namespace objects {
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 
 class DummyObject : public Object {
  public:
   using Object::Object;
 
-  void Update(
-      const std::list<std::unique_ptr<Object>>& other_objects) override {
-    UpdateInternal(other_objects);
-  }
+  void Update(absl::Span<Object* const> other_objects) override {}
   void Draw() const override {}
   bool OnCollisionCallback(Object& other_object) override {
     other_object.set_deleted(true);
     return true;
   }
+
+  using Object::MoveHitBox;
+  using Object::set_collides_with;
+};
+
+// Counts the updates, has no candidates.
+class CountingCollisionIndex : public CollisionIndex {
+ public:
+  void Add(Object& object) override {}
+  void Remove(Object& object) override {}
+  void Update(const Object& object) override { ++updates; }
+  bool ForEachCandidate(const Object& object,
+                        absl::FunctionRef<bool(Object&)> callback) override {
+    return false;
+  }
+
+  int updates = 0;
 };
 
 TEST(ObjectTest, ObjectCreationOk) {
@@ -43,6 +62,72 @@ TEST(ObjectTest, ObjectCreationOk) {
   EXPECT_FALSE(object.clicked());
 }
 
+TEST(ObjectTest, SleepAndWake) {
+  DummyObject object = DummyObject(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  object.set_collides_with(kAllLayers);
+
+  object.CountFrameAtRest(/*frames_to_sleep=*/2);
+  EXPECT_FALSE(object.asleep());
+  object.CountFrameAtRest(/*frames_to_sleep=*/2);
+  EXPECT_TRUE(object.asleep());
+  EXPECT_FALSE(object.LooksForCollisions());
+
+  object.Wake();
+  EXPECT_FALSE(object.asleep());
+  object.CountFrameAtRest(/*frames_to_sleep=*/2);
+  EXPECT_FALSE(object.asleep());
+  object.CountFrameAtRest(/*frames_to_sleep=*/2);
+  object.MoveHitBox(1, 0);
+  EXPECT_FALSE(object.asleep());
+  object.MoveHitBox(0, 0);
+  object.CountFrameAtRest(/*frames_to_sleep=*/2);
+  EXPECT_FALSE(object.asleep());
+}
+
+TEST(ObjectTest, InterpolatedCenter) {
+  DummyObject object = DummyObject(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  EXPECT_EQ(object.previous_center(), (WorldPosition{1, 1}));
+
+  object.SavePreviousCenter();
+  object.MoveHitBox(4, -2);
+
+  EXPECT_EQ(object.previous_center(), (WorldPosition{1, 1}));
+  EXPECT_EQ(object.InterpolatedCenter(0), (WorldPosition{1, 1}));
+  EXPECT_EQ(object.InterpolatedCenter(0.5f), (WorldPosition{3, 0}));
+  EXPECT_EQ(object.InterpolatedCenter(1), (WorldPosition{5, -1}));
+  object.SavePreviousCenter();
+  EXPECT_EQ(object.InterpolatedCenter(0.5f), (WorldPosition{5, -1}));
+}
+
+TEST(ObjectTest, DeferredCollisionIndexUpdate) {
+  DummyObject object = DummyObject(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  CountingCollisionIndex index;
+  object.set_collision_index(&index);
+
+  object.MoveHitBox(1, 0);
+  EXPECT_EQ(index.updates, 1);
+
+  index.set_defers_updates(true);
+  object.MoveHitBox(1, 0);
+  object.MoveHitBox(1, 0);
+  EXPECT_EQ(index.updates, 1);
+  index.set_defers_updates(false);
+  object.FlushCollisionIndexUpdate();
+  EXPECT_EQ(index.updates, 2);
+  // Nothing moved since.
+  object.FlushCollisionIndexUpdate();
+  EXPECT_EQ(index.updates, 2);
+}
+
 TEST(ObjectTest, Collision) {
   const DummyObject circle = DummyObject(
       /*type=*/ObjectTypeFactory::MakePlayer(),
@@ -175,20 +260,83 @@ TEST(ObjectTest, YBase) {
   EXPECT_EQ(rect.YBase(), 5);
 }
 
-TEST(ObjectTest, UpdateInternalIgnoresSameObject) {
+std::vector<Object*> Collisions(const Object& object,
+                                absl::Span<Object* const> other_objects) {
+  std::vector<Object*> collisions;
+  object.ForEachCollision(other_objects, [&collisions](Object& other) {
+    collisions.push_back(&other);
+  });
+  return collisions;
+}
+
+TEST(ObjectTest, ForEachCollisionIgnoresSameObject) {
   std::unique_ptr<DummyObject> rect = std::make_unique<DummyObject>(
       /*type=*/ObjectTypeFactory::MakeEnemy(),
       /*options=*/
       Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
       /*hit_box=*/
       FRectangle{.top_left = {2, 2}, .width = 8, .height = 6});
-  DummyObject* rect_ptr = rect.get();
-  std::list<std::unique_ptr<Object>> same_object;
-  same_object.emplace_back(std::move(rect));
 
-  rect_ptr->Update(same_object);
+  EXPECT_THAT(Collisions(*rect, {rect.get()}), IsEmpty());
+}
+
+TEST(ObjectTest, ForEachCollisionSkipsFilteredLayers) {
+  std::unique_ptr<DummyObject> circle = std::make_unique<DummyObject>(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/
+      Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  std::unique_ptr<DummyObject> enemy = std::make_unique<DummyObject>(
+      /*type=*/ObjectTypeFactory::MakeEnemy(),
+      /*options=*/
+      Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {2, 2}, .radius = 3});
+  std::unique_ptr<DummyObject> button = std::make_unique<DummyObject>(
+      /*type=*/ObjectTypeFactory::MakeButton(),
+      /*options=*/
+      Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {2, 2}, .radius = 3});
+  DummyObject* circle_ptr = circle.get();
+  DummyObject* enemy_ptr = enemy.get();
+  DummyObject* button_ptr = button.get();
+  const std::vector<Object*> objects = {circle_ptr, enemy_ptr, button_ptr};
+  circle_ptr->set_collides_with(ObjectTypeFactory::MakeButton().LayerBit());
+
+  EXPECT_THAT(Collisions(*circle_ptr, objects), ElementsAre(button_ptr));
+  EXPECT_FALSE(enemy_ptr->deleted());
+  EXPECT_FALSE(button_ptr->deleted());
+}
+
+TEST(ObjectTest, ForEachCollisionNotCollidingWithAnyLayer) {
+  std::unique_ptr<DummyObject> circle = std::make_unique<DummyObject>(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/
+      Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  std::unique_ptr<DummyObject> enemy = std::make_unique<DummyObject>(
+      /*type=*/ObjectTypeFactory::MakeEnemy(),
+      /*options=*/
+      Object::Opts{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {2, 2}, .radius = 3});
+  DummyObject* circle_ptr = circle.get();
+  const std::vector<Object*> objects = {circle_ptr, enemy.get()};
+  circle_ptr->set_collides_with(LayerMask{0});
+
+  EXPECT_THAT(Collisions(*circle_ptr, objects), IsEmpty());
+}
+
+TEST(ObjectTest, ResolveCollision) {
+  DummyObject circle = DummyObject(
+      /*type=*/ObjectTypeFactory::MakePlayer(),
+      /*options=*/{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {1, 1}, .radius = 3});
+  DummyObject enemy = DummyObject(
+      /*type=*/ObjectTypeFactory::MakeEnemy(),
+      /*options=*/{.is_hit_box_active = true, .should_draw_hit_box = false},
+      /*hit_box=*/FCircle{.center = {2, 2}, .radius = 3});
 
-  EXPECT_FALSE(rect_ptr->deleted());
+  EXPECT_TRUE(circle.ResolveCollision(enemy));
+  EXPECT_TRUE(enemy.deleted());
 }
 
 }  // namespace
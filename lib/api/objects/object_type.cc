@@ -1,5 +1,9 @@
 #include "lib/api/objects/object_type.h"
 
+#include <initializer_list>
+
+#include "absl/log/check.h"
+
 namespace lib {
 namespace api {
 namespace objects {
@@ -71,7 +75,18 @@ bool ObjectType::IsSpriteBoundingBox() const {
   return type_ == kSpriteBoundingBox;
 }
 
+LayerMask MakeLayerMask(const std::initializer_list<ObjectType> types) {
+  LayerMask mask = 0;
+  for (const ObjectType type : types) {
+    mask |= type.LayerBit();
+  }
+  return mask;
+}
+
 ObjectType ObjectTypeFactory::MakeNewObjectType() {
+  CHECK(free_type_ + 1 < kMaxObjectTypes)
+      << "Out of object types, at most " << kMaxObjectTypes
+      << " are supported since every type is a collision layer.";
   return ObjectType(++free_type_);
 }
 
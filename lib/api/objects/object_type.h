@@ -1,6 +1,9 @@
 #ifndef LIB_API_OBJECTS_OBJECT_TYPE_H
 #define LIB_API_OBJECTS_OBJECT_TYPE_H
 
+#include <cstdint>
+#include <initializer_list>
+
 #include "absl/hash/hash.h"
 
 #include "gtest/gtest_prod.h"
@@ -14,6 +17,12 @@ class StatsTest;
 
 namespace objects {
 
+// Set of object types (collision layers), every `ObjectType` owns one bit.
+typedef uint64_t LayerMask;
+
+inline constexpr LayerMask kAllLayers = ~LayerMask{0};
+inline constexpr uint16_t kMaxObjectTypes = 64;
+
 class ObjectType {
  public:
   bool operator==(const ObjectType& other) const;
@@ -38,6 +47,11 @@ class ObjectType {
   [[nodiscard]] bool IsWorldBorder() const;
   [[nodiscard]] bool IsSpriteBoundingBox() const;
 
+  [[nodiscard]] LayerMask LayerBit() const { return LayerMask{1} << type_; }
+  [[nodiscard]] bool IsIn(const LayerMask mask) const {
+    return (mask & LayerBit()) != 0;
+  }
+
  private:
   friend class ObjectTypeFactory;
 
@@ -46,6 +60,9 @@ class ObjectType {
   uint16_t type_;
 };
 
+// Returns a mask with bits of all `types` set.
+LayerMask MakeLayerMask(std::initializer_list<ObjectType> types);
+
 class ObjectTypeFactory {
  public:
   ObjectType MakeNewObjectType();
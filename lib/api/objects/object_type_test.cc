@@ -24,6 +24,18 @@ TEST(ObjectTypeTest, LessWorks) {
   EXPECT_LT(type_1, type_2);
 }
 
+TEST(ObjectTypeTest, LayerMasks) {
+  const LayerMask mask = MakeLayerMask(
+      {ObjectTypeFactory::MakePlayer(), ObjectTypeFactory::MakeWorldBorder()});
+
+  EXPECT_NE(ObjectTypeFactory::MakePlayer().LayerBit(),
+            ObjectTypeFactory::MakeEnemy().LayerBit());
+  EXPECT_TRUE(ObjectTypeFactory::MakePlayer().IsIn(mask));
+  EXPECT_TRUE(ObjectTypeFactory::MakeWorldBorder().IsIn(mask));
+  EXPECT_FALSE(ObjectTypeFactory::MakeEnemy().IsIn(mask));
+  EXPECT_TRUE(ObjectTypeFactory::MakeEnemy().IsIn(kAllLayers));
+}
+
 TEST(ObjectTypeTest, FactoryMethodsWork) {
   EXPECT_TRUE(ObjectTypeFactory::MakePlayer().IsPlayer());
   EXPECT_TRUE(ObjectTypeFactory::MakeEnemy().IsEnemy());
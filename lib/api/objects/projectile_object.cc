@@ -1,11 +1,43 @@
 #include "lib/api/objects/projectile_object.h"
 
+#include <memory>
+#include <utility>
+
 #include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
 
 namespace lib {
 namespace api {
 namespace objects {
 
+void ProjectileObject::Reset(
+    const ObjectType type, const ProjectileObjectOpts& options,
+    std::unique_ptr<sprites::SpriteInstance> sprite_instance) {
+  MovableObject::Reset(type, MakeMovableObjectOpts(options),
+                       MakeHitBox(options), std::move(sprite_instance));
+  despawn_outside_screen_area_ = options.despawn_outside_screen_area;
+  despawn_on_colliding_with_these_objects_ =
+      options.despawn_on_colliding_with_these_objects;
+  reflect_on_colliding_with_these_objects_ =
+      options.reflect_on_colliding_with_these_objects;
+  ignore_these_objects_ = options.ignore_these_objects;
+  set_collides_with(MakeCollidesWithMask(options));
+}
+
+LayerMask ProjectileObject::MakeCollidesWithMask(
+    const ProjectileObjectOpts& options) {
+  LayerMask collides_with = (options.despawn_on_colliding_with_these_objects |
+                             options.reflect_on_colliding_with_these_objects) &
+                            ~options.ignore_these_objects;
+  if (options.despawn_outside_screen_area) {
+    collides_with |= MakeLayerMask({ObjectTypeFactory::MakeScreenLeft(),
+                                    ObjectTypeFactory::MakeScreenRight(),
+                                    ObjectTypeFactory::MakeScreenTop(),
+                                    ObjectTypeFactory::MakeScreenBottom()});
+  }
+  return collides_with;
+}
+
 bool ProjectileObject::OnCollisionCallback(Object& other_object) {
   if (despawn_outside_screen_area_) {
     if (other_object.type().IsScreenEdge()) {
@@ -14,16 +46,16 @@ bool ProjectileObject::OnCollisionCallback(Object& other_object) {
     }
   }
 
-  if (ignore_these_objects_.contains(other_object.type())) {
+  if (other_object.type().IsIn(ignore_these_objects_)) {
     return false;
   }
 
-  if (despawn_on_colliding_with_these_objects_.contains(other_object.type())) {
+  if (other_object.type().IsIn(despawn_on_colliding_with_these_objects_)) {
     set_deleted(true);
     return false;
   }
 
-  if (reflect_on_colliding_with_these_objects_.contains(other_object.type())) {
+  if (other_object.type().IsIn(reflect_on_colliding_with_these_objects_)) {
     auto [dir_x, dir_y] =
         other_object.Reflect(*this, direction_x(), direction_y());
 
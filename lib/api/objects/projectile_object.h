@@ -1,7 +1,9 @@
 #ifndef LIB_API_OBJECTS_PROJECTILE_OBJECT_H
 #define LIB_API_OBJECTS_PROJECTILE_OBJECT_H
 
-#include "absl/container/flat_hash_set.h"
+#include <memory>
+#include <utility>
+
 #include "lib/api/common_types.h"
 #include "lib/api/objects/movable_object.h"
 #include "lib/api/objects/object.h"
@@ -20,37 +22,55 @@ class ProjectileObject : public MovableObject {
     float velocity{};
     FPoint hit_box_center{};
     float hit_box_radius{};
-    absl::flat_hash_set<ObjectType> despawn_on_colliding_with_these_objects;
-    absl::flat_hash_set<ObjectType> reflect_on_colliding_with_these_objects;
-    absl::flat_hash_set<ObjectType> ignore_these_objects;
+    // Response to colliding with the objects is picked by these layer masks,
+    // see `MakeLayerMask`. Ignored objects win over the other two.
+    LayerMask despawn_on_colliding_with_these_objects{};
+    LayerMask reflect_on_colliding_with_these_objects{};
+    LayerMask ignore_these_objects{};
   };
 
   ProjectileObject(
-      const ObjectType type, ProjectileObjectOpts options,
+      const ObjectType type, const ProjectileObjectOpts& options,
       std::unique_ptr<sprites::SpriteInstance> sprite_instance = nullptr)
-      : MovableObject(type,
-                      MovableObjectOpts{
-                          .is_hit_box_active = true,
-                          .should_draw_hit_box = options.should_draw_hit_box,
-                          .attach_camera = false,
-                          .velocity = options.velocity},
-                      FCircle{.center = options.hit_box_center,
-                              .radius = options.hit_box_radius},
-                      std::move(sprite_instance)),
+      : MovableObject(type, MakeMovableObjectOpts(options),
+                      MakeHitBox(options), std::move(sprite_instance)),
         despawn_outside_screen_area_(options.despawn_outside_screen_area),
         despawn_on_colliding_with_these_objects_(
-            std::move(options.despawn_on_colliding_with_these_objects)),
+            options.despawn_on_colliding_with_these_objects),
         reflect_on_colliding_with_these_objects_(
             options.reflect_on_colliding_with_these_objects),
-        ignore_these_objects_(options.ignore_these_objects) {}
+        ignore_these_objects_(options.ignore_these_objects) {
+    set_collides_with(MakeCollidesWithMask(options));
+  }
+
+  // Puts a projectile reused by an `ObjectPool` into the state the
+  // constructor does.
+  void Reset(ObjectType type, const ProjectileObjectOpts& options,
+             std::unique_ptr<sprites::SpriteInstance> sprite_instance =
+                 nullptr);
 
   bool OnCollisionCallback(Object& other_object) override;
 
  private:
+  [[nodiscard]] static MovableObjectOpts MakeMovableObjectOpts(
+      const ProjectileObjectOpts& options) {
+    return {.is_hit_box_active = true,
+            .should_draw_hit_box = options.should_draw_hit_box,
+            .attach_camera = false,
+            .velocity = options.velocity};
+  }
+  [[nodiscard]] static FCircle MakeHitBox(const ProjectileObjectOpts& options) {
+    return {.center = options.hit_box_center,
+            .radius = options.hit_box_radius};
+  }
+  // Objects without any response are never checked for collisions.
+  [[nodiscard]] static LayerMask MakeCollidesWithMask(
+      const ProjectileObjectOpts& options);
+
   bool despawn_outside_screen_area_;
-  absl::flat_hash_set<ObjectType> despawn_on_colliding_with_these_objects_;
-  absl::flat_hash_set<ObjectType> reflect_on_colliding_with_these_objects_;
-  absl::flat_hash_set<ObjectType> ignore_these_objects_;
+  LayerMask despawn_on_colliding_with_these_objects_;
+  LayerMask reflect_on_colliding_with_these_objects_;
+  LayerMask ignore_these_objects_;
 };
 
 }  // namespace objects
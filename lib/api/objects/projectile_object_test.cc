@@ -27,10 +27,9 @@ TEST(ProjectileObjectTest, OnCollisionCallbackDespawns) {
           .hit_box_center = {.x = 1, .y = 1},
           .hit_box_radius = 3,
           .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{ObjectTypeFactory::MakePlayer()},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+              MakeLayerMask({ObjectTypeFactory::MakePlayer()}),
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
 
   projectile.OnCollisionCallback(collided_object);
 
@@ -51,11 +50,9 @@ TEST(ProjectileObjectTest, OnCollisionCallbackBottomScreenDespawns) {
           .velocity = 1,
           .hit_box_center = {.x = 5, .y = 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
 
   projectile.OnCollisionCallback(collided_object);
 
@@ -76,11 +73,9 @@ TEST(ProjectileObjectTest, OnCollisionCallbackTopScreenDespawns) {
           .velocity = 1,
           .hit_box_center = {.x = 5, .y = 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
 
   projectile.OnCollisionCallback(collided_object);
 
@@ -101,11 +96,9 @@ TEST(ProjectileObjectTest, OnCollisionCallbackLeftScreenDespawns) {
           .velocity = 1,
           .hit_box_center = {.x = 5, .y = 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
 
   projectile.OnCollisionCallback(collided_object);
 
@@ -126,11 +119,9 @@ TEST(ProjectileObjectTest, OnCollisionCallbackRightScreenDespawns) {
           .velocity = 1,
           .hit_box_center = {.x = 5, .y = 0},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
+          .ignore_these_objects = 0});
 
   projectile.OnCollisionCallback(collided_object);
 
@@ -151,11 +142,10 @@ TEST(ProjectileObjectTest, OnCollisionCallbackReflects) {
           .velocity = 1,
           .hit_box_center = {.x = 0, .y = 5},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
+          .despawn_on_colliding_with_these_objects = 0,
           .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{ObjectTypeFactory::MakeEnemy()},
-          .ignore_these_objects = absl::flat_hash_set<ObjectType>{}});
+              MakeLayerMask({ObjectTypeFactory::MakeEnemy()}),
+          .ignore_these_objects = 0});
   projectile.SetDirectionGlobal(/*x=*/1, /*y=*/0);
 
   projectile.OnCollisionCallback(collided_object);
@@ -178,12 +168,10 @@ TEST(ProjectileObjectTest, OnCollisionCallbackIgnores) {
           .velocity = 1,
           .hit_box_center = {.x = 0, .y = 5},
           .hit_box_radius = 3,
-          .despawn_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
-          .reflect_on_colliding_with_these_objects =
-              absl::flat_hash_set<ObjectType>{},
+          .despawn_on_colliding_with_these_objects = 0,
+          .reflect_on_colliding_with_these_objects = 0,
           .ignore_these_objects =
-              absl::flat_hash_set<ObjectType>{ObjectTypeFactory::MakeEnemy()}});
+              MakeLayerMask({ObjectTypeFactory::MakeEnemy()})});
   projectile.SetDirectionGlobal(/*x=*/1, /*y=*/0);
 
   projectile.OnCollisionCallback(collided_object);
@@ -193,6 +181,35 @@ TEST(ProjectileObjectTest, OnCollisionCallbackIgnores) {
   EXPECT_FALSE(projectile.deleted());
 }
 
+TEST(ProjectileObjectTest, CollidesOnlyWithRespondedLayers) {
+  const ProjectileObject projectile = ProjectileObject(
+      ObjectTypeFactory::MakeProjectilePlayer(),
+      ProjectileObject::ProjectileObjectOpts{
+          .should_draw_hit_box = false,
+          .despawn_outside_screen_area = false,
+          .velocity = 1,
+          .hit_box_center = {.x = 0, .y = 5},
+          .hit_box_radius = 3,
+          .despawn_on_colliding_with_these_objects =
+              MakeLayerMask({ObjectTypeFactory::MakeEnemy(),
+                             ObjectTypeFactory::MakePlayer()}),
+          .reflect_on_colliding_with_these_objects =
+              MakeLayerMask({ObjectTypeFactory::MakeButton()}),
+          .ignore_these_objects =
+              MakeLayerMask({ObjectTypeFactory::MakePlayer()})});
+
+  EXPECT_EQ(projectile.collides_with(),
+            MakeLayerMask({ObjectTypeFactory::MakeEnemy(),
+                           ObjectTypeFactory::MakeButton()}));
+  // The hit box test of `Object` is still reachable through a projectile.
+  const StaticObject enemy =
+      StaticObject(ObjectTypeFactory::MakeEnemy(),
+                   StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                                  .should_draw_hit_box = false},
+                   FCircle{.center = {0, 7}, .radius = 2});
+  EXPECT_TRUE(projectile.CollidesWith(enemy));
+}
+
 }  // namespace
 }  // namespace objects
 }  // namespace api
@@ -2,9 +2,12 @@
 
 #include "lib/api/objects/rectangle_button_object.h"
 
+#include <memory>
+
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/render_snapshot.h"
 #include "lib/api/text/text.h"
 
 namespace lib {
@@ -18,33 +21,34 @@ namespace {
 constexpr float kRoundness = 0.2f;
 constexpr int kSegments = 10;
 
-}  // namespace
-
-void RectangleButtonObject::DrawRectangleRound() const {
+void DrawRectangleRound(const Rectangle& rec, const float border_thickness,
+                        const Color border_color, const Color fill_color) {
   // Draw fill/inside color first.
-  DrawRectangleRounded(raylib_rec_, kRoundness, kSegments, raylib_fill_color_);
+  DrawRectangleRounded(rec, kRoundness, kSegments, fill_color);
   // Draw the border.
-  DrawRectangleRoundedLinesEx(raylib_rec_, kRoundness, kSegments,
-                              border_thickness_, raylib_border_color_);
+  DrawRectangleRoundedLinesEx(rec, kRoundness, kSegments, border_thickness,
+                              border_color);
 }
 
-void RectangleButtonObject::DrawRectangleSharp() const {
+void DrawRectangleSharp(const Rectangle& rec, const float border_thickness,
+                        const Color border_color, const Color fill_color) {
   // Draw fill/inside color first.
-  DrawRectangle(static_cast<int>(raylib_rec_.x),
-                static_cast<int>(raylib_rec_.y),
-                static_cast<int>(raylib_rec_.width),
-                static_cast<int>(raylib_rec_.height), raylib_fill_color_);
+  DrawRectangle(static_cast<int>(rec.x), static_cast<int>(rec.y),
+                static_cast<int>(rec.width), static_cast<int>(rec.height),
+                fill_color);
   // Draw the border.
-  DrawRectangleLinesEx(raylib_rec_, border_thickness_, raylib_border_color_);
+  DrawRectangleLinesEx(rec, border_thickness, border_color);
 }
 
+}  // namespace
+
 RectangleButtonObject::RectangleButtonObject(
     const ObjectType type, const FRectangle& rectangle, const Text& text,
     const RectangleButtonObjectOpts& options)
     : StaticObject(type,
                    {.is_hit_box_active = true, .should_draw_hit_box = false},
                    rectangle),
-      text_(text),
+      text_(std::make_shared<const Text>(text)),
       has_round_corners_(options.has_round_corners),
       border_thickness_(options.border_thickness),
       raylib_rec_({.x = rectangle.top_left.x,
@@ -60,13 +64,21 @@ RectangleButtonObject::RectangleButtonObject(
                           .b = options.fill_color.b,
                           .a = options.fill_color.a}) {}
 
-void RectangleButtonObject::Draw() const {
-  if (has_round_corners_) {
-    DrawRectangleRound();
-  } else {
-    DrawRectangleSharp();
-  }
-  text_.DrawCentered(center().ToFPoint());
+void RectangleButtonObject::AddToSnapshot(RenderSnapshot& snapshot) const {
+  snapshot.SetCustomDraw(
+      AddItemToSnapshot(snapshot),
+      [text = text_, center = center().ToFPoint(),
+       has_round_corners = has_round_corners_,
+       border_thickness = border_thickness_, rec = raylib_rec_,
+       border_color = raylib_border_color_,
+       fill_color = raylib_fill_color_]() {
+        if (has_round_corners) {
+          DrawRectangleRound(rec, border_thickness, border_color, fill_color);
+        } else {
+          DrawRectangleSharp(rec, border_thickness, border_color, fill_color);
+        }
+        text->DrawCentered(center);
+      });
 }
 
 }  // namespace objects
@@ -3,9 +3,12 @@
 
 #include "raylib/include/raylib.h"
 
+#include <memory>
+
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/objects/static_object.h"
+#include "lib/api/render_snapshot.h"
 #include "lib/api/text/text.h"
 
 namespace lib {
@@ -25,13 +28,11 @@ class RectangleButtonObject : public StaticObject {
                         const text::Text& text,
                         const RectangleButtonObjectOpts& options);
 
-  void Draw() const override;
+  void AddToSnapshot(RenderSnapshot& snapshot) const override;
 
  private:
-  void DrawRectangleRound() const;
-  void DrawRectangleSharp() const;
-
-  const text::Text text_;
+  // Shared with the snapshots, copying the text would allocate every frame.
+  const std::shared_ptr<const text::Text> text_;
   const bool has_round_corners_;
   const float border_thickness_;
   const Rectangle raylib_rec_;
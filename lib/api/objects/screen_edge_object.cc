@@ -49,33 +49,32 @@ ScreenEdgeObject::ScreenEdgeObject(const ObjectType type,
     : Object(type,
              {/*is_hit_box_active*/ true,
               /*should_draw_hitbox=*/should_draw_hit_box},
-             FLine({a.ToFPoint(), b.ToFPoint()})) {}
+             FLine({a.ToFPoint(), b.ToFPoint()})) {
+  // Screen edges never look for collisions, objects collide with them.
+  set_collides_with(LayerMask{0});
+}
 
 void ScreenEdgeObject::ReAdjustToScreen(const WorldPosition screen_top_left_pos,
                                         const float screen_width,
                                         const float screen_height) {
   if (type().IsScreenTop()) {
-    mutable_hit_box().Move(
-        screen_width / 2 + screen_top_left_pos.x - center().x,
-        screen_top_left_pos.y - center().y);
+    MoveHitBox(screen_width / 2 + screen_top_left_pos.x - center().x,
+               screen_top_left_pos.y - center().y);
     return;
   }
   if (type().IsScreenBottom()) {
-    mutable_hit_box().Move(
-        screen_width / 2 + screen_top_left_pos.x - center().x,
-        screen_height + screen_top_left_pos.y - center().y);
+    MoveHitBox(screen_width / 2 + screen_top_left_pos.x - center().x,
+               screen_height + screen_top_left_pos.y - center().y);
     return;
   }
   if (type().IsScreenLeft()) {
-    mutable_hit_box().Move(
-        screen_top_left_pos.x - center().x,
-        screen_top_left_pos.y + screen_height / 2 - center().y);
+    MoveHitBox(screen_top_left_pos.x - center().x,
+               screen_top_left_pos.y + screen_height / 2 - center().y);
     return;
   }
   if (type().IsScreenRight()) {
-    mutable_hit_box().Move(
-        screen_width + screen_top_left_pos.x - center().x,
-        screen_top_left_pos.y + screen_height / 2 - center().y);
+    MoveHitBox(screen_width + screen_top_left_pos.x - center().x,
+               screen_top_left_pos.y + screen_height / 2 - center().y);
     return;
   }
 }
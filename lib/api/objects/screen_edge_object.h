@@ -1,9 +1,9 @@
 #ifndef LIB_API_OBJECTS_SCREEN_EDGE_OBJECT_H
 #define LIB_API_OBJECTS_SCREEN_EDGE_OBJECT_H
 
-#include <list>
 #include <memory>
 
+#include "absl/types/span.h"
 #include "lib/api/common_types.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
@@ -32,8 +32,7 @@ class ScreenEdgeObject : public Object {
   ScreenEdgeObject(ObjectType type, bool should_draw_hit_box, ScreenPosition a,
                    ScreenPosition b);
 
-  void Update(
-      const std::list<std::unique_ptr<Object>>& other_objects) override {}
+  void Update(absl::Span<Object* const> other_objects) override {}
   bool OnCollisionCallback(Object& other_object) override { return false; }
 };
 
@@ -1,8 +1,8 @@
 #include "lib/api/objects/static_object.h"
 
-#include <list>
 #include <memory>
 
+#include "absl/types/span.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
 #include "lib/api/sprites/sprite_instance.h"
@@ -20,10 +20,7 @@ StaticObject::StaticObject(
               .should_draw_hit_box = options.should_draw_hit_box},
              hit_box, std::move(sprite_instance)) {}
 
-void StaticObject::Update(
-    const std::list<std::unique_ptr<Object>>& other_objects) {
-  UpdateInternal(other_objects);
-}
+void StaticObject::Update(absl::Span<Object* const> other_objects) {}
 
 bool StaticObject::OnCollisionCallback(Object& other_object) {
   // TODO(f1lo): Implement.
@@ -1,9 +1,9 @@
 #ifndef LIB_API_OBJECTS_STATIC_OBJECT_H
 #define LIB_API_OBJECTS_STATIC_OBJECT_H
 
-#include <list>
 #include <memory>
 
+#include "absl/types/span.h"
 #include "gtest/gtest_prod.h"
 #include "lib/api/objects/object.h"
 #include "lib/api/objects/object_type.h"
@@ -24,7 +24,9 @@ class StaticObject : public Object {
       ObjectType type, StaticObjectOpts options, const HitBoxVariant& hit_box,
       std::unique_ptr<sprites::SpriteInstance> sprite_instance = nullptr);
 
-  void Update(const std::list<std::unique_ptr<Object>>& other_objects) override;
+  // Does nothing - static objects are only the passive side of collisions.
+  void Update(absl::Span<Object* const> other_objects) override;
+  [[nodiscard]] bool IsStatic() const override { return true; }
 
  protected:
   FRIEND_TEST(StaticObjectTest, OnCollisionCallbackDoesNothing);
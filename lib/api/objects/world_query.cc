@@ -0,0 +1,248 @@
+#include "lib/api/objects/world_query.h"
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+#include "lib/internal/geometry/vec.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+namespace {
+
+internal::Ray MakeRay(const FPoint& origin, const FPoint& direction,
+                      const float max_distance) {
+  const internal::Vector vector = {direction.x, direction.y};
+  CHECK(!vector.IsZero()) << "Direction can not be zero, have: " << direction;
+  CHECK(max_distance >= 0) << "Distance can not be negative, have: "
+                           << max_distance;
+  return {.origin = {origin.x, origin.y},
+          .direction = vector.ToUnitVector(),
+          .max_distance = max_distance};
+}
+
+}  // namespace
+
+std::optional<RaycastHit> WorldQuery::Raycast(
+    const WorldPosition& origin, const FPoint& direction,
+    const float max_distance, const LayerMask layers,
+    const absl::Nullable<const Object*> ignored) const {
+  return Cast(MakeRay(origin.ToFPoint(), direction, max_distance),
+              /*thickness=*/0, layers, ignored,
+              [](const Object& object, const internal::Ray& ray) {
+                return object.Raycast(ray);
+              });
+}
+
+std::optional<RaycastHit> WorldQuery::ShapeCast(
+    const FCircle& circle, const FPoint& direction, const float max_distance,
+    const LayerMask layers, const absl::Nullable<const Object*> ignored) const {
+  CHECK(circle.radius > 0) << "Radius has to be positive, have: "
+                           << circle.radius;
+  const float radius = circle.radius;
+  return Cast(MakeRay(circle.center, direction, max_distance), radius, layers,
+              ignored,
+              [radius](const Object& object, const internal::Ray& ray) {
+                return object.CircleCast(ray, radius);
+              });
+}
+
+std::optional<RaycastHit> WorldQuery::ShapeCast(
+    const FRectangle& rectangle, const FPoint& direction,
+    const float max_distance, const LayerMask layers,
+    const absl::Nullable<const Object*> ignored) const {
+  CHECK(rectangle.width > 0 && rectangle.height > 0)
+      << "Rectangle has to have positive size, have: " << rectangle;
+  const float half_width = rectangle.width / 2;
+  const float half_height = rectangle.height / 2;
+  const FPoint center = {.x = rectangle.top_left.x + half_width,
+                         .y = rectangle.top_left.y + half_height};
+  return Cast(MakeRay(center, direction, max_distance),
+              std::max(half_width, half_height), layers, ignored,
+              [half_width, half_height](const Object& object,
+                                        const internal::Ray& ray) {
+                return object.BoxCast(ray, half_width, half_height);
+              });
+}
+
+void WorldQuery::QueryPoint(const WorldPosition& position,
+                            std::vector<Object*>& results,
+                            const LayerMask layers) const {
+  QueryHitBox(internal::HitBox::CreateHitBox(position.ToFPoint()), results,
+              layers);
+}
+
+void WorldQuery::QueryHitBox(const internal::HitBox& hit_box,
+                             std::vector<Object*>& results,
+                             const LayerMask layers) const {
+  results.clear();
+  ForEachInBox(hit_box.aabb(), [&hit_box, &results, layers](Object& object) {
+    if (object.type().IsIn(layers) && object.CollidesWith(hit_box)) {
+      results.push_back(&object);
+    }
+  });
+}
+
+void WorldQuery::QueryAABB(const FRectangle& area,
+                           std::vector<Object*>& results,
+                           const LayerMask layers) const {
+  CHECK(area.width > 0 && area.height > 0)
+      << "Area has to have positive size, have: " << area;
+  const internal::HitBox hit_box = internal::HitBox::CreateHitBox(area);
+  results.clear();
+  ForEachInBox(hit_box.aabb(), [&hit_box, &results, layers](Object& object) {
+    if (object.type().IsIn(layers) && object.CollidesWith(hit_box)) {
+      results.push_back(&object);
+    }
+  });
+}
+
+void WorldQuery::QueryRadius(const WorldPosition& center, const float radius,
+                             std::vector<Object*>& results,
+                             const LayerMask layers) const {
+  CHECK(radius > 0) << "Radius has to be positive, have: " << radius;
+  const internal::HitBox hit_box = internal::HitBox::CreateHitBox(
+      FCircle{.center = center.ToFPoint(), .radius = radius});
+  results.clear();
+  ForEachInBox(hit_box.aabb(), [&hit_box, &results, layers](Object& object) {
+    if (object.type().IsIn(layers) && object.CollidesWith(hit_box)) {
+      results.push_back(&object);
+    }
+  });
+}
+
+void WorldQuery::QueryKNearest(const WorldPosition& position, const size_t k,
+                               std::vector<Object*>& results,
+                               const LayerMask layers) const {
+  results.clear();
+  if (k == 0) {
+    return;
+  }
+  struct Candidate {
+    float squared_distance;
+    // Position in query order, breaks ties.
+    size_t order;
+    Object* object;
+  };
+  // Reused between queries to avoid allocating every frame.
+  thread_local std::vector<Candidate> candidates;
+  const auto add_candidate = [&position, layers](Object& object) {
+    if (!object.type().IsIn(layers) || object.deleted() ||
+        !object.is_hit_box_active()) {
+      return;
+    }
+    const WorldPosition center = object.center();
+    const float dx = center.x - position.x;
+    const float dy = center.y - position.y;
+    candidates.push_back({.squared_distance = dx * dx + dy * dy,
+                          .order = candidates.size(),
+                          .object = &object});
+  };
+
+  if (collision_index_ == nullptr) {
+    candidates.clear();
+    for (Object* object : objects_) {
+      add_candidate(*object);
+    }
+  } else {
+    // Grows the searched box until `k` of the objects in it are closer than
+    // half of its size. Centers of the objects outside of the box are
+    // further away than that, so none of them can be closer.
+    for (float half_size = kDefaultBroadphaseCellSize;; half_size *= 2) {
+      candidates.clear();
+      size_t visited = 0;
+      ForEachInBox({.min_x = position.x - half_size,
+                    .min_y = position.y - half_size,
+                    .max_x = position.x + half_size,
+                    .max_y = position.y + half_size},
+                   [&visited, &add_candidate](Object& object) {
+                     ++visited;
+                     add_candidate(object);
+                   });
+      const size_t inside = std::ranges::count_if(
+          candidates, [half_size](const Candidate& candidate) {
+            return candidate.squared_distance <= half_size * half_size;
+          });
+      if (inside >= k || visited >= collision_index_->size()) {
+        break;
+      }
+    }
+  }
+
+  const auto nearest = candidates.begin() + std::min(k, candidates.size());
+  std::partial_sort(candidates.begin(), nearest, candidates.end(),
+                    [](const Candidate& a, const Candidate& b) {
+                      return std::tie(a.squared_distance, a.order) <
+                             std::tie(b.squared_distance, b.order);
+                    });
+  for (auto it = candidates.begin(); it != nearest; ++it) {
+    results.push_back(it->object);
+  }
+}
+
+std::optional<RaycastHit> WorldQuery::Cast(
+    internal::Ray ray, const float thickness, const LayerMask layers,
+    const absl::Nullable<const Object*> ignored,
+    const absl::FunctionRef<std::optional<internal::RayHit>(
+        const Object&, const internal::Ray&)>
+        cast) const {
+  std::optional<RaycastHit> closest;
+  const auto maybe_hit = [&ray, layers, ignored, cast,
+                          &closest](Object& object) {
+    if (&object == ignored || !object.type().IsIn(layers)) {
+      return;
+    }
+    const std::optional<internal::RayHit> hit = cast(object, ray);
+    // Objects are visited in query order, the first one wins when several
+    // are hit at the same distance.
+    if (!hit.has_value() ||
+        (closest.has_value() && closest->distance <= hit->distance)) {
+      return;
+    }
+    const internal::Vector point = ray.At(hit->distance);
+    closest = RaycastHit{.object = &object,
+                         .distance = hit->distance,
+                         .point = {.x = point.x, .y = point.y},
+                         .normal = {.x = hit->normal.x, .y = hit->normal.y}};
+    // Anything further away can not be the closest hit anymore.
+    ray.max_distance = hit->distance;
+  };
+
+  if (collision_index_ != nullptr) {
+    collision_index_->ForEachOnRay(ray, thickness, maybe_hit);
+  } else {
+    for (Object* object : objects_) {
+      maybe_hit(*object);
+    }
+  }
+  return closest;
+}
+
+void WorldQuery::ForEachInBox(
+    const internal::Aabb& aabb,
+    const absl::FunctionRef<void(Object&)> callback) const {
+  if (collision_index_ != nullptr) {
+    collision_index_->ForEachInBox(aabb, callback);
+    return;
+  }
+  for (Object* object : objects_) {
+    callback(*object);
+  }
+}
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,120 @@
+#ifndef LIB_API_OBJECTS_WORLD_QUERY_H
+#define LIB_API_OBJECTS_WORLD_QUERY_H
+
+#include <optional>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/functional/function_ref.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+
+struct RaycastHit {
+  Object* object;
+  // Distance travelled along the ray until the hit.
+  float distance;
+  // Position of the ray, or of the center of the cast shape, at the hit.
+  FPoint point;
+  // Unit normal of the hit surface, pointing against the ray.
+  FPoint normal;
+};
+
+// Spatial queries against the objects of a level, e.g. for hitscan weapons,
+// line of sight checks or finding enemies around the player. Uses the
+// collision index when it is set, otherwise every object is checked.
+//
+// Objects which are not on `layers`, deleted objects and objects without an
+// active hit box are never found. To filter by a single `ObjectType` pass its
+// `LayerBit()`.
+//
+// Casts hit the closest object only, and never `ignored` - usually the object
+// doing the query. `direction` does not need to have unit length. A cast
+// starting inside of an object hits it at distance 0.
+//
+// Region queries clear `results` and write the found objects into it. Reusing
+// the same vector between calls does not allocate once it is large enough.
+//
+// Objects are found in query order, which also breaks ties between objects at
+// the same distance from a cast or a point. With the collision index it is the
+// order the objects were added to the index. Without it, it is the order of
+// `objects`. A level keeps these in the order they were added until it erases
+// an object, which moves the last object into the gap. So once objects have
+// been erased, the two orders differ.
+class WorldQuery {
+ public:
+  // `objects` may change between queries, it is read on every query.
+  explicit WorldQuery(const std::vector<Object*>& objects)
+      : objects_(objects), collision_index_(nullptr) {}
+
+  [[nodiscard]] std::optional<RaycastHit> Raycast(
+      const WorldPosition& origin, const FPoint& direction, float max_distance,
+      LayerMask layers = kAllLayers,
+      absl::Nullable<const Object*> ignored = nullptr) const;
+  // Moves `circle` from where it is in `direction`.
+  [[nodiscard]] std::optional<RaycastHit> ShapeCast(
+      const FCircle& circle, const FPoint& direction, float max_distance,
+      LayerMask layers = kAllLayers,
+      absl::Nullable<const Object*> ignored = nullptr) const;
+  // Moves `rectangle` from where it is in `direction`.
+  [[nodiscard]] std::optional<RaycastHit> ShapeCast(
+      const FRectangle& rectangle, const FPoint& direction, float max_distance,
+      LayerMask layers = kAllLayers,
+      absl::Nullable<const Object*> ignored = nullptr) const;
+
+  // Objects whose hit box contains `position`, in query order.
+  void QueryPoint(const WorldPosition& position, std::vector<Object*>& results,
+                  LayerMask layers = kAllLayers) const;
+  // Objects whose hit box collides with `hit_box`, in query order.
+  void QueryHitBox(const internal::HitBox& hit_box,
+                   std::vector<Object*>& results,
+                   LayerMask layers = kAllLayers) const;
+  // Objects whose hit box overlaps `area`, in query order.
+  void QueryAABB(const FRectangle& area, std::vector<Object*>& results,
+                 LayerMask layers = kAllLayers) const;
+  // Objects whose hit box overlaps the circle, in query order.
+  void QueryRadius(const WorldPosition& center, float radius,
+                   std::vector<Object*>& results,
+                   LayerMask layers = kAllLayers) const;
+  // Up to `k` objects whose centers are closest to `position`, the closest
+  // first. Objects at the same distance are in query order.
+  void QueryKNearest(const WorldPosition& position, size_t k,
+                     std::vector<Object*>& results,
+                     LayerMask layers = kAllLayers) const;
+
+  void set_collision_index(
+      absl::Nullable<const BroadphaseCollisionIndex*> collision_index) {
+    collision_index_ = collision_index;
+  }
+
+ private:
+  // Returns the closest hit, `cast` finds the hit with a single object.
+  // `thickness` is the size of the cast shape for the collision index.
+  [[nodiscard]] std::optional<RaycastHit> Cast(
+      internal::Ray ray, float thickness, LayerMask layers,
+      absl::Nullable<const Object*> ignored,
+      absl::FunctionRef<std::optional<internal::RayHit>(
+          const Object&, const internal::Ray&)>
+          cast) const;
+  // Calls `callback` for every object which might overlap `aabb`, in query
+  // order.
+  void ForEachInBox(const internal::Aabb& aabb,
+                    absl::FunctionRef<void(Object&)> callback) const;
+
+  const std::vector<Object*>& objects_;
+  absl::Nullable<const BroadphaseCollisionIndex*> collision_index_;
+};
+
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_OBJECTS_WORLD_QUERY_H
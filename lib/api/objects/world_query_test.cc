@@ -0,0 +1,277 @@
+#include "lib/api/objects/world_query.h"
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/objects/broadphase_collision_index.h"
+#include "lib/api/objects/object.h"
+#include "lib/api/objects/object_type.h"
+#include "lib/api/objects/static_object.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+namespace objects {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr float kEpsilon = 1e-3;
+
+// Parameterized over every broadphase, `kAllPairs` checks the objects without
+// a collision index.
+class WorldQueryTest : public ::testing::TestWithParam<BroadphaseType> {
+ protected:
+  WorldQueryTest()
+      : index_(BroadphaseCollisionIndex::Create(GetParam())),
+        world_(objects_) {
+    world_.set_collision_index(index_.get());
+  }
+
+  Object& Add(const ObjectType type, const FRectangle& rectangle) {
+    owned_objects_.push_back(std::make_unique<StaticObject>(
+        type,
+        StaticObject::StaticObjectOpts{.is_hit_box_active = true,
+                                       .should_draw_hit_box = false},
+        rectangle));
+    objects_.push_back(owned_objects_.back().get());
+    if (index_ != nullptr) {
+      index_->Add(*objects_.back());
+    }
+    return *objects_.back();
+  }
+
+  // Nearest objects found by checking every object.
+  std::vector<Object*> Nearest(const WorldPosition& position, const size_t k,
+                               const LayerMask layers) const {
+    std::vector<Object*> nearest;
+    for (Object* object : objects_) {
+      if (object->type().IsIn(layers)) {
+        nearest.push_back(object);
+      }
+    }
+    const auto distance = [&position](const Object* object) {
+      const float dx = object->center().x - position.x;
+      const float dy = object->center().y - position.y;
+      return dx * dx + dy * dy;
+    };
+    std::ranges::stable_sort(nearest, [&distance](const Object* a,
+                                                  const Object* b) {
+      return distance(a) < distance(b);
+    });
+    nearest.resize(std::min(k, nearest.size()));
+    return nearest;
+  }
+
+  std::list<std::unique_ptr<Object>> owned_objects_;
+  std::vector<Object*> objects_;
+  std::unique_ptr<BroadphaseCollisionIndex> index_;
+  WorldQuery world_;
+};
+
+TEST_P(WorldQueryTest, RaycastHitsClosest) {
+  const Object& far = Add(ObjectTypeFactory::MakeEnemy(), {{30, -5}, 10, 10});
+  const Object& near = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+
+  const std::optional<RaycastHit> hit =
+      world_.Raycast({0, 0}, {2, 0}, /*max_distance=*/100);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->object, &near);
+  EXPECT_FLOAT_EQ(hit->distance, 10);
+  EXPECT_FLOAT_EQ(hit->point.x, 10);
+  EXPECT_FLOAT_EQ(hit->point.y, 0);
+  EXPECT_FLOAT_EQ(hit->normal.x, -1);
+  EXPECT_FLOAT_EQ(hit->normal.y, 0);
+  EXPECT_EQ(world_.Raycast({0, 0}, {1, 0}, 5), std::nullopt);
+  EXPECT_EQ(world_.Raycast({0, 0}, {-1, 0}, 100), std::nullopt);
+  EXPECT_EQ(world_.Raycast({35, 20}, {0, -10}, 100)->object, &far);
+}
+
+TEST_P(WorldQueryTest, RaycastSkipsFilteredIgnoredAndDeleted) {
+  Object& near = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+  const Object& player =
+      Add(ObjectTypeFactory::MakePlayer(), {{30, -5}, 10, 10});
+  const Object& far = Add(ObjectTypeFactory::MakeEnemy(), {{50, -5}, 10, 10});
+
+  EXPECT_EQ(world_
+                .Raycast({0, 0}, {1, 0}, 100,
+                         ObjectTypeFactory::MakePlayer().LayerBit())
+                ->object,
+            &player);
+  EXPECT_EQ(world_
+                .Raycast({0, 0}, {1, 0}, 100,
+                         ObjectTypeFactory::MakeEnemy().LayerBit(), &near)
+                ->object,
+            &far);
+  near.set_deleted(true);
+  EXPECT_EQ(world_.Raycast({0, 0}, {1, 0}, 100)->object, &player);
+}
+
+TEST_P(WorldQueryTest, RaycastSameDistanceHitsFirstAdded) {
+  const Object& first = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 5, 5});
+  Add(ObjectTypeFactory::MakeEnemy(), {{10, 0}, 5, 5});
+
+  EXPECT_EQ(world_.Raycast({0, 0}, {1, 0}, 100)->object, &first);
+}
+
+TEST_P(WorldQueryTest, RaycastStartingInside) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+
+  const std::optional<RaycastHit> hit = world_.Raycast({15, 0}, {1, 0}, 100);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->object, &box);
+  EXPECT_FLOAT_EQ(hit->distance, 0);
+}
+
+TEST_P(WorldQueryTest, ShapeCastCircle) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+
+  // Passes the box corner at (10, 5) 3 units away from the circle center.
+  const std::optional<RaycastHit> hit =
+      world_.ShapeCast(FCircle{{0, 8}, 4}, {1, 0}, 100);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->object, &box);
+  EXPECT_NEAR(hit->distance, 10 - std::sqrt(7.0f), kEpsilon);
+  EXPECT_NEAR(hit->normal.x, -std::sqrt(7.0f) / 4, kEpsilon);
+  EXPECT_NEAR(hit->normal.y, 0.75f, kEpsilon);
+  EXPECT_EQ(world_.Raycast({0, 8}, {1, 0}, 100), std::nullopt);
+  EXPECT_EQ(world_.ShapeCast(FCircle{{0, 8}, 2}, {1, 0}, 100), std::nullopt);
+}
+
+TEST_P(WorldQueryTest, ShapeCastRectangle) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+
+  const std::optional<RaycastHit> hit =
+      world_.ShapeCast(FRectangle{{-2, 3}, 4, 6}, {1, 0}, 100);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->object, &box);
+  EXPECT_NEAR(hit->distance, 8, kEpsilon);
+  EXPECT_NEAR(hit->point.x, 8, kEpsilon);
+  EXPECT_NEAR(hit->point.y, 6, kEpsilon);
+  EXPECT_FLOAT_EQ(hit->normal.x, -1);
+  EXPECT_FLOAT_EQ(hit->normal.y, 0);
+  EXPECT_EQ(world_.ShapeCast(FRectangle{{-2, 3}, 4, 6}, {1, 0}, 7),
+            std::nullopt);
+}
+
+TEST_P(WorldQueryTest, QueryPoint) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+  const Object& button =
+      Add(ObjectTypeFactory::MakeButton(), {{12, -2}, 2, 2});
+  std::vector<Object*> results;
+
+  world_.QueryPoint({13, -1}, results);
+  EXPECT_THAT(results, ElementsAre(&box, &button));
+  world_.QueryPoint({13, -1}, results,
+                    ObjectTypeFactory::MakeButton().LayerBit());
+  EXPECT_THAT(results, ElementsAre(&button));
+  world_.QueryPoint({0, 0}, results);
+  EXPECT_THAT(results, IsEmpty());
+}
+
+TEST_P(WorldQueryTest, QueryHitBox) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+  Add(ObjectTypeFactory::MakePlayer(), {{-10, -10}, 5, 5});
+  std::vector<Object*> results;
+
+  world_.QueryHitBox(
+      internal::HitBox::CreateHitBox(FLine{.a = {0, 0}, .b = {12, 0}}),
+      results);
+  EXPECT_THAT(results, ElementsAre(&box));
+  world_.QueryHitBox(
+      internal::HitBox::CreateHitBox(FCircle{.center = {0, 0}, .radius = 1}),
+      results);
+  EXPECT_THAT(results, IsEmpty());
+}
+
+TEST_P(WorldQueryTest, QueryAABB) {
+  const Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+  const Object& player =
+      Add(ObjectTypeFactory::MakePlayer(), {{-10, -10}, 5, 5});
+  Add(ObjectTypeFactory::MakeEnemy(), {{50, 50}, 10, 10});
+  std::vector<Object*> results = {nullptr};
+
+  world_.QueryAABB({{-20, -20}, 35, 30}, results);
+  EXPECT_THAT(results, ElementsAre(&box, &player));
+  world_.QueryAABB({{-20, -20}, 35, 30}, results,
+                   ObjectTypeFactory::MakeEnemy().LayerBit());
+  EXPECT_THAT(results, ElementsAre(&box));
+  world_.QueryAABB({{21, 6}, 20, 20}, results);
+  EXPECT_THAT(results, IsEmpty());
+}
+
+TEST_P(WorldQueryTest, QueryRadius) {
+  Object& box = Add(ObjectTypeFactory::MakeEnemy(), {{10, -5}, 10, 10});
+  const Object& player = Add(ObjectTypeFactory::MakePlayer(), {{-5, -5}, 1, 1});
+  std::vector<Object*> results;
+
+  world_.QueryRadius({0, 0}, 11, results);
+  EXPECT_THAT(results, ElementsAre(&box, &player));
+  world_.QueryRadius({0, 0}, 9, results);
+  EXPECT_THAT(results, ElementsAre(&player));
+  // Only the rectangle corners are within the square around the circle.
+  world_.QueryRadius({4, -11}, 7, results,
+                     ObjectTypeFactory::MakeEnemy().LayerBit());
+  EXPECT_THAT(results, IsEmpty());
+  box.set_deleted(true);
+  world_.QueryRadius({0, 0}, 11, results);
+  EXPECT_THAT(results, ElementsAre(&player));
+}
+
+TEST_P(WorldQueryTest, QueryKNearestMatchesBruteForce) {
+  for (int i = 0; i < 200; ++i) {
+    const float x = static_cast<float>((i * 137) % 2000);
+    const float y = static_cast<float>((i * 71) % 1500);
+    Add(i % 3 == 0 ? ObjectTypeFactory::MakePlayer()
+                   : ObjectTypeFactory::MakeEnemy(),
+        {{x, y}, 4, 4});
+  }
+  std::vector<Object*> results;
+
+  for (const WorldPosition position :
+       {WorldPosition{1000, 750}, WorldPosition{-5000, 3000},
+        WorldPosition{7, 7}}) {
+    for (const size_t k : {1, 5, 50}) {
+      world_.QueryKNearest(position, k, results,
+                           ObjectTypeFactory::MakeEnemy().LayerBit());
+      EXPECT_EQ(results, Nearest(position, k,
+                                 ObjectTypeFactory::MakeEnemy().LayerBit()))
+          << position << " k: " << k;
+    }
+  }
+  world_.QueryKNearest({0, 0}, 1000, results);
+  EXPECT_EQ(results.size(), 200);
+  world_.QueryKNearest({0, 0}, 0, results);
+  EXPECT_THAT(results, IsEmpty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Broadphases, WorldQueryTest,
+                         ::testing::Values(BroadphaseType::kAllPairs,
+                                           BroadphaseType::kSpatialHashGrid,
+                                           BroadphaseType::kAabbTree,
+                                           BroadphaseType::kSweepAndPrune));
+
+TEST(WorldQueryDeathTest, ZeroDirection) {
+  const std::vector<Object*> objects;
+  const WorldQuery world(objects);
+
+  EXPECT_DEATH((void)world.Raycast({0, 0}, {0, 0}, 100),
+               "Direction can not be zero");
+}
+
+}  // namespace
+}  // namespace objects
+}  // namespace api
+}  // namespace lib
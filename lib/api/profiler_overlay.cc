@@ -0,0 +1,65 @@
+#include "raylib/include/raylib.h"
+
+#include "lib/api/profiler_overlay.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "absl/time/time.h"
+#include "lib/internal/frame_profiler.h"
+
+namespace lib {
+namespace api {
+
+namespace {
+
+using internal::FramePhase;
+
+constexpr int kFontSize = 10;
+constexpr int kLineHeight = 14;
+constexpr int kMargin = 4;
+constexpr int kNameWidth = 70;
+constexpr int kBarWidth = 120;
+constexpr int kOverlayWidth = 330;
+// Bars are full when a phase takes a whole frame at 60 FPS.
+constexpr double kBudgetMs = 1000.0 / 60;
+
+int BarLength(const absl::Duration duration) {
+  const double fraction = absl::ToDoubleMilliseconds(duration) / kBudgetMs;
+  return static_cast<int>(std::min(fraction, 1.0) * kBarWidth);
+}
+
+}  // namespace
+
+void DrawProfilerOverlay(const internal::FrameProfiler& profiler) {
+  const internal::FrameCounters& counters = profiler.last_counters();
+  const int height = kLineHeight * (2 + internal::kNumFramePhases) + kMargin;
+  DrawRectangle(0, 0, kOverlayWidth, height, Fade(BLACK, 0.6f));
+  DrawText(TextFormat("%d FPS  %d objects  %d draw calls", GetFPS(),
+                      counters.objects, counters.draw_calls),
+           kMargin, kMargin, kFontSize, LIME);
+  DrawText(TextFormat("%d hit box tests  %d contacts", counters.hit_box_tests,
+                      counters.contacts),
+           kMargin, kMargin + kLineHeight, kFontSize, LIME);
+  for (size_t i = 0; i < internal::kNumFramePhases; ++i) {
+    const FramePhase phase = static_cast<FramePhase>(i);
+    const internal::PhaseSummary summary = profiler.Summarize(phase);
+    const int y = kMargin + kLineHeight * static_cast<int>(2 + i);
+    // Names are string literals, so they are null terminated.
+    DrawText(internal::FramePhaseName(phase).data(), kMargin, y, kFontSize,
+             RAYWHITE);
+    const int bar_x = kMargin + kNameWidth;
+    // p99 behind avg, min as a line on top.
+    DrawRectangle(bar_x, y, BarLength(summary.p99), kFontSize, MAROON);
+    DrawRectangle(bar_x, y, BarLength(summary.avg), kFontSize, ORANGE);
+    DrawRectangle(bar_x + BarLength(summary.min), y, 1, kFontSize, RAYWHITE);
+    DrawText(TextFormat("%.2f/%.2f/%.2f ms",
+                        absl::ToDoubleMilliseconds(summary.min),
+                        absl::ToDoubleMilliseconds(summary.avg),
+                        absl::ToDoubleMilliseconds(summary.p99)),
+             bar_x + kBarWidth + kMargin, y, kFontSize, RAYWHITE);
+  }
+}
+
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,17 @@
+#ifndef LIB_API_PROFILER_OVERLAY_H
+#define LIB_API_PROFILER_OVERLAY_H
+
+#include "lib/internal/frame_profiler.h"
+
+namespace lib {
+namespace api {
+
+// Draws the FPS, the counters of the last frame and a bar for every phase of
+// `profiler` in the top left corner: min, avg and p99 over the profiled
+// frames, against the budget of a 60 FPS frame.
+void DrawProfilerOverlay(const internal::FrameProfiler& profiler);
+
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_PROFILER_OVERLAY_H
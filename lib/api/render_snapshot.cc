@@ -0,0 +1,86 @@
+#include "raylib/include/raylib.h"
+#include "raylib/include/rlgl.h"
+
+#include "lib/api/render_snapshot.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+
+#include "lib/api/common_types.h"
+
+namespace lib {
+namespace api {
+
+RenderSnapshot::~RenderSnapshot() { DestroyCustomDraws(); }
+
+void RenderSnapshot::Clear() {
+  DestroyCustomDraws();
+  arena_.Reset();
+  items_.clear();
+  alpha_ = 1;
+  camera_target_ = std::nullopt;
+}
+
+RenderItem& RenderSnapshot::Add(const int y_base,
+                                const WorldPosition previous_center,
+                                const WorldPosition center) {
+  return items_.emplace_back(RenderItem{.y_base = y_base,
+                                        .previous_center = previous_center,
+                                        .center = center});
+}
+
+void RenderSnapshot::Finish() {
+  // `std::stable_sort` allocates its buffer on the heap. Sorting by the index
+  // as well keeps the order of equal `y_base`s without it.
+  std::pmr::vector<std::pair<int, uint32_t>> order(&arena_);
+  order.reserve(items_.size());
+  for (uint32_t i = 0; i < items_.size(); ++i) {
+    order.emplace_back(items_[i].y_base, i);
+  }
+  std::ranges::sort(order);
+  sorted_items_.clear();
+  for (const auto& [y_base, i] : order) {
+    sorted_items_.push_back(items_[i]);
+  }
+  items_.swap(sorted_items_);
+}
+
+void RenderSnapshot::Draw() const {
+  for (const RenderItem& item : items_) {
+    const float offset_x =
+        (item.previous_center.x - item.center.x) * (1 - alpha_);
+    const float offset_y =
+        (item.previous_center.y - item.center.y) * (1 - alpha_);
+    const bool is_moved = offset_x != 0 || offset_y != 0;
+    // Everything is drawn at the current center, shifts it back to where the
+    // item is between the two steps.
+    if (is_moved) {
+      rlPushMatrix();
+      rlTranslatef(offset_x, offset_y, 0);
+    }
+    if (item.sprite != nullptr) {
+      item.sprite->RotateAndDraw(item.center, /*degree=*/0, item.frame);
+    }
+    if (item.hit_box.has_value()) {
+      item.hit_box->Draw();
+    }
+    if (item.custom_draw.draw != nullptr) {
+      item.custom_draw.draw(item.custom_draw.payload);
+    }
+    if (is_moved) {
+      rlPopMatrix();
+    }
+  }
+}
+
+void RenderSnapshot::DestroyCustomDraws() {
+  for (const Destructor& destructor : destructors_) {
+    destructor.destroy(destructor.payload);
+  }
+  destructors_.clear();
+}
+
+}  // namespace api
+}  // namespace lib
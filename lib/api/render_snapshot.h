@@ -0,0 +1,118 @@
+#ifndef LIB_API_RENDER_SNAPSHOT_H
+#define LIB_API_RENDER_SNAPSHOT_H
+
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "lib/api/common_types.h"
+#include "lib/api/sprites/sprite.h"
+#include "lib/internal/frame_arena.h"
+#include "lib/internal/hit_box.h"
+
+namespace lib {
+namespace api {
+
+// Drawing stored in the memory of a snapshot, see
+// `RenderSnapshot::SetCustomDraw`.
+struct CustomDraw {
+  void (*draw)(const void* payload) = nullptr;
+  const void* payload = nullptr;
+};
+
+// What a single object looked like at the end of a simulated frame.
+struct RenderItem {
+  // Items are drawn in increasing order of it, bottom most last.
+  int y_base;
+  // Center before and after the last simulation step, the item is drawn in
+  // between.
+  WorldPosition previous_center;
+  WorldPosition center;
+  // Drawn at `center` when set. Sprites are owned by the sprite factory and
+  // outlive every level.
+  absl::Nullable<const sprites::Sprite*> sprite = nullptr;
+  int frame = 0;
+  std::optional<internal::HitBox> hit_box;
+  // Anything else the object draws, relative to `center`.
+  CustomDraw custom_draw;
+};
+
+// Copy of everything a level draws in a frame. Written by the simulation and
+// read by the renderer, which never has to touch `objects::Object` - so the
+// next frame can be simulated while this one is drawn.
+class RenderSnapshot {
+ public:
+  RenderSnapshot() = default;
+  ~RenderSnapshot();
+
+  RenderSnapshot(const RenderSnapshot&) = delete;
+  RenderSnapshot& operator=(const RenderSnapshot&) = delete;
+
+  // Keeps the memory of the items to be reused by the next frame.
+  void Clear();
+  // The returned item is valid until the next `Add`.
+  RenderItem& Add(int y_base, WorldPosition previous_center,
+                  WorldPosition center);
+  // Copies `draw` into the snapshot, it is called when `item` is drawn and
+  // destroyed by `Clear`. Must only use values copied out of the object. Does
+  // not allocate on the heap once the snapshot has seen a frame as large.
+  template <typename DrawFn>
+  void SetCustomDraw(RenderItem& item, DrawFn draw) {
+    void* const memory = arena_.allocate(sizeof(DrawFn), alignof(DrawFn));
+    DrawFn* const payload = new (memory) DrawFn(std::move(draw));
+    if constexpr (!std::is_trivially_destructible_v<DrawFn>) {
+      destructors_.push_back(
+          {.destroy = [](const void* payload) {
+             static_cast<const DrawFn*>(payload)->~DrawFn();
+           },
+           .payload = payload});
+    }
+    item.custom_draw = {.draw = [](const void* payload) {
+                          (*static_cast<const DrawFn*>(payload))();
+                        },
+                        .payload = payload};
+  }
+  // Orders the items for drawing, called once every item has been added.
+  // Items with the same `y_base` keep the order they were added in.
+  void Finish();
+  // Issues the raylib calls for every item, `alpha` of the way from its
+  // previous center to its current one.
+  void Draw() const;
+
+  [[nodiscard]] const std::vector<RenderItem>& items() const { return items_; }
+  [[nodiscard]] float alpha() const { return alpha_; }
+  // Not set when the camera is not bound to any object.
+  [[nodiscard]] std::optional<WorldPosition> camera_target() const {
+    return camera_target_;
+  }
+
+  void set_alpha(const float alpha) { alpha_ = alpha; }
+  void set_camera_target(const std::optional<WorldPosition> camera_target) {
+    camera_target_ = camera_target;
+  }
+
+ private:
+  struct Destructor {
+    void (*destroy)(const void* payload);
+    const void* payload;
+  };
+
+  void DestroyCustomDraws();
+
+  std::vector<RenderItem> items_;
+  // Reused by `Finish` to avoid allocating every frame.
+  std::vector<RenderItem> sorted_items_;
+  // Custom draw payloads and the scratch space of `Finish`.
+  internal::FrameArena arena_;
+  std::vector<Destructor> destructors_;
+  float alpha_ = 1;
+  std::optional<WorldPosition> camera_target_;
+};
+
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_RENDER_SNAPSHOT_H
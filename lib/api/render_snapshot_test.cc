@@ -0,0 +1,59 @@
+#include "lib/api/render_snapshot.h"
+
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+
+namespace lib {
+namespace api {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(RenderSnapshotTest, DrawsItemsByYBase) {
+  RenderSnapshot snapshot;
+  std::vector<int> drawn;
+  for (const int id : {0, 1, 2, 3}) {
+    const int y_base = id == 2 ? -10 : id % 2;
+    snapshot.SetCustomDraw(snapshot.Add(y_base, {0, 0}, {0, 0}),
+                           [id, &drawn]() { drawn.push_back(id); });
+  }
+
+  snapshot.Finish();
+  snapshot.Draw();
+
+  EXPECT_THAT(drawn, ElementsAre(2, 0, 1, 3));
+}
+
+TEST(RenderSnapshotTest, Clear) {
+  RenderSnapshot snapshot;
+  snapshot.Add(/*y_base=*/0, {1, 1}, {2, 2});
+  snapshot.set_alpha(0.5f);
+  snapshot.set_camera_target(WorldPosition{2, 2});
+
+  snapshot.Clear();
+
+  EXPECT_THAT(snapshot.items(), IsEmpty());
+  EXPECT_EQ(snapshot.alpha(), 1);
+  EXPECT_EQ(snapshot.camera_target(), std::nullopt);
+}
+
+TEST(RenderSnapshotTest, ClearDestroysCustomDraws) {
+  RenderSnapshot snapshot;
+  const auto payload = std::make_shared<int>(1);
+  snapshot.SetCustomDraw(snapshot.Add(/*y_base=*/0, {0, 0}, {0, 0}),
+                         [payload]() {});
+  EXPECT_EQ(payload.use_count(), 2);
+
+  snapshot.Clear();
+
+  EXPECT_EQ(payload.use_count(), 1);
+}
+
+}  // namespace
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,34 @@
+#include "lib/api/scripted_controls.h"
+
+#include <algorithm>
+
+#include "lib/api/common_types.h"
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+
+bool ScriptedControls::IsPressed(const Button button) const {
+  return std::ranges::find(script_->current().pressed, button) !=
+         script_->current().pressed.end();
+}
+
+bool ScriptedControls::IsDown(const Button button) const {
+  return std::ranges::find(script_->current().down, button) !=
+         script_->current().down.end();
+}
+
+bool ScriptedControls::IsPrimaryPressed() const {
+  return script_->current().primary_pressed;
+}
+
+bool ScriptedControls::IsSecondaryPressed() const {
+  return script_->current().secondary_pressed;
+}
+
+ScreenPosition ScriptedControls::GetCursorPos() const {
+  return script_->current().cursor_pos;
+}
+
+}  // namespace api
+}  // namespace lib
@@ -0,0 +1,56 @@
+#ifndef LIB_API_SCRIPTED_CONTROLS_H
+#define LIB_API_SCRIPTED_CONTROLS_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lib/api/common_types.h"
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+
+// Input of every step of a run without a window, see `Level::RunHeadless`.
+// Shared by the `ScriptedControls` of a level and of its abilities, so all of
+// them see the same step. Steps past the end of the script have no input.
+class InputScript {
+ public:
+  explicit InputScript(std::vector<ScriptedInput> steps)
+      : steps_(std::move(steps)) {}
+
+  // Moves on to the input of the next step.
+  void Advance() { ++step_; }
+  [[nodiscard]] const ScriptedInput& current() const {
+    return step_ < steps_.size() ? steps_[step_] : no_input_;
+  }
+  [[nodiscard]] size_t step() const { return step_; }
+
+ private:
+  const std::vector<ScriptedInput> steps_;
+  const ScriptedInput no_input_;
+  size_t step_ = 0;
+};
+
+// Reports the input of the current step of `script`, instead of what raylib
+// has collected.
+class ScriptedControls : public ControlsInterface {
+ public:
+  explicit ScriptedControls(std::shared_ptr<const InputScript> script)
+      : script_(std::move(script)) {}
+
+  [[nodiscard]] bool IsPressed(Button button) const override;
+  [[nodiscard]] bool IsDown(Button button) const override;
+  [[nodiscard]] bool IsPrimaryPressed() const override;
+  [[nodiscard]] bool IsSecondaryPressed() const override;
+  [[nodiscard]] ScreenPosition GetCursorPos() const override;
+
+ private:
+  const std::shared_ptr<const InputScript> script_;
+};
+
+}  // namespace api
+}  // namespace lib
+
+#endif  // LIB_API_SCRIPTED_CONTROLS_H
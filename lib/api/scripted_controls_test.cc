@@ -0,0 +1,51 @@
+#include "lib/api/scripted_controls.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lib/api/common_types.h"
+#include "lib/api/controls.h"
+
+namespace lib {
+namespace api {
+namespace {
+
+TEST(ScriptedControlsTest, ReportsCurrentStep) {
+  const std::shared_ptr<InputScript> script = std::make_shared<InputScript>(
+      std::vector<ScriptedInput>{{.pressed = {kKeySpace},
+                                  .down = {kKeyA, kKeyW},
+                                  .primary_pressed = true,
+                                  .cursor_pos = {.x = 3, .y = 4}},
+                                 {.down = {kKeyD}, .secondary_pressed = true}});
+  const ScriptedControls controls(script);
+  const ScriptedControls ability_controls(script);
+
+  EXPECT_TRUE(controls.IsPressed(kKeySpace));
+  EXPECT_FALSE(controls.IsPressed(kKeyA));
+  EXPECT_TRUE(controls.IsDown(kKeyW));
+  EXPECT_TRUE(controls.IsPrimaryPressed());
+  EXPECT_FALSE(controls.IsSecondaryPressed());
+  EXPECT_EQ(controls.GetCursorPos(), (ScreenPosition{.x = 3, .y = 4}));
+  script->Advance();
+  EXPECT_FALSE(ability_controls.IsPressed(kKeySpace));
+  EXPECT_TRUE(ability_controls.IsDown(kKeyD));
+  EXPECT_TRUE(ability_controls.IsSecondaryPressed());
+  EXPECT_EQ(script->step(), 1);
+}
+
+TEST(ScriptedControlsTest, NoInputAfterScript) {
+  const std::shared_ptr<InputScript> script = std::make_shared<InputScript>(
+      std::vector<ScriptedInput>{{.down = {kKeyD}}});
+  const ScriptedControls controls(script);
+
+  script->Advance();
+  script->Advance();
+
+  EXPECT_FALSE(controls.IsDown(kKeyD));
+  EXPECT_FALSE(controls.IsPrimaryPressed());
+}
+
+}  // namespace
+}  // namespace api
+}  // namespace lib
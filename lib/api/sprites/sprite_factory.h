@@ -14,6 +14,7 @@ namespace lib {
 namespace api {
 
 class Game;
+class LevelAllocationTest;
 class LevelTest;
 
 namespace objects {
@@ -42,6 +43,7 @@ class SpriteFactory {
 
  private:
   friend class lib::api::Game;
+  friend class lib::api::LevelAllocationTest;
   friend class lib::api::LevelTest;
   friend class SpriteTest;
   friend class objects::StaticObjectTest;
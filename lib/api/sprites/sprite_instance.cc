@@ -26,8 +26,21 @@ SpriteInstance::SpriteInstance(const Sprite* sprite,
 
 void SpriteInstance::DrawInternal(const WorldPosition draw_destination,
                                   const int rotation_degree) {
+  sprite_->RotateAndDraw(draw_destination, rotation_degree, AdvanceFrame());
+}
+
+void SpriteInstance::Draw(const WorldPosition draw_destination) {
+  DrawInternal(draw_destination, /*rotation_degree=*/0);
+}
+
+void SpriteInstance::RotateAndDraw(const WorldPosition draw_destination,
+                                   const int rotation_degree) {
+  DrawInternal(draw_destination, rotation_degree);
+}
+
+int SpriteInstance::AdvanceFrame() {
   if (!is_animation_) {
-    sprite_->RotateAndDraw(draw_destination, rotation_degree);
+    return 0;
   }
 
   const absl::Time now = absl::Now();
@@ -42,17 +55,7 @@ void SpriteInstance::DrawInternal(const WorldPosition draw_destination,
     first_time_current_frame_was_drawn_ = now;
   }
 
-  sprite_->RotateAndDraw(draw_destination, rotation_degree,
-                         current_frame_to_draw_);
-}
-
-void SpriteInstance::Draw(const WorldPosition draw_destination) {
-  DrawInternal(draw_destination, /*rotation_degree=*/0);
-}
-
-void SpriteInstance::RotateAndDraw(const WorldPosition draw_destination,
-                                   const int rotation_degree) {
-  DrawInternal(draw_destination, rotation_degree);
+  return current_frame_to_draw_;
 }
 
 void SpriteInstance::Reset() {
@@ -19,6 +19,10 @@ class SpriteInstance {
   void Draw(WorldPosition draw_destination);
   void RotateAndDraw(WorldPosition draw_destination, int rotation_degree);
   void Reset();
+  // Advances the animation the same way drawing does and returns the frame to
+  // draw, for drawing `sprite()` later on.
+  int AdvanceFrame();
+  [[nodiscard]] const Sprite* sprite() const { return sprite_; }
   [[nodiscard]] int SpriteWidth() const;
   [[nodiscard]] int SpriteHeight() const;
   [[nodiscard]] const GraphicsInterface* GraphicsForTesting() const;
@@ -1,8 +1,11 @@
 #include "lib/api/stats.h"
 
 #include <optional>
+#include <utility>
 
 #include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "lib/api/objects/contact_list.h"
 #include "lib/api/objects/object_type.h"
 
 namespace lib {
@@ -20,6 +23,25 @@ void Stats::AddCollision(objects::ObjectType type_1,
   collisions_it_->second.last_collision_time = absl::Now();
 }
 
+void Stats::AddCollisions(const absl::Span<const objects::Contact> contacts) {
+  const absl::Time now = absl::Now();
+  CollisionData* data = nullptr;
+  for (size_t i = 0; i < contacts.size(); ++i) {
+    if (i == 0 || contacts[i].type != contacts[i - 1].type ||
+        contacts[i].other_type != contacts[i - 1].other_type) {
+      objects::ObjectType type_1 = contacts[i].type;
+      objects::ObjectType type_2 = contacts[i].other_type;
+      if (type_2 < type_1) {
+        std::swap(type_1, type_2);
+      }
+      data = &collisions_.try_emplace({type_1, type_2}, CollisionData{})
+                  .first->second;
+    }
+    data->collision_count++;
+    data->last_collision_time = now;
+  }
+}
+
 std::optional<absl::Time> Stats::GetLastCollisionTime(
     objects::ObjectType type_1, objects::ObjectType type_2) {
   if (type_2 < type_1) {
@@ -5,6 +5,8 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "lib/api/objects/contact_list.h"
 #include "lib/api/objects/object_type.h"
 
 namespace lib {
@@ -12,7 +14,12 @@ namespace api {
 
 class Stats {
  public:
+  Stats() = default;
+
   void AddCollision(objects::ObjectType type_1, objects::ObjectType type_2);
+  // Adds every contact of a frame, contacts sorted by type pair need a single
+  // lookup per type pair.
+  void AddCollisions(absl::Span<const objects::Contact> contacts);
   std::optional<absl::Time> GetLastCollisionTime(objects::ObjectType type_1,
                                                  objects::ObjectType type_2);
   int GetCollisionCount(objects::ObjectType type_1, objects::ObjectType type_2);
@@ -20,7 +27,6 @@ class Stats {
  private:
   friend class Game;
   friend class StatsTest;
-  Stats() = default;
 
   struct CollisionData {
     int collision_count = 0;
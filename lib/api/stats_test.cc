@@ -1,8 +1,11 @@
 #include "lib/api/stats.h"
 
+#include <vector>
+
 #include "absl/time/time.h"
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
+#include "lib/api/objects/contact_list.h"
 #include "lib/api/objects/object_type.h"
 
 namespace lib {
@@ -47,6 +50,28 @@ TEST_F(StatsTest, AddCollisionAlreadyExists) {
   EXPECT_EQ(stats_.GetCollisionCount(type_1, type_2), 2);
 }
 
+TEST_F(StatsTest, AddCollisions) {
+  const ObjectType type_1 = object_type_factory_.MakeNewObjectType();
+  const ObjectType type_2 = object_type_factory_.MakeNewObjectType();
+  const ObjectType type_3 = object_type_factory_.MakeNewObjectType();
+  const auto make_contact = [](const ObjectType type,
+                               const ObjectType other_type) {
+    return objects::Contact{.object = nullptr,
+                            .other = nullptr,
+                            .type = type,
+                            .other_type = other_type};
+  };
+  const std::vector<objects::Contact> contacts = {
+      make_contact(type_1, type_2), make_contact(type_1, type_2),
+      make_contact(type_1, type_3), make_contact(type_2, type_1)};
+
+  stats_.AddCollisions(contacts);
+
+  EXPECT_EQ(stats_.GetCollisionCount(type_1, type_2), 3);
+  EXPECT_EQ(stats_.GetCollisionCount(type_3, type_1), 1);
+  EXPECT_TRUE(stats_.GetLastCollisionTime(type_1, type_3).has_value());
+}
+
 TEST_F(StatsTest, GetLastCollisionTimeFirst) {
   const ObjectType type_1 = object_type_factory_.MakeNewObjectType();
   const ObjectType type_2 = object_type_factory_.MakeNewObjectType();
@@ -67,7 +67,7 @@ class TitleScreenLevelBuilder : LevelBuilder<TitleScreenLevel> {
     CHECK(level_->start_button_ != nullptr) << "Start button not added.";
     CHECK(level_->exit_button_ != nullptr) << "Exit button not added.";
 
-    return std::move(level_);
+    return LevelBuilder::Build();
   }
 };
 
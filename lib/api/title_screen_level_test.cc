@@ -124,11 +124,8 @@ TEST_F(TitleScreenLevelTest, StartAndExitAddedOk) {
           .Build();
 
   ASSERT_EQ(level->objects_.size(), 2);
-  auto it = level->objects_.begin();
-  EXPECT_EQ((*it)->type(), kStartButton);
-  ++it;
-  EXPECT_EQ((*it)->type(), kExitButton);
-  EXPECT_EQ(level->abilities_.size(), 2);
+  EXPECT_EQ(level->object_pointers_[0]->type(), kStartButton);
+  EXPECT_EQ(level->object_pointers_[1]->type(), kExitButton);
 }
 
 }  // namespace api
@@ -0,0 +1,289 @@
+#include "lib/internal/aabb_tree.h"
+
+#include <algorithm>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+// Depth of a balanced tree with millions of proxies, deeper trees spill to the
+// heap.
+constexpr size_t kInlineStackSize = 64;
+
+}  // namespace
+
+AabbTree::AabbTree(const float fat_margin)
+    : fat_margin_(fat_margin), root_(kNullNode), free_list_(kNullNode) {
+  CHECK(fat_margin_ >= 0) << "Negative fat margin: " << fat_margin_;
+}
+
+int AabbTree::height() const {
+  return root_ == kNullNode ? 0 : nodes_[root_].height;
+}
+
+int AabbTree::AllocateNode() {
+  int node = free_list_;
+  if (node == kNullNode) {
+    node = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+  } else {
+    free_list_ = nodes_[node].parent;
+  }
+  nodes_[node].parent = kNullNode;
+  nodes_[node].left = kNullNode;
+  nodes_[node].right = kNullNode;
+  nodes_[node].height = 0;
+  return node;
+}
+
+void AabbTree::FreeNode(const int node) {
+  nodes_[node].parent = free_list_;
+  nodes_[node].height = -1;
+  free_list_ = node;
+}
+
+void AabbTree::Insert(const ProxyId id, const Aabb& aabb) {
+  CHECK(!leaves_.contains(id)) << "Proxy " << id << " is already in the tree.";
+  const int leaf = AllocateNode();
+  nodes_[leaf].aabb = aabb;
+  nodes_[leaf].fat_aabb = aabb.Expand(fat_margin_);
+  nodes_[leaf].id = id;
+  leaves_[id] = leaf;
+  InsertLeaf(leaf);
+}
+
+void AabbTree::Update(const ProxyId id, const Aabb& aabb) {
+  const auto it = leaves_.find(id);
+  CHECK(it != leaves_.end()) << "Proxy " << id << " is not in the tree.";
+  const int leaf = it->second;
+  nodes_[leaf].aabb = aabb;
+  if (nodes_[leaf].fat_aabb.Contains(aabb)) {
+    return;
+  }
+
+  RemoveLeaf(leaf);
+  nodes_[leaf].fat_aabb = aabb.Expand(fat_margin_);
+  InsertLeaf(leaf);
+}
+
+void AabbTree::Remove(const ProxyId id) {
+  const auto it = leaves_.find(id);
+  CHECK(it != leaves_.end()) << "Proxy " << id << " is not in the tree.";
+  RemoveLeaf(it->second);
+  FreeNode(it->second);
+  leaves_.erase(it);
+}
+
+void AabbTree::Query(const Aabb& aabb,
+                     const absl::FunctionRef<void(ProxyId)> callback) const {
+  if (root_ == kNullNode) {
+    return;
+  }
+
+  absl::InlinedVector<int, kInlineStackSize> stack = {root_};
+  while (!stack.empty()) {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+    if (!node.fat_aabb.Overlaps(aabb)) {
+      continue;
+    }
+    if (node.IsLeaf()) {
+      if (node.aabb.Overlaps(aabb)) {
+        callback(node.id);
+      }
+      continue;
+    }
+    stack.push_back(node.left);
+    stack.push_back(node.right);
+  }
+}
+
+void AabbTree::QueryRay(const Ray& ray, const float thickness,
+                        const absl::FunctionRef<void(ProxyId)> callback) const {
+  if (root_ == kNullNode) {
+    return;
+  }
+
+  absl::InlinedVector<int, kInlineStackSize> stack = {root_};
+  while (!stack.empty()) {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+    if (!Raycast(ray, node.fat_aabb.Expand(thickness)).has_value()) {
+      continue;
+    }
+    if (node.IsLeaf()) {
+      if (Raycast(ray, node.aabb.Expand(thickness)).has_value()) {
+        callback(node.id);
+      }
+      continue;
+    }
+    stack.push_back(node.left);
+    stack.push_back(node.right);
+  }
+}
+
+void AabbTree::QueryPairs(
+    const absl::FunctionRef<void(ProxyId, ProxyId)> callback) const {
+  for (const auto& [id, leaf] : leaves_) {
+    Query(nodes_[leaf].aabb, [id, &callback](const ProxyId other_id) {
+      // Every pair is found from both of its proxies, report it once.
+      if (id < other_id) {
+        callback(id, other_id);
+      }
+    });
+  }
+}
+
+void AabbTree::InsertLeaf(const int leaf) {
+  if (root_ == kNullNode) {
+    root_ = leaf;
+    nodes_[root_].parent = kNullNode;
+    return;
+  }
+
+  // Walk down choosing the child which grows the least (surface area
+  // heuristic), or stop when making a new sibling here is cheaper.
+  const Aabb leaf_aabb = nodes_[leaf].fat_aabb;
+  int sibling = root_;
+  while (!nodes_[sibling].IsLeaf()) {
+    const Node& node = nodes_[sibling];
+    const float area = node.fat_aabb.Perimeter();
+    const float combined_area = node.fat_aabb.Union(leaf_aabb).Perimeter();
+    const float cost = 2 * combined_area;
+    const float inheritance_cost = 2 * (combined_area - area);
+    const auto descend_cost = [&](const int child) {
+      const Aabb& child_aabb = nodes_[child].fat_aabb;
+      const float union_area = child_aabb.Union(leaf_aabb).Perimeter();
+      if (nodes_[child].IsLeaf()) {
+        return union_area + inheritance_cost;
+      }
+      return union_area - child_aabb.Perimeter() + inheritance_cost;
+    };
+    const float cost_left = descend_cost(node.left);
+    const float cost_right = descend_cost(node.right);
+    if (cost < cost_left && cost < cost_right) {
+      break;
+    }
+    sibling = cost_left < cost_right ? node.left : node.right;
+  }
+
+  const int old_parent = nodes_[sibling].parent;
+  const int new_parent = AllocateNode();
+  nodes_[new_parent].parent = old_parent;
+  nodes_[new_parent].left = sibling;
+  nodes_[new_parent].right = leaf;
+  nodes_[new_parent].fat_aabb = leaf_aabb.Union(nodes_[sibling].fat_aabb);
+  nodes_[new_parent].height = nodes_[sibling].height + 1;
+  if (old_parent == kNullNode) {
+    root_ = new_parent;
+  } else {
+    ReplaceChild(old_parent, sibling, new_parent);
+  }
+  nodes_[sibling].parent = new_parent;
+  nodes_[leaf].parent = new_parent;
+
+  FixUpwards(new_parent);
+}
+
+void AabbTree::RemoveLeaf(const int leaf) {
+  if (leaf == root_) {
+    root_ = kNullNode;
+    return;
+  }
+
+  const int parent = nodes_[leaf].parent;
+  const int grand_parent = nodes_[parent].parent;
+  const int sibling = nodes_[parent].left == leaf ? nodes_[parent].right
+                                                  : nodes_[parent].left;
+  FreeNode(parent);
+  if (grand_parent == kNullNode) {
+    root_ = sibling;
+    nodes_[sibling].parent = kNullNode;
+    return;
+  }
+
+  ReplaceChild(grand_parent, parent, sibling);
+  nodes_[sibling].parent = grand_parent;
+  FixUpwards(grand_parent);
+}
+
+void AabbTree::ReplaceChild(const int parent, const int old_child,
+                            const int new_child) {
+  if (nodes_[parent].left == old_child) {
+    nodes_[parent].left = new_child;
+  } else {
+    nodes_[parent].right = new_child;
+  }
+}
+
+void AabbTree::FixUpwards(int node) {
+  while (node != kNullNode) {
+    node = Balance(node);
+    Node& current = nodes_[node];
+    const Node& left = nodes_[current.left];
+    const Node& right = nodes_[current.right];
+    current.height = 1 + std::max(left.height, right.height);
+    current.fat_aabb = left.fat_aabb.Union(right.fat_aabb);
+    node = current.parent;
+  }
+}
+
+int AabbTree::Balance(const int a) {
+  if (nodes_[a].IsLeaf() || nodes_[a].height < 2) {
+    return a;
+  }
+
+  const int b = nodes_[a].left;
+  const int c = nodes_[a].right;
+  const int balance = nodes_[c].height - nodes_[b].height;
+  if (-1 <= balance && balance <= 1) {
+    return a;
+  }
+
+  // Rotates `up` (a child of `a`) one level up, `a` becomes its left child
+  // and keeps the shorter child of `up`.
+  const auto rotate = [this, a](const int up, const int stay) {
+    Node& node_a = nodes_[a];
+    Node& node_up = nodes_[up];
+    const int f = node_up.left;
+    const int g = node_up.right;
+    node_up.left = a;
+    node_up.parent = node_a.parent;
+    node_a.parent = up;
+    if (node_up.parent == kNullNode) {
+      root_ = up;
+    } else {
+      ReplaceChild(node_up.parent, a, up);
+    }
+
+    const int taller = nodes_[f].height > nodes_[g].height ? f : g;
+    const int shorter = taller == f ? g : f;
+    node_up.right = taller;
+    if (node_a.left == up) {
+      node_a.left = shorter;
+    } else {
+      node_a.right = shorter;
+    }
+    nodes_[shorter].parent = a;
+    node_a.fat_aabb = nodes_[stay].fat_aabb.Union(nodes_[shorter].fat_aabb);
+    node_up.fat_aabb = node_a.fat_aabb.Union(nodes_[taller].fat_aabb);
+    node_a.height = 1 + std::max(nodes_[stay].height, nodes_[shorter].height);
+    node_up.height = 1 + std::max(node_a.height, nodes_[taller].height);
+    return up;
+  };
+
+  if (balance > 1) {
+    return rotate(/*up=*/c, /*stay=*/b);
+  }
+  return rotate(/*up=*/b, /*stay=*/c);
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,90 @@
+#ifndef LIB_INTERNAL_AABB_TREE_H
+#define LIB_INTERNAL_AABB_TREE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "gtest/gtest_prod.h"
+#include "lib/internal/broadphase.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+/*
+ * Dynamic AABB tree (bounding volume hierarchy) broadphase. Unlike the
+ * `SpatialHashGrid` it does not depend on object sizes, so huge objects (e.g.
+ * world borders) and tiny projectiles can be mixed freely.
+ *
+ * Leaves store a "fat" box which is larger than the proxy by `fat_margin`, a
+ * proxy moving a few units per frame stays inside of it and the tree does not
+ * need to be touched at all. Once it escapes, the leaf is reinserted. The tree
+ * is kept balanced with rotations.
+ */
+class AabbTree : public Broadphase {
+ public:
+  static constexpr float kDefaultFatMargin = 16;
+
+  explicit AabbTree(float fat_margin = kDefaultFatMargin);
+
+  void Insert(ProxyId id, const Aabb& aabb) override;
+  void Update(ProxyId id, const Aabb& aabb) override;
+  void Remove(ProxyId id) override;
+  void Query(const Aabb& aabb,
+             absl::FunctionRef<void(ProxyId)> callback) const override;
+  void QueryRay(const Ray& ray, float thickness,
+                absl::FunctionRef<void(ProxyId)> callback) const override;
+  void QueryPairs(
+      absl::FunctionRef<void(ProxyId, ProxyId)> callback) const override;
+
+  [[nodiscard]] bool Contains(ProxyId id) const override {
+    return leaves_.contains(id);
+  }
+  [[nodiscard]] size_t size() const override { return leaves_.size(); }
+  // Height of the tree, a tree with a single leaf has height 0.
+  [[nodiscard]] int height() const;
+
+ private:
+  static constexpr int kNullNode = -1;
+
+  struct Node {
+    [[nodiscard]] bool IsLeaf() const { return left == kNullNode; }
+
+    // Fat box for leaves, union of the children for internal nodes.
+    Aabb fat_aabb;
+    // Exact box of the proxy, only set for leaves.
+    Aabb aabb;
+    // Next free node when the node is not used.
+    int parent;
+    int left;
+    int right;
+    int height;
+    ProxyId id;
+  };
+
+  [[nodiscard]] int AllocateNode();
+  void FreeNode(int node);
+  void InsertLeaf(int leaf);
+  void RemoveLeaf(int leaf);
+  // Recomputes boxes and heights from `node` up to the root.
+  void FixUpwards(int node);
+  // Rotates the subtree if it is imbalanced, returns the new subtree root.
+  [[nodiscard]] int Balance(int node);
+  void ReplaceChild(int parent, int old_child, int new_child);
+
+  FRIEND_TEST(AabbTreeTest, SmallMoveDoesNotRestructure);
+
+  const float fat_margin_;
+  std::vector<Node> nodes_;
+  int root_;
+  int free_list_;
+  absl::flat_hash_map<ProxyId, int> leaves_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_AABB_TREE_H
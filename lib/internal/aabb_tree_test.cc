@@ -0,0 +1,211 @@
+#include "lib/internal/aabb_tree.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+using ProxyPair = std::pair<ProxyId, ProxyId>;
+
+std::vector<ProxyId> QueryAll(const AabbTree& tree, const Aabb& aabb) {
+  std::vector<ProxyId> ids;
+  tree.Query(aabb, [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyId> QueryRayAll(const AabbTree& tree, const Ray& ray,
+                                 const float thickness = 0) {
+  std::vector<ProxyId> ids;
+  tree.QueryRay(ray, thickness,
+              [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyPair> QueryAllPairs(const AabbTree& tree) {
+  std::vector<ProxyPair> pairs;
+  tree.QueryPairs([&pairs](const ProxyId a, const ProxyId b) {
+    pairs.emplace_back(a, b);
+  });
+  return pairs;
+}
+
+}  // namespace
+
+TEST(AabbTreeTest, QueryFindsOverlapping) {
+  AabbTree tree;
+  tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(2, {.min_x = 4, .min_y = 4, .max_x = 25, .max_y = 25});
+  tree.Insert(3, {.min_x = 100, .min_y = 100, .max_x = 105, .max_y = 105});
+
+  EXPECT_THAT(QueryAll(tree, {.min_x = 3, .min_y = 3, .max_x = 6, .max_y = 6}),
+              UnorderedElementsAre(1, 2));
+  // Inside of the fat box, but not overlapping the proxy.
+  EXPECT_THAT(
+      QueryAll(tree, {.min_x = 106, .min_y = 106, .max_x = 110, .max_y = 110}),
+      IsEmpty());
+}
+
+TEST(AabbTreeTest, MixedSizes) {
+  AabbTree tree;
+  tree.Insert(1, {.min_x = 0, .min_y = -1000000, .max_x = 0, .max_y = 1000000});
+  tree.Insert(2, {.min_x = -4, .min_y = 500, .max_x = 4, .max_y = 508});
+  tree.Insert(3, {.min_x = 10, .min_y = 500, .max_x = 18, .max_y = 508});
+
+  EXPECT_THAT(QueryAllPairs(tree), UnorderedElementsAre(ProxyPair(1, 2)));
+}
+
+TEST(AabbTreeTest, QueryRay) {
+  AabbTree tree;
+  tree.Insert(1, {.min_x = 10, .min_y = -5, .max_x = 20, .max_y = 5});
+  tree.Insert(2, {.min_x = 50, .min_y = -5, .max_x = 60, .max_y = 5});
+  tree.Insert(3, {.min_x = 10, .min_y = 10, .max_x = 20, .max_y = 20});
+  tree.Insert(4, {.min_x = -20, .min_y = -5, .max_x = -10, .max_y = 5});
+
+  EXPECT_THAT(QueryRayAll(tree, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 100}),
+              UnorderedElementsAre(1, 2));
+  EXPECT_THAT(QueryRayAll(tree, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 30}),
+              UnorderedElementsAre(1));
+  EXPECT_THAT(QueryRayAll(tree, {.origin = {0, 8},
+                                .direction = {1, 0},
+                                .max_distance = 100},
+                          /*thickness=*/3),
+              UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(AabbTreeTest, QueryPairs) {
+  AabbTree tree;
+  tree.Insert(3, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(1, {.min_x = 4, .min_y = 4, .max_x = 8, .max_y = 8});
+  tree.Insert(2, {.min_x = 7, .min_y = 7, .max_x = 9, .max_y = 9});
+  tree.Insert(4, {.min_x = 50, .min_y = 50, .max_x = 55, .max_y = 55});
+
+  EXPECT_THAT(QueryAllPairs(tree), UnorderedElementsAre(ProxyPair(1, 3),
+                                                        ProxyPair(1, 2)));
+}
+
+TEST(AabbTreeTest, SmallMoveDoesNotRestructure) {
+  AabbTree tree(/*fat_margin=*/10);
+  tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(2, {.min_x = 50, .min_y = 50, .max_x = 55, .max_y = 55});
+  const Aabb fat_aabb = tree.nodes_[tree.leaves_.at(1)].fat_aabb;
+
+  tree.Update(1, {.min_x = 5, .min_y = 5, .max_x = 10, .max_y = 10});
+
+  EXPECT_EQ(tree.nodes_[tree.leaves_.at(1)].fat_aabb, fat_aabb);
+  EXPECT_THAT(QueryAll(tree, {.min_x = 0, .min_y = 0, .max_x = 1, .max_y = 1}),
+              IsEmpty());
+  EXPECT_THAT(QueryAll(tree, {.min_x = 9, .min_y = 9, .max_x = 9, .max_y = 9}),
+              UnorderedElementsAre(1));
+}
+
+TEST(AabbTreeTest, BigMoveReinserts) {
+  AabbTree tree(/*fat_margin=*/10);
+  tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(2, {.min_x = 50, .min_y = 50, .max_x = 55, .max_y = 55});
+
+  tree.Update(1, {.min_x = 51, .min_y = 51, .max_x = 52, .max_y = 52});
+
+  EXPECT_THAT(QueryAll(tree, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+              IsEmpty());
+  EXPECT_THAT(QueryAllPairs(tree), UnorderedElementsAre(ProxyPair(1, 2)));
+}
+
+TEST(AabbTreeTest, Remove) {
+  AabbTree tree;
+  tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(2, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  tree.Insert(3, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  tree.Remove(2);
+
+  EXPECT_FALSE(tree.Contains(2));
+  EXPECT_EQ(tree.size(), 2);
+  EXPECT_THAT(QueryAll(tree, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+              UnorderedElementsAre(1, 3));
+
+  tree.Remove(1);
+  tree.Remove(3);
+
+  EXPECT_EQ(tree.height(), 0);
+  EXPECT_THAT(QueryAll(tree, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+              IsEmpty());
+}
+
+TEST(AabbTreeTest, StaysBalanced) {
+  AabbTree tree;
+  constexpr int kProxies = 1024;
+  for (int i = 0; i < kProxies; ++i) {
+    const float x = static_cast<float>(i) * 100;
+    tree.Insert(i, {.min_x = x, .min_y = 0, .max_x = x + 8, .max_y = 8});
+  }
+
+  // A perfectly balanced tree has height 10.
+  EXPECT_LE(tree.height(), 20);
+}
+
+TEST(AabbTreeTest, MatchesBruteForce) {
+  AabbTree tree(/*fat_margin=*/4);
+  absl::flat_hash_map<ProxyId, Aabb> proxies;
+  std::mt19937 random(/*seed=*/42);
+  std::uniform_real_distribution<float> position(0, 500);
+  std::uniform_real_distribution<float> size(1, 40);
+  const auto random_aabb = [&]() {
+    const float x = position(random);
+    const float y = position(random);
+    return Aabb{.min_x = x,
+                .min_y = y,
+                .max_x = x + size(random),
+                .max_y = y + size(random)};
+  };
+  for (ProxyId id = 0; id < 200; ++id) {
+    proxies[id] = random_aabb();
+    tree.Insert(id, proxies[id]);
+  }
+  for (ProxyId id = 0; id < 200; id += 3) {
+    proxies[id] = random_aabb();
+    tree.Update(id, proxies[id]);
+  }
+  for (ProxyId id = 1; id < 200; id += 7) {
+    proxies.erase(id);
+    tree.Remove(id);
+  }
+
+  std::vector<ProxyPair> expected_pairs;
+  for (const auto& [a, a_aabb] : proxies) {
+    for (const auto& [b, b_aabb] : proxies) {
+      if (a < b && a_aabb.Overlaps(b_aabb)) {
+        expected_pairs.emplace_back(a, b);
+      }
+    }
+  }
+  EXPECT_THAT(QueryAllPairs(tree),
+              UnorderedElementsAreArray(expected_pairs));
+}
+
+TEST(AabbTreeDeathTest, InsertTwice) {
+  AabbTree tree;
+  tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  EXPECT_DEATH(tree.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+               "already in the tree");
+}
+
+}  // namespace internal
+}  // namespace lib
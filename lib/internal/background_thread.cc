@@ -0,0 +1,65 @@
+#include "lib/internal/background_thread.h"
+
+#include <thread>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+
+namespace lib {
+namespace internal {
+
+BackgroundThread::BackgroundThread() : thread_([this]() { Loop(); }) {}
+
+BackgroundThread::~BackgroundThread() {
+  Wait();
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+  }
+  thread_.join();
+}
+
+void BackgroundThread::Start(absl::AnyInvocable<void() &&> task) {
+  absl::MutexLock lock(&mu_);
+  CHECK(!busy_) << "The previous task has not been waited for.";
+  task_ = std::move(task);
+  busy_ = true;
+}
+
+void BackgroundThread::Wait() {
+  absl::MutexLock lock(&mu_);
+  const auto idle = [this]() {
+    mu_.AssertHeld();
+    return !busy_;
+  };
+  mu_.Await(absl::Condition(&idle));
+}
+
+void BackgroundThread::Loop() {
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    {
+      absl::MutexLock lock(&mu_);
+      const auto has_work = [this]() {
+        mu_.AssertHeld();
+        return stop_ || task_ != nullptr;
+      };
+      mu_.Await(absl::Condition(&has_work));
+      if (stop_) {
+        return;
+      }
+      task = std::move(task_);
+      task_ = nullptr;
+    }
+
+    std::move(task)();
+
+    absl::MutexLock lock(&mu_);
+    busy_ = false;
+  }
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,45 @@
+#ifndef LIB_INTERNAL_BACKGROUND_THREAD_H
+#define LIB_INTERNAL_BACKGROUND_THREAD_H
+
+#include <thread>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+
+namespace lib {
+namespace internal {
+
+// Single thread which runs one task at a time while the thread which started
+// it does other work, e.g. simulates the next frame while the current one is
+// drawn.
+class BackgroundThread {
+ public:
+  BackgroundThread();
+  // Waits for the running task.
+  ~BackgroundThread();
+
+  BackgroundThread(const BackgroundThread&) = delete;
+  BackgroundThread& operator=(const BackgroundThread&) = delete;
+
+  // Runs `task` on the background thread. The task started before has to be
+  // waited for.
+  void Start(absl::AnyInvocable<void() &&> task);
+  // Blocks until the task started last has returned. Everything the task has
+  // written is visible to the caller afterwards.
+  void Wait();
+
+ private:
+  void Loop();
+
+  absl::Mutex mu_;
+  absl::AnyInvocable<void() &&> task_ ABSL_GUARDED_BY(mu_);
+  bool busy_ ABSL_GUARDED_BY(mu_) = false;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_BACKGROUND_THREAD_H
@@ -0,0 +1,62 @@
+#include "lib/internal/background_thread.h"
+
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+TEST(BackgroundThreadTest, RunsTasksOnAnotherThread) {
+  BackgroundThread thread;
+  std::vector<int> done;
+  std::thread::id task_thread;
+
+  for (int i = 0; i < 100; ++i) {
+    thread.Start([&done, &task_thread, i]() {
+      done.push_back(i);
+      task_thread = std::this_thread::get_id();
+    });
+    thread.Wait();
+  }
+
+  ASSERT_EQ(done.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(done[i], i);
+  }
+  EXPECT_NE(task_thread, std::this_thread::get_id());
+}
+
+TEST(BackgroundThreadTest, WaitWithoutTask) {
+  BackgroundThread thread;
+
+  thread.Wait();
+}
+
+TEST(BackgroundThreadTest, DestructorWaitsForTask) {
+  bool done = false;
+  {
+    BackgroundThread thread;
+    thread.Start([&done]() { done = true; });
+  }
+
+  EXPECT_TRUE(done);
+}
+
+TEST(BackgroundThreadDeathTest, StartWhileBusy) {
+  EXPECT_DEATH(
+      {
+        absl::Notification release;
+        BackgroundThread thread;
+        thread.Start([&release]() { release.WaitForNotification(); });
+        thread.Start([]() {});
+      },
+      "The previous task has not been waited for");
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,50 @@
+#ifndef LIB_INTERNAL_BROADPHASE_H
+#define LIB_INTERNAL_BROADPHASE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/functional/function_ref.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+typedef uint32_t ProxyId;
+
+/*
+ * Common interface of the broadphase implementations. A broadphase keeps a
+ * bounding box for every proxy and quickly finds the proxies whose boxes
+ * overlap, so that the exact (and expensive) narrowphase only runs on them.
+ */
+class Broadphase {
+ public:
+  virtual ~Broadphase() = default;
+
+  virtual void Insert(ProxyId id, const Aabb& aabb) = 0;
+  virtual void Update(ProxyId id, const Aabb& aabb) = 0;
+  virtual void Remove(ProxyId id) = 0;
+  // Calls `callback` exactly once for every proxy whose bounding box overlaps
+  // `aabb`. The order of the calls is unspecified.
+  virtual void Query(const Aabb& aabb,
+                     absl::FunctionRef<void(ProxyId)> callback) const = 0;
+  // Calls `callback` exactly once for every proxy whose bounding box, grown by
+  // `thickness`, `ray` hits. Shapes which fit into a `thickness` sized box
+  // moving along the ray can only hit the reported proxies. The order of the
+  // calls is unspecified.
+  virtual void QueryRay(const Ray& ray, float thickness,
+                        absl::FunctionRef<void(ProxyId)> callback) const = 0;
+  // Calls `callback` exactly once for every pair of proxies with overlapping
+  // bounding boxes, smaller id first. The order of the calls is unspecified.
+  virtual void QueryPairs(
+      absl::FunctionRef<void(ProxyId, ProxyId)> callback) const = 0;
+
+  [[nodiscard]] virtual bool Contains(ProxyId id) const = 0;
+  [[nodiscard]] virtual size_t size() const = 0;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_BROADPHASE_H
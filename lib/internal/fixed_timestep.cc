@@ -0,0 +1,36 @@
+#include "lib/internal/fixed_timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "absl/log/check.h"
+
+namespace lib {
+namespace internal {
+
+FixedTimestep::FixedTimestep(const int steps_per_second,
+                             const int max_steps_per_frame)
+    : step_seconds_(1.0 / steps_per_second),
+      max_steps_per_frame_(max_steps_per_frame),
+      accumulator_(0) {
+  CHECK(steps_per_second > 0)
+      << "Steps per second have to be positive, have: " << steps_per_second;
+  CHECK(max_steps_per_frame > 0)
+      << "Max steps per frame have to be positive, have: "
+      << max_steps_per_frame;
+}
+
+int FixedTimestep::Advance(const float seconds) {
+  accumulator_ += std::max(seconds, 0.0f);
+  int steps = 0;
+  while (accumulator_ >= step_seconds_ && steps < max_steps_per_frame_) {
+    accumulator_ -= step_seconds_;
+    ++steps;
+  }
+  // Drops the whole steps which did not fit into this frame.
+  accumulator_ = std::fmod(accumulator_, step_seconds_);
+  return steps;
+}
+
+}  // namespace internal
+}  // namespace lib
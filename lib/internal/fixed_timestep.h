@@ -0,0 +1,41 @@
+#ifndef LIB_INTERNAL_FIXED_TIMESTEP_H
+#define LIB_INTERNAL_FIXED_TIMESTEP_H
+
+namespace lib {
+namespace internal {
+
+// A machine that can not keep up would otherwise simulate more steps every
+// frame, taking even longer to draw the next one.
+constexpr int kMaxStepsPerFrame = 8;
+
+// Splits the time between drawn frames into simulation steps of a fixed
+// length, so that the simulation does not depend on the frame rate. Time
+// which does not add up to a whole step is carried over to the next frame.
+class FixedTimestep {
+ public:
+  explicit FixedTimestep(int steps_per_second,
+                         int max_steps_per_frame = kMaxStepsPerFrame);
+
+  // Adds `seconds` since the last frame and returns how many steps to
+  // simulate. Time for more than `max_steps_per_frame` steps is dropped, the
+  // simulation slows down instead.
+  [[nodiscard]] int Advance(float seconds);
+  // Forgets the time carried over, e.g. after a level has been loaded.
+  void Reset() { accumulator_ = 0; }
+
+  // How far the frame is between the last step and the next one, in [0, 1).
+  [[nodiscard]] float alpha() const {
+    return static_cast<float>(accumulator_ / step_seconds_);
+  }
+  [[nodiscard]] double step_seconds() const { return step_seconds_; }
+
+ private:
+  double step_seconds_;
+  int max_steps_per_frame_;
+  double accumulator_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_FIXED_TIMESTEP_H
@@ -0,0 +1,57 @@
+#include "lib/internal/fixed_timestep.h"
+
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+TEST(FixedTimestepTest, CarriesOverPartialSteps) {
+  FixedTimestep timestep(/*steps_per_second=*/10);
+
+  EXPECT_EQ(timestep.Advance(0.25f), 2);
+  EXPECT_NEAR(timestep.alpha(), 0.5f, 1e-4);
+  EXPECT_EQ(timestep.Advance(0.04f), 0);
+  EXPECT_NEAR(timestep.alpha(), 0.9f, 1e-4);
+  EXPECT_EQ(timestep.Advance(0.02f), 1);
+  EXPECT_NEAR(timestep.alpha(), 0.1f, 1e-4);
+}
+
+TEST(FixedTimestepTest, RendersFasterThanSimulation) {
+  FixedTimestep timestep(/*steps_per_second=*/60);
+
+  int steps = 0;
+  for (int frame = 0; frame < 144; ++frame) {
+    steps += timestep.Advance(1.0f / 144);
+    EXPECT_LT(timestep.alpha(), 1);
+  }
+
+  EXPECT_NEAR(steps, 60, 1);
+}
+
+TEST(FixedTimestepTest, DropsStepsAboveMax) {
+  FixedTimestep timestep(/*steps_per_second=*/10, /*max_steps_per_frame=*/3);
+
+  EXPECT_EQ(timestep.Advance(1.05f), 3);
+  EXPECT_NEAR(timestep.alpha(), 0.5f, 1e-4);
+  EXPECT_EQ(timestep.Advance(0), 0);
+}
+
+TEST(FixedTimestepTest, Reset) {
+  FixedTimestep timestep(/*steps_per_second=*/10);
+
+  EXPECT_EQ(timestep.Advance(0.05f), 0);
+  timestep.Reset();
+
+  EXPECT_EQ(timestep.alpha(), 0);
+  EXPECT_EQ(timestep.Advance(0.05f), 0);
+}
+
+TEST(FixedTimestepDeathTest, NoSteps) {
+  EXPECT_DEATH(FixedTimestep(/*steps_per_second=*/0),
+               "Steps per second have to be positive");
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
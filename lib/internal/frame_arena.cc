@@ -0,0 +1,63 @@
+#include "lib/internal/frame_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "absl/log/check.h"
+
+namespace lib {
+namespace internal {
+
+FrameArena::FrameArena(const size_t initial_size)
+    : offset_(0), bytes_used_in_full_blocks_(0) {
+  CHECK(initial_size > 0) << "Initial size has to be positive, have: "
+                          << initial_size;
+  AddBlock(initial_size);
+}
+
+void FrameArena::Reset() {
+  if (blocks_.size() > 1) {
+    const size_t size = capacity();
+    blocks_.clear();
+    AddBlock(size);
+  }
+  offset_ = 0;
+  bytes_used_in_full_blocks_ = 0;
+}
+
+size_t FrameArena::capacity() const {
+  size_t capacity = 0;
+  for (const Block& block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+void* FrameArena::do_allocate(const size_t bytes, const size_t alignment) {
+  const auto aligned_offset = [this, alignment]() {
+    const uintptr_t address =
+        reinterpret_cast<uintptr_t>(blocks_.back().memory.get()) + offset_;
+    const uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+    return offset_ + (aligned - address);
+  };
+  size_t begin = aligned_offset();
+  if (begin + bytes > blocks_.back().size) {
+    bytes_used_in_full_blocks_ += offset_;
+    AddBlock(std::max(blocks_.back().size * 2, bytes + alignment));
+    begin = aligned_offset();
+  }
+  offset_ = begin + bytes;
+  return blocks_.back().memory.get() + begin;
+}
+
+void FrameArena::AddBlock(const size_t size) {
+  blocks_.push_back(
+      {.memory = std::make_unique_for_overwrite<std::byte[]>(size),
+       .size = size});
+  offset_ = 0;
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,64 @@
+#ifndef LIB_INTERNAL_FRAME_ARENA_H
+#define LIB_INTERNAL_FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace lib {
+namespace internal {
+
+constexpr size_t kFrameArenaInitialSize = 16 * 1024;
+
+// Memory for data which only lives until the end of a frame. Allocating is
+// bumping a pointer, deallocating does nothing and `Reset` frees everything at
+// once. Use it through `std::pmr` containers.
+//
+// Memory is kept between frames. A frame which needs more than the current
+// block gets a new one, and `Reset` replaces all the blocks with a single one
+// which is large enough for all of them - so frames which do not need more
+// memory than the previous ones do not allocate on the heap.
+class FrameArena : public std::pmr::memory_resource {
+ public:
+  explicit FrameArena(size_t initial_size = kFrameArenaInitialSize);
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  // Everything allocated before must not be used anymore.
+  void Reset();
+
+  // Bytes handed out since the last reset, including alignment padding.
+  [[nodiscard]] size_t bytes_used() const {
+    return bytes_used_in_full_blocks_ + offset_;
+  }
+  [[nodiscard]] size_t capacity() const;
+  [[nodiscard]] size_t num_blocks() const { return blocks_.size(); }
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> memory;
+    size_t size;
+  };
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* /*memory*/, size_t /*bytes*/,
+                     size_t /*alignment*/) override {}
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void AddBlock(size_t size);
+
+  // Allocations come from the last block.
+  std::vector<Block> blocks_;
+  size_t offset_;
+  size_t bytes_used_in_full_blocks_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_FRAME_ARENA_H
@@ -0,0 +1,97 @@
+#include "lib/internal/frame_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+// Allocates `count` times `size` bytes, none of them null.
+std::vector<std::byte*> AllocateFrame(FrameArena& arena, const int count,
+                                      const size_t size) {
+  std::vector<std::byte*> allocations;
+  for (int i = 0; i < count; ++i) {
+    void* const memory = arena.allocate(size, 8);
+    EXPECT_NE(memory, nullptr);
+    allocations.push_back(static_cast<std::byte*>(memory));
+  }
+  return allocations;
+}
+
+// Whether no two allocations of `size` bytes share a byte.
+bool AreDisjoint(std::vector<std::byte*> allocations, const size_t size) {
+  std::ranges::sort(allocations, std::less<>());
+  for (size_t i = 1; i < allocations.size(); ++i) {
+    if (std::less<>()(allocations[i], allocations[i - 1] + size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(FrameArenaTest, AlignsAllocations) {
+  FrameArena arena(/*initial_size=*/256);
+
+  void* byte = arena.allocate(1, 1);
+  void* aligned = arena.allocate(8, 64);
+
+  EXPECT_NE(byte, aligned);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+  EXPECT_EQ(arena.num_blocks(), 1);
+}
+
+TEST(FrameArenaTest, ResetReusesMemory) {
+  FrameArena arena(/*initial_size=*/256);
+  void* first = arena.allocate(100, 8);
+
+  arena.Reset();
+
+  EXPECT_EQ(arena.bytes_used(), 0);
+  EXPECT_EQ(arena.allocate(100, 8), first);
+}
+
+TEST(FrameArenaTest, GrowsAndCoalescesOnReset) {
+  FrameArena arena(/*initial_size=*/64);
+  const std::vector<std::byte*> first_frame = AllocateFrame(arena, 10, 40);
+  EXPECT_TRUE(AreDisjoint(first_frame, 40));
+  EXPECT_GT(arena.num_blocks(), 1);
+  EXPECT_GE(arena.bytes_used(), 400);
+
+  arena.Reset();
+
+  // The same frame fits into a single block now.
+  EXPECT_EQ(arena.num_blocks(), 1);
+  EXPECT_GE(arena.capacity(), 400);
+  const std::vector<std::byte*> second_frame = AllocateFrame(arena, 10, 40);
+  EXPECT_TRUE(AreDisjoint(second_frame, 40));
+  EXPECT_EQ(arena.num_blocks(), 1);
+}
+
+TEST(FrameArenaTest, BacksPmrContainers) {
+  FrameArena arena(/*initial_size=*/64);
+
+  std::pmr::vector<int> values(&arena);
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+
+  EXPECT_EQ(values.size(), 100);
+  EXPECT_EQ(values[99], 99);
+  EXPECT_GE(arena.bytes_used(), 100 * sizeof(int));
+}
+
+TEST(FrameArenaDeathTest, NonPositiveInitialSize) {
+  EXPECT_DEATH(FrameArena(/*initial_size=*/0),
+               "Initial size has to be positive");
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
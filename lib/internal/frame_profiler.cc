@@ -0,0 +1,68 @@
+#include "lib/internal/frame_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "absl/time/time.h"
+
+namespace lib {
+namespace internal {
+
+std::string_view FramePhaseName(const FramePhase phase) {
+  switch (phase) {
+    case FramePhase::kCleanUp:
+      return "clean up";
+    case FramePhase::kAbilities:
+      return "abilities";
+    case FramePhase::kUpdate:
+      return "update";
+    case FramePhase::kCollisions:
+      return "collisions";
+    case FramePhase::kRecord:
+      return "record";
+    case FramePhase::kBackgrounds:
+      return "backgrounds";
+    case FramePhase::kDraw:
+      return "draw";
+    case FramePhase::kPresent:
+      return "present";
+  }
+  return "unknown";
+}
+
+void FrameProfiler::EndFrame() {
+  frames_[next_] = current_;
+  next_ = (next_ + 1) % kProfiledFrames;
+  num_frames_ = std::min(num_frames_ + 1, kProfiledFrames);
+  current_ = Frame();
+}
+
+PhaseSummary FrameProfiler::Summarize(const FramePhase phase) const {
+  if (num_frames_ == 0) {
+    return {};
+  }
+  // Frames are summarized every drawn frame, so this must not allocate.
+  std::array<absl::Duration, kProfiledFrames> durations;
+  absl::Duration total;
+  for (size_t i = 0; i < num_frames_; ++i) {
+    durations[i] = frames_[i].phases[static_cast<size_t>(phase)];
+    total += durations[i];
+  }
+  const auto end = durations.begin() + num_frames_;
+  // Nearest rank, the slowest frame until there are 100 of them.
+  const size_t p99_rank = (num_frames_ * 99 + 99) / 100 - 1;
+  std::nth_element(durations.begin(), durations.begin() + p99_rank, end);
+  return {.min = *std::min_element(durations.begin(), end),
+          .avg = total / static_cast<int64_t>(num_frames_),
+          .p99 = durations[p99_rank]};
+}
+
+const FrameCounters& FrameProfiler::last_counters() const {
+  return frames_[(next_ + kProfiledFrames - 1) % kProfiledFrames].counters;
+}
+
+}  // namespace internal
+}  // namespace lib
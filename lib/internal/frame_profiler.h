@@ -0,0 +1,118 @@
+#ifndef LIB_INTERNAL_FRAME_PROFILER_H
+#define LIB_INTERNAL_FRAME_PROFILER_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace lib {
+namespace internal {
+
+// Building with `--config=noprofiler` compiles the timers out,
+// `ScopedPhaseTimer` does nothing and levels draw the FPS only.
+#ifdef F_ENGINE_DISABLE_PROFILER
+inline constexpr bool kProfilerEnabled = false;
+#else
+inline constexpr bool kProfilerEnabled = true;
+#endif
+
+// Frames the profiler summarizes, two seconds at 60 FPS.
+constexpr size_t kProfiledFrames = 120;
+
+// Parts a frame of a level spends its time in. Simulation phases add up over
+// every step simulated in the frame.
+enum class FramePhase {
+  kCleanUp,
+  kAbilities,
+  kUpdate,
+  kCollisions,
+  // Recording and sorting the snapshot.
+  kRecord,
+  kBackgrounds,
+  kDraw,
+  // Drawing the canvas on the screen and waiting for the swap.
+  kPresent,
+};
+constexpr size_t kNumFramePhases = 8;
+
+[[nodiscard]] std::string_view FramePhaseName(FramePhase phase);
+
+// Sizes of the work done in a frame.
+struct FrameCounters {
+  int objects = 0;
+  int hit_box_tests = 0;
+  int contacts = 0;
+  int draw_calls = 0;
+};
+
+struct PhaseSummary {
+  absl::Duration min;
+  absl::Duration avg;
+  absl::Duration p99;
+};
+
+// Time every phase took in the last `kProfiledFrames` frames, kept in a ring
+// buffer which never allocates.
+//
+// The phases and counters of the current frame may be written from different
+// threads, as long as each of them is only written from one thread and
+// `EndFrame` is called once all of them are done.
+class FrameProfiler {
+ public:
+  void Add(FramePhase phase, absl::Duration duration) {
+    current_.phases[static_cast<size_t>(phase)] += duration;
+  }
+  [[nodiscard]] FrameCounters& counters() { return current_.counters; }
+  // Stores the current frame, dropping the oldest one once the buffer is full.
+  void EndFrame();
+
+  // Zero for every value before the first frame has ended.
+  [[nodiscard]] PhaseSummary Summarize(FramePhase phase) const;
+  // Counters of the last frame which has ended.
+  [[nodiscard]] const FrameCounters& last_counters() const;
+  [[nodiscard]] size_t frames() const { return num_frames_; }
+
+ private:
+  struct Frame {
+    std::array<absl::Duration, kNumFramePhases> phases;
+    FrameCounters counters;
+  };
+
+  std::array<Frame, kProfiledFrames> frames_;
+  // Where the next frame is stored.
+  size_t next_ = 0;
+  size_t num_frames_ = 0;
+  Frame current_;
+};
+
+// Adds the time from its construction to its destruction to `phase`.
+class ScopedPhaseTimer {
+ public:
+  ScopedPhaseTimer(FrameProfiler& profiler, const FramePhase phase)
+      : profiler_(profiler), phase_(phase) {
+    if constexpr (kProfilerEnabled) {
+      start_ = absl::Now();
+    }
+  }
+  ~ScopedPhaseTimer() {
+    if constexpr (kProfilerEnabled) {
+      profiler_.Add(phase_, absl::Now() - start_);
+    }
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+  ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+ private:
+  FrameProfiler& profiler_;
+  const FramePhase phase_;
+  absl::Time start_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_FRAME_PROFILER_H
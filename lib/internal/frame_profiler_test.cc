@@ -0,0 +1,75 @@
+#include "lib/internal/frame_profiler.h"
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+TEST(FrameProfilerTest, SummarizesPhases) {
+  FrameProfiler profiler;
+
+  for (int frame = 1; frame <= 100; ++frame) {
+    profiler.Add(FramePhase::kUpdate, absl::Milliseconds(frame));
+    // Adds up within a frame.
+    profiler.Add(FramePhase::kDraw, absl::Milliseconds(1));
+    profiler.Add(FramePhase::kDraw, absl::Milliseconds(1));
+    profiler.EndFrame();
+  }
+
+  const PhaseSummary update = profiler.Summarize(FramePhase::kUpdate);
+  EXPECT_EQ(update.min, absl::Milliseconds(1));
+  EXPECT_EQ(update.avg, absl::Microseconds(50500));
+  EXPECT_EQ(update.p99, absl::Milliseconds(99));
+  EXPECT_EQ(profiler.Summarize(FramePhase::kDraw).p99, absl::Milliseconds(2));
+  EXPECT_EQ(profiler.Summarize(FramePhase::kPresent).avg, absl::ZeroDuration());
+  EXPECT_EQ(profiler.frames(), 100);
+}
+
+TEST(FrameProfilerTest, DropsOldestFrames) {
+  FrameProfiler profiler;
+
+  for (size_t frame = 0; frame < kProfiledFrames + 3; ++frame) {
+    profiler.Add(FramePhase::kCleanUp,
+                 absl::Milliseconds(frame < 3 ? 100 : 1));
+    profiler.counters().objects = static_cast<int>(frame);
+    profiler.EndFrame();
+  }
+
+  EXPECT_EQ(profiler.frames(), kProfiledFrames);
+  EXPECT_EQ(profiler.Summarize(FramePhase::kCleanUp).p99,
+            absl::Milliseconds(1));
+  EXPECT_EQ(profiler.last_counters().objects,
+            static_cast<int>(kProfiledFrames) + 2);
+}
+
+TEST(FrameProfilerTest, EmptyBeforeFirstFrame) {
+  FrameProfiler profiler;
+
+  profiler.Add(FramePhase::kDraw, absl::Milliseconds(1));
+
+  EXPECT_EQ(profiler.frames(), 0);
+  EXPECT_EQ(profiler.Summarize(FramePhase::kDraw).p99, absl::ZeroDuration());
+}
+
+TEST(FrameProfilerTest, ScopedPhaseTimer) {
+  if (!kProfilerEnabled) {
+    GTEST_SKIP() << "Timers are compiled out.";
+  }
+  FrameProfiler profiler;
+
+  {
+    const ScopedPhaseTimer timer(profiler, FramePhase::kRecord);
+    absl::SleepFor(absl::Milliseconds(2));
+  }
+  profiler.EndFrame();
+
+  EXPECT_GE(profiler.Summarize(FramePhase::kRecord).min,
+            absl::Milliseconds(2));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,33 @@
+#include "aabb.h"
+
+#include <algorithm>
+
+namespace lib {
+namespace internal {
+
+bool Aabb::Overlaps(const Aabb& other, const float margin) const {
+  return min_x - margin <= other.max_x && other.min_x - margin <= max_x &&
+         min_y - margin <= other.max_y && other.min_y - margin <= max_y;
+}
+
+bool Aabb::Contains(const Aabb& other) const {
+  return min_x <= other.min_x && min_y <= other.min_y &&
+         other.max_x <= max_x && other.max_y <= max_y;
+}
+
+Aabb Aabb::Expand(const float margin) const {
+  return {.min_x = min_x - margin,
+          .min_y = min_y - margin,
+          .max_x = max_x + margin,
+          .max_y = max_y + margin};
+}
+
+Aabb Aabb::Union(const Aabb& other) const {
+  return {.min_x = std::min(min_x, other.min_x),
+          .min_y = std::min(min_y, other.min_y),
+          .max_x = std::max(max_x, other.max_x),
+          .max_y = std::max(max_y, other.max_y)};
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,36 @@
+#ifndef LIB_INTERNAL_GEOMETRY_AABB_H
+#define LIB_INTERNAL_GEOMETRY_AABB_H
+
+namespace lib {
+namespace internal {
+
+/*
+ * Axis aligned bounding box. Used by the broadphase to cheaply discard pairs
+ * of shapes which can not collide before running the exact narrowphase test.
+ */
+struct Aabb {
+  // Returns true if the boxes overlap. Touching boxes overlap as well, and
+  // `margin` grows both boxes so that narrowphase `eps` tolerances are never
+  // culled away.
+  [[nodiscard]] bool Overlaps(const Aabb& other, float margin = 0.0f) const;
+  // Returns true if `other` lies fully inside of this box.
+  [[nodiscard]] bool Contains(const Aabb& other) const;
+  [[nodiscard]] Aabb Expand(float margin) const;
+  // Smallest box containing both boxes.
+  [[nodiscard]] Aabb Union(const Aabb& other) const;
+  [[nodiscard]] float Perimeter() const { return 2 * (width() + height()); }
+  [[nodiscard]] float width() const { return max_x - min_x; }
+  [[nodiscard]] float height() const { return max_y - min_y; }
+
+  bool operator==(const Aabb& other) const = default;
+
+  float min_x;
+  float min_y;
+  float max_x;
+  float max_y;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_GEOMETRY_AABB_H
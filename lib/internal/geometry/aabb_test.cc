@@ -0,0 +1,68 @@
+#include "aabb.h"
+
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+TEST(AabbTest, Overlaps) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+  const Aabb b = {.min_x = 5, .min_y = 5, .max_x = 15, .max_y = 15};
+
+  EXPECT_TRUE(a.Overlaps(b));
+  EXPECT_TRUE(b.Overlaps(a));
+}
+
+TEST(AabbTest, TouchingOverlaps) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+  const Aabb b = {.min_x = 10, .min_y = 10, .max_x = 20, .max_y = 20};
+
+  EXPECT_TRUE(a.Overlaps(b));
+  EXPECT_TRUE(b.Overlaps(a));
+}
+
+TEST(AabbTest, DoesNotOverlap) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+  const Aabb b = {.min_x = 11, .min_y = 0, .max_x = 20, .max_y = 10};
+
+  EXPECT_FALSE(a.Overlaps(b));
+  EXPECT_FALSE(b.Overlaps(a));
+}
+
+TEST(AabbTest, OverlapsWithinMargin) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+  const Aabb b = {.min_x = 10.5f, .min_y = 0, .max_x = 20, .max_y = 10};
+
+  EXPECT_FALSE(a.Overlaps(b));
+  EXPECT_TRUE(a.Overlaps(b, /*margin=*/1.0f));
+}
+
+TEST(AabbTest, Expand) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+
+  EXPECT_EQ(a.Expand(1.0f),
+            (Aabb{.min_x = -1, .min_y = -1, .max_x = 11, .max_y = 11}));
+  EXPECT_FLOAT_EQ(a.width(), 10.0f);
+  EXPECT_FLOAT_EQ(a.height(), 10.0f);
+}
+
+TEST(AabbTest, Contains) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+
+  EXPECT_TRUE(a.Contains({.min_x = 1, .min_y = 1, .max_x = 10, .max_y = 9}));
+  EXPECT_FALSE(a.Contains({.min_x = 1, .min_y = 1, .max_x = 11, .max_y = 9}));
+}
+
+TEST(AabbTest, Union) {
+  const Aabb a = {.min_x = 0, .min_y = 0, .max_x = 10, .max_y = 10};
+  const Aabb b = {.min_x = 5, .min_y = -5, .max_x = 20, .max_y = 5};
+
+  EXPECT_EQ(a.Union(b),
+            (Aabb{.min_x = 0, .min_y = -5, .max_x = 20, .max_y = 10}));
+  EXPECT_FLOAT_EQ(a.Union(b).Perimeter(), 70.0f);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
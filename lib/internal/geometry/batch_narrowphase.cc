@@ -0,0 +1,210 @@
+#include "batch_narrowphase.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "shape.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+// The scalar helpers repeat the arithmetic of `Shape::Collides` operation by
+// operation, every SIMD kernel does the same for four shapes at once.
+float Square(const float a) {
+  return a * a;
+}
+
+bool CirclesCollide(const float x, const float y, const float r,
+                    const float other_x, const float other_y,
+                    const float other_r) {
+  return Square(x - other_x) + Square(y - other_y) <= Square(r + other_r);
+}
+
+bool RectangleCollidesWithCircle(const float min_x, const float min_y,
+                                 const float max_x, const float max_y,
+                                 const float x, const float y, const float r) {
+  const float dx = std::max({min_x - x, 0.0f, x - max_x});
+  const float dy = std::max({min_y - y, 0.0f, y - max_y});
+  return Square(dx) + Square(dy) <= Square(r);
+}
+
+bool RectanglesCollide(const float min_x, const float min_y, const float max_x,
+                       const float max_y, const float other_min_x,
+                       const float other_min_y, const float other_max_x,
+                       const float other_max_y) {
+  return min_x <= other_max_x && max_x >= other_min_x &&
+         max_y >= other_min_y && min_y <= other_max_y;
+}
+
+#if defined(__SSE2__)
+constexpr size_t kLanes = 4;
+
+void StoreMask(const __m128 mask, bool* collides) {
+  const int bits = _mm_movemask_ps(mask);
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    collides[lane] = (bits >> lane) & 1;
+  }
+}
+
+// Same as `RectangleCollidesWithCircle` for four rectangle and circle pairs.
+__m128 RectangleCollidesWithCircle(const __m128 min_x, const __m128 min_y,
+                                   const __m128 max_x, const __m128 max_y,
+                                   const __m128 x, const __m128 y,
+                                   const __m128 r) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 dx =
+      _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_x, x), zero), _mm_sub_ps(x, max_x));
+  const __m128 dy =
+      _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_y, y), zero), _mm_sub_ps(y, max_y));
+  return _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                      _mm_mul_ps(r, r));
+}
+#endif
+
+}  // namespace
+
+void CircleBatch::Add(const CircleInternal& circle) {
+  x.push_back(circle.a.x);
+  y.push_back(circle.a.y);
+  r.push_back(circle.r);
+}
+
+void CircleBatch::Clear() {
+  x.clear();
+  y.clear();
+  r.clear();
+}
+
+void RectangleBatch::Add(const RectangleInternal& rectangle) {
+  min_x.push_back(rectangle.a.x);
+  min_y.push_back(rectangle.c.y);
+  max_x.push_back(rectangle.c.x);
+  max_y.push_back(rectangle.a.y);
+}
+
+void RectangleBatch::Clear() {
+  min_x.clear();
+  min_y.clear();
+  max_x.clear();
+  max_y.clear();
+}
+
+void CollidesBatch(const CircleInternal& circle, const CircleBatch& circles,
+                   const absl::Span<bool> collides) {
+  CHECK(collides.size() == circles.size())
+      << "Output size " << collides.size() << " does not match batch size "
+      << circles.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128 x = _mm_set1_ps(circle.a.x);
+  const __m128 y = _mm_set1_ps(circle.a.y);
+  const __m128 r = _mm_set1_ps(circle.r);
+  for (; i + kLanes <= circles.size(); i += kLanes) {
+    const __m128 dx = _mm_sub_ps(x, _mm_loadu_ps(&circles.x[i]));
+    const __m128 dy = _mm_sub_ps(y, _mm_loadu_ps(&circles.y[i]));
+    const __m128 sum_r = _mm_add_ps(r, _mm_loadu_ps(&circles.r[i]));
+    StoreMask(
+        _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                     _mm_mul_ps(sum_r, sum_r)),
+        &collides[i]);
+  }
+#endif
+  for (; i < circles.size(); ++i) {
+    collides[i] = CirclesCollide(circle.a.x, circle.a.y, circle.r,
+                                 circles.x[i], circles.y[i], circles.r[i]);
+  }
+}
+
+void CollidesBatch(const CircleInternal& circle,
+                   const RectangleBatch& rectangles,
+                   const absl::Span<bool> collides) {
+  CHECK(collides.size() == rectangles.size())
+      << "Output size " << collides.size() << " does not match batch size "
+      << rectangles.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128 x = _mm_set1_ps(circle.a.x);
+  const __m128 y = _mm_set1_ps(circle.a.y);
+  const __m128 r = _mm_set1_ps(circle.r);
+  for (; i + kLanes <= rectangles.size(); i += kLanes) {
+    StoreMask(RectangleCollidesWithCircle(_mm_loadu_ps(&rectangles.min_x[i]),
+                                          _mm_loadu_ps(&rectangles.min_y[i]),
+                                          _mm_loadu_ps(&rectangles.max_x[i]),
+                                          _mm_loadu_ps(&rectangles.max_y[i]),
+                                          x, y, r),
+              &collides[i]);
+  }
+#endif
+  for (; i < rectangles.size(); ++i) {
+    collides[i] = RectangleCollidesWithCircle(
+        rectangles.min_x[i], rectangles.min_y[i], rectangles.max_x[i],
+        rectangles.max_y[i], circle.a.x, circle.a.y, circle.r);
+  }
+}
+
+void CollidesBatch(const RectangleInternal& rectangle,
+                   const CircleBatch& circles,
+                   const absl::Span<bool> collides) {
+  CHECK(collides.size() == circles.size())
+      << "Output size " << collides.size() << " does not match batch size "
+      << circles.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128 min_x = _mm_set1_ps(rectangle.a.x);
+  const __m128 min_y = _mm_set1_ps(rectangle.c.y);
+  const __m128 max_x = _mm_set1_ps(rectangle.c.x);
+  const __m128 max_y = _mm_set1_ps(rectangle.a.y);
+  for (; i + kLanes <= circles.size(); i += kLanes) {
+    StoreMask(RectangleCollidesWithCircle(
+                  min_x, min_y, max_x, max_y, _mm_loadu_ps(&circles.x[i]),
+                  _mm_loadu_ps(&circles.y[i]), _mm_loadu_ps(&circles.r[i])),
+              &collides[i]);
+  }
+#endif
+  for (; i < circles.size(); ++i) {
+    collides[i] = RectangleCollidesWithCircle(
+        rectangle.a.x, rectangle.c.y, rectangle.c.x, rectangle.a.y,
+        circles.x[i], circles.y[i], circles.r[i]);
+  }
+}
+
+void CollidesBatch(const RectangleInternal& rectangle,
+                   const RectangleBatch& rectangles,
+                   const absl::Span<bool> collides) {
+  CHECK(collides.size() == rectangles.size())
+      << "Output size " << collides.size() << " does not match batch size "
+      << rectangles.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128 min_x = _mm_set1_ps(rectangle.a.x);
+  const __m128 min_y = _mm_set1_ps(rectangle.c.y);
+  const __m128 max_x = _mm_set1_ps(rectangle.c.x);
+  const __m128 max_y = _mm_set1_ps(rectangle.a.y);
+  for (; i + kLanes <= rectangles.size(); i += kLanes) {
+    const __m128 x_overlaps =
+        _mm_and_ps(_mm_cmple_ps(min_x, _mm_loadu_ps(&rectangles.max_x[i])),
+                   _mm_cmpge_ps(max_x, _mm_loadu_ps(&rectangles.min_x[i])));
+    const __m128 y_overlaps =
+        _mm_and_ps(_mm_cmpge_ps(max_y, _mm_loadu_ps(&rectangles.min_y[i])),
+                   _mm_cmple_ps(min_y, _mm_loadu_ps(&rectangles.max_y[i])));
+    StoreMask(_mm_and_ps(x_overlaps, y_overlaps), &collides[i]);
+  }
+#endif
+  for (; i < rectangles.size(); ++i) {
+    collides[i] = RectanglesCollide(
+        rectangle.a.x, rectangle.c.y, rectangle.c.x, rectangle.a.y,
+        rectangles.min_x[i], rectangles.min_y[i], rectangles.max_x[i],
+        rectangles.max_y[i]);
+  }
+}
+
+}  // namespace internal
+}  // namespace lib
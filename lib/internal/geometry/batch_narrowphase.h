@@ -0,0 +1,53 @@
+#ifndef LIB_INTERNAL_GEOMETRY_BATCH_NARROWPHASE_H
+#define LIB_INTERNAL_GEOMETRY_BATCH_NARROWPHASE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "shape.h"
+
+namespace lib {
+namespace internal {
+
+// Circles stored as a structure of arrays, so that SIMD instructions can load
+// the same coordinate of several circles at once.
+struct CircleBatch {
+  void Add(const CircleInternal& circle);
+  void Clear();
+  [[nodiscard]] size_t size() const { return x.size(); }
+
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> r;
+};
+
+// Axis aligned rectangles stored as a structure of arrays.
+struct RectangleBatch {
+  void Add(const RectangleInternal& rectangle);
+  void Clear();
+  [[nodiscard]] size_t size() const { return min_x.size(); }
+
+  std::vector<float> min_x;
+  std::vector<float> min_y;
+  std::vector<float> max_x;
+  std::vector<float> max_y;
+};
+
+// Test a single shape against every shape of a batch and store the result for
+// the i-th shape of the batch in `collides[i]`. Results are exactly the same
+// as the ones of the scalar `Collides`. Uses SSE2 when it is available and
+// falls back to scalar code otherwise.
+void CollidesBatch(const CircleInternal& circle, const CircleBatch& circles,
+                   absl::Span<bool> collides);
+void CollidesBatch(const CircleInternal& circle,
+                   const RectangleBatch& rectangles, absl::Span<bool> collides);
+void CollidesBatch(const RectangleInternal& rectangle,
+                   const CircleBatch& circles, absl::Span<bool> collides);
+void CollidesBatch(const RectangleInternal& rectangle,
+                   const RectangleBatch& rectangles, absl::Span<bool> collides);
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_GEOMETRY_BATCH_NARROWPHASE_H
@@ -0,0 +1,162 @@
+#include "batch_narrowphase.h"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "shape.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Coordinates are rounded to a quarter, so that a lot of shapes touch each
+// other exactly and the boundary cases are covered.
+class RandomShapes {
+ public:
+  RandomShapes() : gen_(42), coordinate_(-80, 80), size_(1, 40) {}
+
+  CircleInternal Circle() {
+    return CircleInternal{{Coordinate(), Coordinate()}, Size()};
+  }
+
+  RectangleInternal Rectangle() {
+    const float x = Coordinate();
+    const float y = Coordinate();
+    return RectangleInternal{{x, y + Size()}, {x + Size(), y}};
+  }
+
+ private:
+  float Coordinate() { return static_cast<float>(coordinate_(gen_)) / 4; }
+  float Size() { return static_cast<float>(size_(gen_)) / 4; }
+
+  std::mt19937 gen_;
+  std::uniform_int_distribution<int> coordinate_;
+  std::uniform_int_distribution<int> size_;
+};
+
+// Odd size so that the scalar tail after the SIMD loop is covered too.
+constexpr size_t kBatchSize = 103;
+constexpr int kRounds = 200;
+
+TEST(BatchNarrowphaseTest, CircleWithCirclesMatchesScalar) {
+  RandomShapes random;
+  std::vector<CircleInternal> circles;
+  CircleBatch batch;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    circles.push_back(random.Circle());
+    batch.Add(circles.back());
+  }
+  const std::unique_ptr<bool[]> collides = std::make_unique<bool[]>(kBatchSize);
+
+  for (int round = 0; round < kRounds; ++round) {
+    const CircleInternal circle = random.Circle();
+    CollidesBatch(circle, batch, absl::MakeSpan(collides.get(), kBatchSize));
+
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      ASSERT_EQ(collides[i], circle.Collides(circles[i])) << i;
+    }
+  }
+}
+
+TEST(BatchNarrowphaseTest, CircleWithRectanglesMatchesScalar) {
+  RandomShapes random;
+  std::vector<RectangleInternal> rectangles;
+  RectangleBatch batch;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    rectangles.push_back(random.Rectangle());
+    batch.Add(rectangles.back());
+  }
+  const std::unique_ptr<bool[]> collides = std::make_unique<bool[]>(kBatchSize);
+
+  for (int round = 0; round < kRounds; ++round) {
+    const CircleInternal circle = random.Circle();
+    CollidesBatch(circle, batch, absl::MakeSpan(collides.get(), kBatchSize));
+
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      ASSERT_EQ(collides[i], circle.Collides(rectangles[i])) << i;
+    }
+  }
+}
+
+TEST(BatchNarrowphaseTest, RectangleWithCirclesMatchesScalar) {
+  RandomShapes random;
+  std::vector<CircleInternal> circles;
+  CircleBatch batch;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    circles.push_back(random.Circle());
+    batch.Add(circles.back());
+  }
+  const std::unique_ptr<bool[]> collides = std::make_unique<bool[]>(kBatchSize);
+
+  for (int round = 0; round < kRounds; ++round) {
+    const RectangleInternal rectangle = random.Rectangle();
+    CollidesBatch(rectangle, batch,
+                  absl::MakeSpan(collides.get(), kBatchSize));
+
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      ASSERT_EQ(collides[i], rectangle.Collides(circles[i])) << i;
+    }
+  }
+}
+
+TEST(BatchNarrowphaseTest, RectangleWithRectanglesMatchesScalar) {
+  RandomShapes random;
+  std::vector<RectangleInternal> rectangles;
+  RectangleBatch batch;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    rectangles.push_back(random.Rectangle());
+    batch.Add(rectangles.back());
+  }
+  const std::unique_ptr<bool[]> collides = std::make_unique<bool[]>(kBatchSize);
+
+  for (int round = 0; round < kRounds; ++round) {
+    const RectangleInternal rectangle = random.Rectangle();
+    CollidesBatch(rectangle, batch,
+                  absl::MakeSpan(collides.get(), kBatchSize));
+
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      ASSERT_EQ(collides[i], rectangle.Collides(rectangles[i])) << i;
+    }
+  }
+}
+
+TEST(BatchNarrowphaseTest, TouchingShapesCollide) {
+  const CircleInternal circle{{0, 0}, 2};
+  CircleBatch circles;
+  circles.Add(CircleInternal{{3, 0}, 1});
+  circles.Add(CircleInternal{{0, -5}, 3});
+  circles.Add(CircleInternal{{3, 3}, 1});
+  RectangleBatch rectangles;
+  rectangles.Add(RectangleInternal{{2, 1}, {4, -1}});
+  rectangles.Add(RectangleInternal{{-4, -2}, {4, -4}});
+  rectangles.Add(RectangleInternal{{2, 3}, {4, 2}});
+  bool collides[3];
+
+  CollidesBatch(circle, circles, absl::MakeSpan(collides));
+  EXPECT_THAT(collides, ElementsAre(true, true, false));
+  CollidesBatch(circle, rectangles, absl::MakeSpan(collides));
+  EXPECT_THAT(collides, ElementsAre(true, true, false));
+}
+
+TEST(BatchNarrowphaseTest, ClearEmptiesBatch) {
+  CircleBatch circles;
+  circles.Add(CircleInternal{{0, 0}, 1});
+  RectangleBatch rectangles;
+  rectangles.Add(RectangleInternal{{0, 1}, {1, 0}});
+
+  circles.Clear();
+  rectangles.Clear();
+
+  EXPECT_EQ(circles.size(), 0);
+  EXPECT_EQ(rectangles.size(), 0);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
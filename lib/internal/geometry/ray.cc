@@ -0,0 +1,141 @@
+#include "ray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "aabb.h"
+#include "vec.h"
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+float Cross(const Vector& a, const Vector& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+RayHit StartsInside(const Ray& ray) {
+  return {.distance = 0, .normal = {-ray.direction.x, -ray.direction.y}};
+}
+
+}  // namespace
+
+Vector Ray::At(const float distance) const {
+  return {origin.x + direction.x * distance, origin.y + direction.y * distance};
+}
+
+Aabb Ray::BoundingBox() const {
+  const Vector end = At(max_distance);
+  return {.min_x = std::min(origin.x, end.x),
+          .min_y = std::min(origin.y, end.y),
+          .max_x = std::max(origin.x, end.x),
+          .max_y = std::max(origin.y, end.y)};
+}
+
+std::optional<RayHit> Raycast(const Ray& ray, const Aabb& aabb) {
+  float enter = -std::numeric_limits<float>::infinity();
+  float exit = std::numeric_limits<float>::infinity();
+  Vector normal = {0, 0};
+  // Slab test: the ray is inside of the box while it is between both pairs of
+  // parallel box sides.
+  const auto clip = [&enter, &exit, &normal](
+                        const float origin, const float direction,
+                        const float min, const float max,
+                        const Vector& min_side_normal) {
+    if (direction == 0) {
+      return min <= origin && origin <= max;
+    }
+    float near = (min - origin) / direction;
+    float far = (max - origin) / direction;
+    Vector near_normal = min_side_normal;
+    if (near > far) {
+      std::swap(near, far);
+      near_normal = {-min_side_normal.x, -min_side_normal.y};
+    }
+    if (near > enter) {
+      enter = near;
+      normal = near_normal;
+    }
+    exit = std::min(exit, far);
+    return true;
+  };
+  if (!clip(ray.origin.x, ray.direction.x, aabb.min_x, aabb.max_x, {-1, 0}) ||
+      !clip(ray.origin.y, ray.direction.y, aabb.min_y, aabb.max_y, {0, -1})) {
+    return std::nullopt;
+  }
+  if (enter > exit || exit < 0 || enter > ray.max_distance) {
+    return std::nullopt;
+  }
+  if (enter <= 0) {
+    return StartsInside(ray);
+  }
+  return RayHit{.distance = enter, .normal = normal};
+}
+
+std::optional<RayHit> RaycastCircle(const Ray& ray, const Vector& center,
+                                    const float radius) {
+  // Solves |origin + t * direction - center| = radius for the smaller t.
+  const Vector m = {ray.origin.x - center.x, ray.origin.y - center.y};
+  const float b = m.DotProduct(ray.direction);
+  const float c = m.Square() - radius * radius;
+  if (c <= 0) {
+    return StartsInside(ray);
+  }
+  // Starts outside and goes away from the circle.
+  if (b > 0) {
+    return std::nullopt;
+  }
+  const float discriminant = b * b - c;
+  if (discriminant < 0) {
+    return std::nullopt;
+  }
+  const float distance = -b - std::sqrt(discriminant);
+  if (distance > ray.max_distance) {
+    return std::nullopt;
+  }
+  const Vector hit = ray.At(distance);
+  const Vector normal = {hit.x - center.x, hit.y - center.y};
+  // Circles smaller than the float precision have no usable normal.
+  return RayHit{.distance = distance,
+                .normal = normal.IsZero()
+                              ? Vector{-ray.direction.x, -ray.direction.y}
+                              : normal.ToUnitVector()};
+}
+
+std::optional<RayHit> RaycastSegment(const Ray& ray, const Vector& a,
+                                     const Vector& b) {
+  // Solves origin + t * direction = a + s * (b - a).
+  const Vector segment = {b.x - a.x, b.y - a.y};
+  const float denominator = Cross(ray.direction, segment);
+  if (std::abs(denominator) <= eps * segment.Length()) {
+    return std::nullopt;
+  }
+  const Vector to_a = {a.x - ray.origin.x, a.y - ray.origin.y};
+  const float distance = Cross(to_a, segment) / denominator;
+  const float s = Cross(to_a, ray.direction) / denominator;
+  if (distance < 0 || distance > ray.max_distance || s < 0 || s > 1) {
+    return std::nullopt;
+  }
+  Vector normal = Vector{-segment.y, segment.x}.ToUnitVector();
+  if (normal.DotProduct(ray.direction) > 0) {
+    normal = {-normal.x, -normal.y};
+  }
+  return RayHit{.distance = distance, .normal = normal};
+}
+
+std::optional<RayHit> CloserHit(const std::optional<RayHit>& hit,
+                                const std::optional<RayHit>& other_hit) {
+  if (!hit.has_value()) {
+    return other_hit;
+  }
+  if (other_hit.has_value() && other_hit->distance < hit->distance) {
+    return other_hit;
+  }
+  return hit;
+}
+
+}  // namespace internal
+}  // namespace lib
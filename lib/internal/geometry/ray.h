@@ -0,0 +1,52 @@
+#ifndef LIB_INTERNAL_GEOMETRY_RAY_H
+#define LIB_INTERNAL_GEOMETRY_RAY_H
+
+#include <optional>
+
+#include "aabb.h"
+#include "vec.h"
+
+namespace lib {
+namespace internal {
+
+/*
+ * Half-line starting at `origin` and going in `direction`, cut off after
+ * `max_distance`. `direction` has to have unit length, so that distances
+ * along the ray are distances in the world.
+ */
+struct Ray {
+  [[nodiscard]] Vector At(float distance) const;
+  // Smallest box containing the whole ray.
+  [[nodiscard]] Aabb BoundingBox() const;
+
+  Vector origin;
+  Vector direction;
+  float max_distance;
+};
+
+struct RayHit {
+  // Distance from the ray origin to the hit.
+  float distance;
+  // Unit normal of the hit surface, pointing against the ray. A ray starting
+  // inside of a shape hits it at distance 0 with normal opposite to the ray.
+  Vector normal;
+};
+
+// Primitives the shapes cast against, every one returns the first hit within
+// `ray.max_distance`.
+std::optional<RayHit> Raycast(const Ray& ray, const Aabb& aabb);
+std::optional<RayHit> RaycastCircle(const Ray& ray, const Vector& center,
+                                    float radius);
+// Rays parallel to the segment never hit it, even when going along it.
+std::optional<RayHit> RaycastSegment(const Ray& ray, const Vector& a,
+                                     const Vector& b);
+
+// Returns the hit which is closer to the ray origin, `hit` when both are
+// equally far.
+std::optional<RayHit> CloserHit(const std::optional<RayHit>& hit,
+                                const std::optional<RayHit>& other_hit);
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_GEOMETRY_RAY_H
@@ -0,0 +1,105 @@
+#include "ray.h"
+
+#include <optional>
+
+#include "aabb.h"
+#include "gtest/gtest.h"
+#include "vec.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+constexpr Aabb kBox = {.min_x = 10, .min_y = -5, .max_x = 20, .max_y = 5};
+
+TEST(RayTest, BoundingBox) {
+  const Ray ray = {.origin = {10, 10}, .direction = {0, -1}, .max_distance = 5};
+
+  EXPECT_EQ(ray.BoundingBox(),
+            (Aabb{.min_x = 10, .min_y = 5, .max_x = 10, .max_y = 10}));
+}
+
+TEST(RayTest, RaycastAabb) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+
+  const std::optional<RayHit> hit = Raycast(ray, kBox);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_FLOAT_EQ(hit->distance, 10);
+  EXPECT_EQ(hit->normal, (Vector{-1, 0}));
+}
+
+TEST(RayTest, RaycastAabbFromBelow) {
+  const Ray ray = {
+      .origin = {15, 20}, .direction = {0, -1}, .max_distance = 100};
+
+  const std::optional<RayHit> hit = Raycast(ray, kBox);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_FLOAT_EQ(hit->distance, 15);
+  EXPECT_EQ(hit->normal, (Vector{0, 1}));
+}
+
+TEST(RayTest, RaycastAabbMisses) {
+  const Ray too_short = {
+      .origin = {0, 0}, .direction = {1, 0}, .max_distance = 9};
+  const Ray away = {
+      .origin = {0, 0}, .direction = {-1, 0}, .max_distance = 100};
+  const Ray parallel = {
+      .origin = {0, 6}, .direction = {1, 0}, .max_distance = 100};
+
+  EXPECT_FALSE(Raycast(too_short, kBox).has_value());
+  EXPECT_FALSE(Raycast(away, kBox).has_value());
+  EXPECT_FALSE(Raycast(parallel, kBox).has_value());
+}
+
+TEST(RayTest, RaycastAabbStartingInside) {
+  const Ray ray = {.origin = {15, 0}, .direction = {0, 1}, .max_distance = 1};
+
+  const std::optional<RayHit> hit = Raycast(ray, kBox);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_FLOAT_EQ(hit->distance, 0);
+  EXPECT_EQ(hit->normal, (Vector{0, -1}));
+}
+
+TEST(RayTest, RaycastCircle) {
+  const Ray ray = {.origin = {0, 0}, .direction = {0, 1}, .max_distance = 100};
+
+  const std::optional<RayHit> hit = RaycastCircle(ray, {0, 10}, 2);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_FLOAT_EQ(hit->distance, 8);
+  EXPECT_EQ(hit->normal, (Vector{0, -1}));
+  EXPECT_FALSE(RaycastCircle(ray, {3, 10}, 2).has_value());
+  EXPECT_FALSE(RaycastCircle(ray, {0, -10}, 2).has_value());
+  EXPECT_FLOAT_EQ(RaycastCircle(ray, {1, 0}, 2)->distance, 0);
+}
+
+TEST(RayTest, RaycastSegment) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+
+  const std::optional<RayHit> hit = RaycastSegment(ray, {5, -1}, {5, 1});
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_FLOAT_EQ(hit->distance, 5);
+  EXPECT_EQ(hit->normal, (Vector{-1, 0}));
+  EXPECT_FALSE(RaycastSegment(ray, {5, 1}, {5, 2}).has_value());
+  EXPECT_FALSE(RaycastSegment(ray, {1, 0}, {5, 0}).has_value());
+}
+
+TEST(RayTest, CloserHit) {
+  const RayHit near = {.distance = 1, .normal = {1, 0}};
+  const RayHit far = {.distance = 2, .normal = {0, 1}};
+  const RayHit same = {.distance = 1, .normal = {0, 1}};
+
+  EXPECT_EQ(CloserHit(far, near)->distance, 1);
+  EXPECT_EQ(CloserHit(near, std::nullopt)->distance, 1);
+  EXPECT_EQ(CloserHit(std::nullopt, far)->distance, 2);
+  EXPECT_FALSE(CloserHit(std::nullopt, std::nullopt).has_value());
+  EXPECT_EQ(CloserHit(near, same)->normal, near.normal);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
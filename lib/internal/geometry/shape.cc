@@ -2,13 +2,17 @@
 
 #include "shape.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <optional>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/strings/internal/str_format/extension.h"
 #include "absl/strings/str_format.h"
+#include "ray.h"
+#include "vec.h"
 
 namespace lib {
 namespace internal {
@@ -17,6 +21,69 @@ namespace {
 float square(const float& a) {
   return a * a;
 }
+
+Aabb BoxAround(const float x, const float y, const float half_width,
+               const float half_height) {
+  return {.min_x = x - half_width,
+          .min_y = y - half_height,
+          .max_x = x + half_width,
+          .max_y = y + half_height};
+}
+
+// Box with rounded corners: `aabb` grown by `radius` in every direction.
+std::optional<RayHit> RaycastRoundedBox(const Ray& ray, const Aabb& aabb,
+                                        const float radius) {
+  std::optional<RayHit> hit = CloserHit(
+      Raycast(ray, Aabb{.min_x = aabb.min_x - radius,
+                        .min_y = aabb.min_y,
+                        .max_x = aabb.max_x + radius,
+                        .max_y = aabb.max_y}),
+      Raycast(ray, Aabb{.min_x = aabb.min_x,
+                        .min_y = aabb.min_y - radius,
+                        .max_x = aabb.max_x,
+                        .max_y = aabb.max_y + radius}));
+  for (const float x : {aabb.min_x, aabb.max_x}) {
+    for (const float y : {aabb.min_y, aabb.max_y}) {
+      hit = CloserHit(hit, RaycastCircle(ray, {x, y}, radius));
+    }
+  }
+  return hit;
+}
+
+// Segment grown by `radius` in every direction.
+std::optional<RayHit> RaycastCapsule(const Ray& ray, const LineInternal& line,
+                                     const float radius) {
+  const Vector a = {line.a.x, line.a.y};
+  const Vector b = {line.b.x, line.b.y};
+  const Vector segment = line.MakeVector();
+  if (segment.IsZero()) {
+    return RaycastCircle(ray, a, radius);
+  }
+  // Closest point of the segment to the origin, the sides below only catch
+  // rays which start outside of the capsule.
+  const float t = std::clamp(
+      Vector{ray.origin.x - a.x, ray.origin.y - a.y}.DotProduct(segment) /
+          segment.Square(),
+      0.0f, 1.0f);
+  if (square(a.x + t * segment.x - ray.origin.x) +
+          square(a.y + t * segment.y - ray.origin.y) <=
+      square(radius)) {
+    return RayHit{.distance = 0,
+                  .normal = {-ray.direction.x, -ray.direction.y}};
+  }
+
+  const Vector offset =
+      Vector{-segment.y, segment.x}.ToUnitVector().Multiply(radius);
+  std::optional<RayHit> hit =
+      CloserHit(RaycastCircle(ray, a, radius), RaycastCircle(ray, b, radius));
+  for (const float side : {1.0f, -1.0f}) {
+    const Vector side_offset = offset.Multiply(side);
+    hit = CloserHit(hit, RaycastSegment(
+                             ray, {a.x + side_offset.x, a.y + side_offset.y},
+                             {b.x + side_offset.x, b.y + side_offset.y}));
+  }
+  return hit;
+}
 }  // namespace
 
 bool Clockwise(const PointInternal& a, const PointInternal& b,
@@ -83,22 +150,55 @@ void CircleInternal::Move(const float x, const float y) {
 }
 
 // POINT COLLISION
+Aabb PointInternal::BoundingBox() const {
+  return {.min_x = x, .min_y = y, .max_x = x, .max_y = y};
+}
+
+Aabb LineInternal::BoundingBox() const {
+  return {.min_x = std::min(a.x, b.x),
+          .min_y = std::min(a.y, b.y),
+          .max_x = std::max(a.x, b.x),
+          .max_y = std::max(a.y, b.y)};
+}
+
+Aabb RectangleInternal::BoundingBox() const {
+  // `a` is the bottom-left and `c` is the top-right vertex.
+  return {.min_x = a.x, .min_y = c.y, .max_x = c.x, .max_y = a.y};
+}
+
+Aabb CircleInternal::BoundingBox() const {
+  return {
+      .min_x = a.x - r, .min_y = a.y - r, .max_x = a.x + r, .max_y = a.y + r};
+}
+
 bool PointInternal::Collides(const PointInternal& other_point) const {
   return *this == other_point;
 }
 bool PointInternal::Collides(const LineInternal& line) const {
   return line.IsOnLine(*this);
 }
+// Circle and axis aligned rectangle tests below avoid `sqrt` and compare
+// squared distances and min/max coordinates instead. `BatchNarrowphase`
+// repeats exactly the same arithmetic, keep them in sync.
 bool PointInternal::Collides(const RectangleInternal& rectangle) const {
-  const Vector a = LineInternal(rectangle.a, *this).MakeVector();
-  const Vector b = LineInternal(rectangle.a, rectangle.b).MakeVector();
-  const Vector c = LineInternal(rectangle.a, rectangle.d).MakeVector();
-
-  return (0 <= a.DotProduct(b) && a.DotProduct(b) <= b.DotProduct(b)) &&
-         (0 <= a.DotProduct(c) && a.DotProduct(c) <= c.DotProduct(c));
+  return rectangle.a.x <= x && x <= rectangle.c.x && rectangle.c.y <= y &&
+         y <= rectangle.a.y;
 }
 bool PointInternal::Collides(const CircleInternal& circle) const {
-  return circle.r >= this->Distance(circle.a);
+  return square(x - circle.a.x) + square(y - circle.a.y) <= square(circle.r);
+}
+
+std::optional<RayHit> PointInternal::Raycast(const Ray& ray) const {
+  return CircleCast(ray, eps);
+}
+std::optional<RayHit> PointInternal::CircleCast(const Ray& ray,
+                                                const float radius) const {
+  return RaycastCircle(ray, {x, y}, radius);
+}
+std::optional<RayHit> PointInternal::BoxCast(const Ray& ray,
+                                             const float half_width,
+                                             const float half_height) const {
+  return internal::Raycast(ray, BoxAround(x, y, half_width, half_height));
 }
 
 bool PointInternal::IsLowerLeft(const PointInternal& other) const {
@@ -166,6 +266,47 @@ bool LineInternal::Collides(const CircleInternal& circle) const {
   return closest.Distance(circle.a) - eps <= circle.r;
 }
 
+std::optional<RayHit> LineInternal::Raycast(const Ray& ray) const {
+  return CircleCast(ray, eps);
+}
+std::optional<RayHit> LineInternal::CircleCast(const Ray& ray,
+                                               const float radius) const {
+  return RaycastCapsule(ray, *this, radius);
+}
+std::optional<RayHit> LineInternal::BoxCast(const Ray& ray,
+                                            const float half_width,
+                                            const float half_height) const {
+  const Vector segment = MakeVector();
+  const Aabb box_at_origin =
+      BoxAround(ray.origin.x, ray.origin.y, half_width, half_height);
+  // The ray starts inside when the box around the origin touches the line.
+  const bool starts_inside =
+      segment.IsZero()
+          ? box_at_origin.Contains(BoundingBox())
+          : internal::Raycast(Ray{.origin = {a.x, a.y},
+                                  .direction = segment.ToUnitVector(),
+                                  .max_distance = segment.Length()},
+                              box_at_origin)
+                .has_value();
+  if (starts_inside) {
+    return RayHit{.distance = 0,
+                  .normal = {-ray.direction.x, -ray.direction.y}};
+  }
+
+  // Boxes around both ends and the line moved to every corner of the box
+  // cover the outline of all the places where the box touches the line.
+  std::optional<RayHit> hit = CloserHit(
+      internal::Raycast(ray, BoxAround(a.x, a.y, half_width, half_height)),
+      internal::Raycast(ray, BoxAround(b.x, b.y, half_width, half_height)));
+  for (const float x : {-half_width, half_width}) {
+    for (const float y : {-half_height, half_height}) {
+      hit = CloserHit(hit, RaycastSegment(ray, {a.x + x, a.y + y},
+                                          {b.x + x, b.y + y}));
+    }
+  }
+  return hit;
+}
+
 // RECTANGLE COLLISION.
 bool RectangleInternal::Collides(const PointInternal& point) const {
   return point.Collides(*this);
@@ -180,16 +321,26 @@ bool RectangleInternal::Collides(
 }
 
 bool RectangleInternal::Collides(const CircleInternal& circle) const {
-  // Check if the center is inside rectangle.
-  if (this->Collides(circle.a)) {
-    return true;
-  }
+  // Distance from the circle center to the closest point of the rectangle,
+  // zero on the axis where the center is within the rectangle.
+  const float dx = std::max({a.x - circle.a.x, 0.0f, circle.a.x - c.x});
+  const float dy = std::max({c.y - circle.a.y, 0.0f, circle.a.y - a.y});
+  return square(dx) + square(dy) <= square(circle.r);
+}
 
-  // Otherwise check for circle collision with the rectangle sides one by one.
-  return circle.Collides(LineInternal(this->a, this->b)) ||
-         circle.Collides(LineInternal(this->b, this->c)) ||
-         circle.Collides(LineInternal(this->c, this->d)) ||
-         circle.Collides(LineInternal(this->d, this->a));
+std::optional<RayHit> RectangleInternal::Raycast(const Ray& ray) const {
+  return internal::Raycast(ray, BoundingBox());
+}
+std::optional<RayHit> RectangleInternal::CircleCast(const Ray& ray,
+                                                    const float radius) const {
+  return RaycastRoundedBox(ray, BoundingBox(), radius);
+}
+std::optional<RayHit> RectangleInternal::BoxCast(
+    const Ray& ray, const float half_width, const float half_height) const {
+  return internal::Raycast(ray, Aabb{.min_x = a.x - half_width,
+                                     .min_y = c.y - half_height,
+                                     .max_x = c.x + half_width,
+                                     .max_y = a.y + half_height});
 }
 
 // CIRCLE COLLISION.
@@ -203,7 +354,22 @@ bool CircleInternal::Collides(const RectangleInternal& rectangle) const {
   return rectangle.Collides(*this);
 }
 bool CircleInternal::Collides(const CircleInternal& other_circle) const {
-  return this->a.Distance(other_circle.a) <= this->r + other_circle.r;
+  return square(a.x - other_circle.a.x) + square(a.y - other_circle.a.y) <=
+         square(r + other_circle.r);
+}
+
+std::optional<RayHit> CircleInternal::Raycast(const Ray& ray) const {
+  return RaycastCircle(ray, {a.x, a.y}, r);
+}
+std::optional<RayHit> CircleInternal::CircleCast(const Ray& ray,
+                                                 const float radius) const {
+  return RaycastCircle(ray, {a.x, a.y}, r + radius);
+}
+std::optional<RayHit> CircleInternal::BoxCast(const Ray& ray,
+                                              const float half_width,
+                                              const float half_height) const {
+  return RaycastRoundedBox(ray, BoxAround(a.x, a.y, half_width, half_height),
+                           r);
 }
 
 }  // namespace internal
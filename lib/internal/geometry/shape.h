@@ -1,46 +1,46 @@
 #ifndef LIB_INTERNAL_GEOMETRY_SHAPE_H
 #define LIB_INTERNAL_GEOMETRY_SHAPE_H
 
+#include <optional>
 #include <utility>
 
 #include "absl/log/check.h"
+#include "aabb.h"
 #include "absl/strings/substitute.h"
+#include "ray.h"
 #include "vec.h"
 
 namespace lib {
 namespace internal {
 
+// Shapes are plain values without a common base class, `HitBox` stores one
+// of them inline and dispatches on the pair of shape types at compile time.
+//
+// Every shape can be cast against: `Raycast` returns the first hit of a ray
+// with the shape, `CircleCast` and `BoxCast` the first hit of a circle or of
+// an axis aligned box whose center moves along the ray. Points and lines are
+// as thick as the `eps` used by the collision tests.
 struct PointInternal;
 struct LineInternal;
 struct RectangleInternal;
 struct CircleInternal;
 
-struct Shape {
-  [[nodiscard]] virtual bool Collides(const PointInternal& point) const = 0;
-  [[nodiscard]] virtual bool Collides(const LineInternal& line) const = 0;
-  [[nodiscard]] virtual bool Collides(
-      const RectangleInternal& rectangle) const = 0;
-  [[nodiscard]] virtual bool Collides(const CircleInternal& circle) const = 0;
-  virtual void Draw() const = 0;
-  virtual void Move(float x, float y) = 0;
-
-  [[nodiscard]] virtual float center_x() const = 0;
-  [[nodiscard]] virtual float center_y() const = 0;
-
-  virtual ~Shape() = default;
-};
-
-struct PointInternal final : Shape {
-  [[nodiscard]] bool Collides(const PointInternal& other_point) const override;
-  [[nodiscard]] bool Collides(const LineInternal& line) const override;
-  [[nodiscard]] bool Collides(
-      const RectangleInternal& rectangle) const override;
-  [[nodiscard]] bool Collides(const CircleInternal& circle) const override;
-  void Draw() const override;
-  void Move(float xx, float yy) override;
-
-  [[nodiscard]] float center_x() const override { return x; }
-  [[nodiscard]] float center_y() const override { return y; }
+struct PointInternal {
+  [[nodiscard]] bool Collides(const PointInternal& other_point) const;
+  [[nodiscard]] bool Collides(const LineInternal& line) const;
+  [[nodiscard]] bool Collides(const RectangleInternal& rectangle) const;
+  [[nodiscard]] bool Collides(const CircleInternal& circle) const;
+  [[nodiscard]] std::optional<RayHit> Raycast(const Ray& ray) const;
+  [[nodiscard]] std::optional<RayHit> CircleCast(const Ray& ray,
+                                                 float radius) const;
+  [[nodiscard]] std::optional<RayHit> BoxCast(const Ray& ray, float half_width,
+                                              float half_height) const;
+  void Draw() const;
+  void Move(float xx, float yy);
+  [[nodiscard]] Aabb BoundingBox() const;
+
+  [[nodiscard]] float center_x() const { return x; }
+  [[nodiscard]] float center_y() const { return y; }
 
   PointInternal(const float x, const float y) : x(x), y(y) {}
   explicit PointInternal(std::pair<float, float> p) : x(p.first), y(p.second) {}
@@ -56,23 +56,28 @@ struct PointInternal final : Shape {
   float y;
 };
 
-struct LineInternal final : Shape {
+struct LineInternal {
   enum class Aligned { X, Y, NOT };
 
-  [[nodiscard]] bool Collides(const PointInternal& point) const override;
-  [[nodiscard]] bool Collides(const LineInternal& other_line) const override;
-  [[nodiscard]] bool Collides(
-      const RectangleInternal& rectangle) const override;
-  [[nodiscard]] bool Collides(const CircleInternal& circle) const override;
+  [[nodiscard]] bool Collides(const PointInternal& point) const;
+  [[nodiscard]] bool Collides(const LineInternal& other_line) const;
+  [[nodiscard]] bool Collides(const RectangleInternal& rectangle) const;
+  [[nodiscard]] bool Collides(const CircleInternal& circle) const;
   [[nodiscard]] Vector Reflect(const Vector& vec) const;
+  [[nodiscard]] std::optional<RayHit> Raycast(const Ray& ray) const;
+  [[nodiscard]] std::optional<RayHit> CircleCast(const Ray& ray,
+                                                 float radius) const;
+  [[nodiscard]] std::optional<RayHit> BoxCast(const Ray& ray, float half_width,
+                                              float half_height) const;
 
-  void Draw() const override;
-  void Move(float x, float y) override;
+  void Draw() const;
+  void Move(float x, float y);
+  [[nodiscard]] Aabb BoundingBox() const;
 
-  [[nodiscard]] float center_x() const override {
+  [[nodiscard]] float center_x() const {
     return (this->a.x + this->b.x) / 2.0f;
   }
-  [[nodiscard]] float center_y() const override {
+  [[nodiscard]] float center_y() const {
     return (this->a.y + this->b.y) / 2.0f;
   }
 
@@ -97,17 +102,22 @@ struct LineInternal final : Shape {
 
 // TODO(f1lo): Make this a class and make sure that invariants hold. i.e.
 // ordered vertices and 90 degree angles.
-struct RectangleInternal final : Shape {
-  [[nodiscard]] bool Collides(const PointInternal& point) const override;
-  [[nodiscard]] bool Collides(const LineInternal& line) const override;
-  [[nodiscard]] bool Collides(
-      const RectangleInternal& other_rectangle) const override;
-  [[nodiscard]] bool Collides(const CircleInternal& circle) const override;
-  void Draw() const override;
-  void Move(float x, float y) override;
-
-  [[nodiscard]] float center_x() const override { return (a.x + c.x) / 2.0f; }
-  [[nodiscard]] float center_y() const override { return (a.y + c.y) / 2.0f; }
+struct RectangleInternal {
+  [[nodiscard]] bool Collides(const PointInternal& point) const;
+  [[nodiscard]] bool Collides(const LineInternal& line) const;
+  [[nodiscard]] bool Collides(const RectangleInternal& other_rectangle) const;
+  [[nodiscard]] bool Collides(const CircleInternal& circle) const;
+  [[nodiscard]] std::optional<RayHit> Raycast(const Ray& ray) const;
+  [[nodiscard]] std::optional<RayHit> CircleCast(const Ray& ray,
+                                                 float radius) const;
+  [[nodiscard]] std::optional<RayHit> BoxCast(const Ray& ray, float half_width,
+                                              float half_height) const;
+  void Draw() const;
+  void Move(float x, float y);
+  [[nodiscard]] Aabb BoundingBox() const;
+
+  [[nodiscard]] float center_x() const { return (a.x + c.x) / 2.0f; }
+  [[nodiscard]] float center_y() const { return (a.y + c.y) / 2.0f; }
 
   RectangleInternal(const PointInternal& bottom_left,
                     const PointInternal& top_right)
@@ -127,18 +137,22 @@ struct RectangleInternal final : Shape {
   PointInternal d;
 };
 
-struct CircleInternal final : Shape {
-  [[nodiscard]] bool Collides(const PointInternal& point) const override;
-  [[nodiscard]] bool Collides(const LineInternal& line) const override;
-  [[nodiscard]] bool Collides(
-      const RectangleInternal& rectangle) const override;
-  [[nodiscard]] bool Collides(
-      const CircleInternal& other_circle) const override;
-  void Draw() const override;
-  void Move(float x, float y) override;
-
-  [[nodiscard]] float center_x() const override { return a.x; }
-  [[nodiscard]] float center_y() const override { return a.y; }
+struct CircleInternal {
+  [[nodiscard]] bool Collides(const PointInternal& point) const;
+  [[nodiscard]] bool Collides(const LineInternal& line) const;
+  [[nodiscard]] bool Collides(const RectangleInternal& rectangle) const;
+  [[nodiscard]] bool Collides(const CircleInternal& other_circle) const;
+  [[nodiscard]] std::optional<RayHit> Raycast(const Ray& ray) const;
+  [[nodiscard]] std::optional<RayHit> CircleCast(const Ray& ray,
+                                                 float radius) const;
+  [[nodiscard]] std::optional<RayHit> BoxCast(const Ray& ray, float half_width,
+                                              float half_height) const;
+  void Draw() const;
+  void Move(float x, float y);
+  [[nodiscard]] Aabb BoundingBox() const;
+
+  [[nodiscard]] float center_x() const { return a.x; }
+  [[nodiscard]] float center_y() const { return a.y; }
 
   CircleInternal(const PointInternal& a, const float r) : a(a), r(r) {
     CHECK(this->r > 0) << "Negative radius for circle: " << this->r;
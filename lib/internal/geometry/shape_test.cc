@@ -1,7 +1,11 @@
 #include "lib/internal/geometry/shape.h"
 
+#include <optional>
+#include <random>
+
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
+#include "lib/internal/geometry/ray.h"
 
 namespace lib {
 namespace internal {
@@ -75,6 +79,175 @@ TEST(ShapeTest, RectangleCenter) {
   EXPECT_FLOAT_EQ(a.center_y(), 2.0f);
 }
 
+TEST(ShapeTest, LineBoundingBox) {
+  const LineInternal a{PointInternal{6, 2}, PointInternal{1, 8}};
+
+  EXPECT_EQ(a.BoundingBox(),
+            (Aabb{.min_x = 1, .min_y = 2, .max_x = 6, .max_y = 8}));
+}
+
+TEST(ShapeTest, RectangleBoundingBox) {
+  const RectangleInternal a{PointInternal{0, 4}, PointInternal{4, 0}};
+
+  EXPECT_EQ(a.BoundingBox(),
+            (Aabb{.min_x = 0, .min_y = 0, .max_x = 4, .max_y = 4}));
+}
+
+TEST(ShapeTest, CircleBoundingBox) {
+  const CircleInternal a{PointInternal{1, 2}, 3};
+
+  EXPECT_EQ(a.BoundingBox(),
+            (Aabb{.min_x = -2, .min_y = -1, .max_x = 4, .max_y = 5}));
+}
+
+TEST(ShapeTest, Raycast) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+
+  EXPECT_NEAR(PointInternal(10, 0).Raycast(ray)->distance, 10, 1e-3);
+  EXPECT_FALSE(PointInternal(10, 1).Raycast(ray).has_value());
+  EXPECT_NEAR(LineInternal({10, -5}, {20, 5}).Raycast(ray)->distance, 15,
+              1e-3);
+  EXPECT_FLOAT_EQ(
+      RectangleInternal({10, 5}, {20, -5}).Raycast(ray)->distance, 10);
+  EXPECT_FLOAT_EQ(CircleInternal({10, 0}, 2).Raycast(ray)->distance, 8);
+}
+
+TEST(ShapeTest, CircleCast) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+
+  EXPECT_FLOAT_EQ(PointInternal(10, 1).CircleCast(ray, 1)->distance, 10);
+  EXPECT_FLOAT_EQ(
+      LineInternal({10, -5}, {10, 5}).CircleCast(ray, 2)->distance, 8);
+  EXPECT_FLOAT_EQ(
+      RectangleInternal({10, 5}, {20, -5}).CircleCast(ray, 2)->distance, 8);
+  EXPECT_FLOAT_EQ(CircleInternal({10, 0}, 2).CircleCast(ray, 3)->distance, 5);
+  EXPECT_FALSE(
+      RectangleInternal({10, 10}, {20, 5}).CircleCast(ray, 2).has_value());
+}
+
+TEST(ShapeTest, BoxCast) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+
+  EXPECT_FLOAT_EQ(PointInternal(10, 1).BoxCast(ray, 2, 1)->distance, 8);
+  EXPECT_FLOAT_EQ(
+      LineInternal({10, -5}, {10, 5}).BoxCast(ray, 2, 1)->distance, 8);
+  EXPECT_FLOAT_EQ(
+      RectangleInternal({10, 5}, {20, -5}).BoxCast(ray, 2, 1)->distance, 8);
+  EXPECT_FLOAT_EQ(CircleInternal({10, 0}, 2).BoxCast(ray, 2, 1)->distance, 6);
+  EXPECT_FALSE(
+      RectangleInternal({10, 10}, {20, 7}).BoxCast(ray, 2, 1).has_value());
+}
+
+TEST(ShapeTest, CastStartingInside) {
+  const Ray ray = {.origin = {0, 0}, .direction = {1, 0}, .max_distance = 100};
+  const LineInternal line({-1, -5}, {1, 5});
+
+  EXPECT_FLOAT_EQ(line.CircleCast(ray, 1)->distance, 0);
+  EXPECT_FLOAT_EQ(line.BoxCast(ray, 1, 1)->distance, 0);
+  EXPECT_EQ(line.BoxCast(ray, 1, 1)->normal, (Vector{-1, 0}));
+}
+
+// Shapes cast against each target are expected to touch it exactly at the
+// hit distance: not collide just before it and collide just after it.
+class RandomCasts {
+ public:
+  RandomCasts() : gen_(42), coordinate_(-40, 40), size_(0.5f, 10) {}
+
+  Ray MakeRay() {
+    const Vector direction = Vector{Coordinate(), Coordinate()}.ToUnitVector();
+    return {.origin = {Coordinate(), Coordinate()},
+            .direction = direction,
+            .max_distance = 100};
+  }
+  float Size() { return size_(gen_); }
+  float Coordinate() { return coordinate_(gen_); }
+
+  LineInternal Line() {
+    return LineInternal({Coordinate(), Coordinate()},
+                        {Coordinate(), Coordinate()});
+  }
+  RectangleInternal Rectangle() {
+    const float x = Coordinate();
+    const float y = Coordinate();
+    return RectangleInternal({x, y + Size()}, {x + Size(), y});
+  }
+  CircleInternal Circle() {
+    return CircleInternal({Coordinate(), Coordinate()}, Size());
+  }
+
+ private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<float> coordinate_;
+  std::uniform_real_distribution<float> size_;
+};
+
+constexpr int kCasts = 500;
+constexpr float kStep = 1e-2f;
+
+template <typename ShapeT, typename MakeMovingT>
+void ExpectTouchesAtHit(const ShapeT& target, const Ray& ray,
+                        const std::optional<RayHit>& hit,
+                        MakeMovingT make_moving) {
+  if (!hit.has_value()) {
+    for (float distance = 0; distance <= ray.max_distance; distance += 1) {
+      ASSERT_FALSE(make_moving(ray.At(distance)).Collides(target)) << distance;
+    }
+    return;
+  }
+  if (hit->distance == 0) {
+    ASSERT_TRUE(make_moving(ray.origin).Collides(target));
+    return;
+  }
+  ASSERT_TRUE(make_moving(ray.At(hit->distance + kStep)).Collides(target));
+  if (hit->distance > kStep) {
+    ASSERT_FALSE(make_moving(ray.At(hit->distance - kStep)).Collides(target));
+  }
+}
+
+TEST(ShapeTest, CircleCastMatchesCollides) {
+  RandomCasts random;
+  for (int i = 0; i < kCasts; ++i) {
+    const Ray ray = random.MakeRay();
+    const float radius = random.Size();
+    const auto make_circle = [radius](const Vector& center) {
+      return CircleInternal({center.x, center.y}, radius);
+    };
+    const LineInternal line = random.Line();
+    const RectangleInternal rectangle = random.Rectangle();
+    const CircleInternal circle = random.Circle();
+
+    ExpectTouchesAtHit(line, ray, line.CircleCast(ray, radius), make_circle);
+    ExpectTouchesAtHit(rectangle, ray, rectangle.CircleCast(ray, radius),
+                       make_circle);
+    ExpectTouchesAtHit(circle, ray, circle.CircleCast(ray, radius),
+                       make_circle);
+  }
+}
+
+TEST(ShapeTest, BoxCastMatchesCollides) {
+  RandomCasts random;
+  for (int i = 0; i < kCasts; ++i) {
+    const Ray ray = random.MakeRay();
+    const float half_width = random.Size();
+    const float half_height = random.Size();
+    const auto make_box = [half_width, half_height](const Vector& center) {
+      return RectangleInternal({center.x - half_width, center.y + half_height},
+                               {center.x + half_width, center.y - half_height});
+    };
+    const LineInternal line = random.Line();
+    const RectangleInternal rectangle = random.Rectangle();
+    const CircleInternal circle = random.Circle();
+
+    ExpectTouchesAtHit(line, ray, line.BoxCast(ray, half_width, half_height),
+                       make_box);
+    ExpectTouchesAtHit(rectangle, ray,
+                       rectangle.BoxCast(ray, half_width, half_height),
+                       make_box);
+    ExpectTouchesAtHit(circle, ray,
+                       circle.BoxCast(ray, half_width, half_height), make_box);
+  }
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace lib
@@ -1,11 +1,13 @@
 #include "lib/internal/hit_box.h"
 
-#include <memory>
-#include <vector>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
-#include "absl/status/statusor.h"
+#include "geometry/ray.h"
 #include "geometry/shape.h"
 
 namespace lib {
@@ -97,76 +99,97 @@ std::pair<float, float> ReflectFromRectangle(const RectangleInternal& rec,
 }  // namespace
 
 HitBox HitBox::CreateHitBox(const FPoint point) {
-  return HitBox{
-      std::make_unique<PointInternal>(PointInternal{point.x, point.y}),
-      ShapeType::POINT};
+  return HitBox{PointInternal{point.x, point.y}};
 }
 HitBox HitBox::CreateHitBox(const FLine line) {
-  return HitBox{std::make_unique<LineInternal>(
-                    LineInternal{PointInternal{line.a.x, line.a.y},
-                                 PointInternal{line.b.x, line.b.y}}),
-                ShapeType::LINE};
+  return HitBox{LineInternal{PointInternal{line.a.x, line.a.y},
+                             PointInternal{line.b.x, line.b.y}}};
 }
 HitBox HitBox::CreateHitBox(const FRectangle rectangle) {
-  return HitBox{
-      std::make_unique<RectangleInternal>(RectangleInternal{
-          {rectangle.top_left.x, rectangle.top_left.y + rectangle.height},
-          {rectangle.top_left.x + rectangle.width, rectangle.top_left.y}}),
-      ShapeType::RECTANGLE};
+  return HitBox{RectangleInternal{
+      {rectangle.top_left.x, rectangle.top_left.y + rectangle.height},
+      {rectangle.top_left.x + rectangle.width, rectangle.top_left.y}}};
 }
 HitBox HitBox::CreateHitBox(const FCircle circle) {
-  return HitBox{std::make_unique<CircleInternal>(CircleInternal{
-                    {circle.center.x, circle.center.y}, circle.radius}),
-                ShapeType::CIRCLE};
+  return HitBox{
+      CircleInternal{{circle.center.x, circle.center.y}, circle.radius}};
 }
 
 bool HitBox::CollidesWith(const HitBox& other) const {
-  switch (other.shape_type_) {
-    // Potentially unsafe if not careful.
-    case ShapeType::POINT:
-      return this->shape_->Collides(
-          *static_cast<PointInternal*>(other.shape_.get()));
-    case ShapeType::LINE:
-      return this->shape_->Collides(
-          *static_cast<LineInternal*>(other.shape_.get()));
-    case ShapeType::RECTANGLE:
-      return this->shape_->Collides(
-          *static_cast<RectangleInternal*>(other.shape_.get()));
-    case ShapeType::CIRCLE:
-      return this->shape_->Collides(
-          *static_cast<CircleInternal*>(other.shape_.get()));
-    default:
-      // This should never happen.
-      // `StatusOr` can be returned here, but it could hurt performance.
-      LOG(ERROR) << "HitBox::CollidesWith: invalid shape type";
-      return false;
-  }
+  // Visiting both variants builds a table of every pair of shapes at compile
+  // time, so a collision check is a single indirect call.
+  return std::visit(
+      [](const auto& shape, const auto& other_shape) {
+        return shape.Collides(other_shape);
+      },
+      shape_, other.shape_);
 }
 
 std::pair<float, float> HitBox::Reflect(const HitBox& other, const float x,
                                         const float y) const {
-  CHECK(shape_type_ == ShapeType::LINE || shape_type_ == ShapeType::RECTANGLE)
-      << "Reflection is only implemented from LineInternal or "
-         "RectangleInternal.";
   const Vector v = {x, y};
-  switch (shape_type_) {
-    case ShapeType::LINE: {
-      const auto [xx, yy] =
-          static_cast<LineInternal*>(shape_.get())->Reflect(v);
-      return {xx, yy};
-    }
-    case ShapeType::RECTANGLE:
-      return ReflectFromRectangle(
-          *static_cast<RectangleInternal*>(shape_.get()), v,
-          other.shape_->center_x(), other.shape_->center_y());
-    default:
-      CHECK(false) << "HitBox::Reflect: invalid shape type";
-      return {};
-  }
+  return std::visit(
+      [&v, &other](const auto& shape) -> std::pair<float, float> {
+        using ShapeT = std::decay_t<decltype(shape)>;
+        if constexpr (std::is_same_v<ShapeT, LineInternal>) {
+          const auto [xx, yy] = shape.Reflect(v);
+          return {xx, yy};
+        } else if constexpr (std::is_same_v<ShapeT, RectangleInternal>) {
+          return ReflectFromRectangle(shape, v, other.center_x(),
+                                      other.center_y());
+        } else {
+          CHECK(false) << "Reflection is only implemented from LineInternal "
+                          "or RectangleInternal.";
+          return {};
+        }
+      },
+      shape_);
+}
+
+std::optional<RayHit> HitBox::Raycast(const Ray& ray) const {
+  return std::visit([&ray](const auto& shape) { return shape.Raycast(ray); },
+                    shape_);
+}
+
+std::optional<RayHit> HitBox::CircleCast(const Ray& ray,
+                                         const float radius) const {
+  return std::visit(
+      [&ray, radius](const auto& shape) {
+        return shape.CircleCast(ray, radius);
+      },
+      shape_);
+}
+
+std::optional<RayHit> HitBox::BoxCast(const Ray& ray, const float half_width,
+                                      const float half_height) const {
+  return std::visit(
+      [&ray, half_width, half_height](const auto& shape) {
+        return shape.BoxCast(ray, half_width, half_height);
+      },
+      shape_);
 }
 
 void HitBox::Draw() const {
-  shape_->Draw();
+  std::visit([](const auto& shape) { shape.Draw(); }, shape_);
+}
+
+void HitBox::Move(const float x, const float y) {
+  std::visit([x, y](auto& shape) { shape.Move(x, y); }, shape_);
+}
+
+Aabb HitBox::aabb() const {
+  return std::visit([](const auto& shape) { return shape.BoundingBox(); },
+                    shape_);
+}
+
+float HitBox::center_x() const {
+  return std::visit([](const auto& shape) { return shape.center_x(); },
+                    shape_);
+}
+
+float HitBox::center_y() const {
+  return std::visit([](const auto& shape) { return shape.center_y(); },
+                    shape_);
 }
 
 }  // namespace internal
@@ -1,9 +1,11 @@
 #ifndef LIB_INTERNAL_HIT_BOX_H
 #define LIB_INTERNAL_HIT_BOX_H
 
-#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
 
-#include "absl/status/statusor.h"
+#include "geometry/ray.h"
 #include "geometry/shape.h"
 #include "lib/api/common_types.h"
 
@@ -20,23 +22,30 @@ class HitBox {
   [[nodiscard]] bool CollidesWith(const HitBox& other) const;
   [[nodiscard]] std::pair<float, float> Reflect(const HitBox& other, float x,
                                                 float y) const;
+  // See `Raycast`, `CircleCast` and `BoxCast` of the shapes.
+  [[nodiscard]] std::optional<RayHit> Raycast(const Ray& ray) const;
+  [[nodiscard]] std::optional<RayHit> CircleCast(const Ray& ray,
+                                                 float radius) const;
+  [[nodiscard]] std::optional<RayHit> BoxCast(const Ray& ray, float half_width,
+                                              float half_height) const;
   void Draw() const;
-  void Move(const float x, const float y) const { shape_->Move(x, y); }
+  void Move(float x, float y);
+  [[nodiscard]] Aabb aabb() const;
 
-  [[nodiscard]] float center_x() const { return shape_->center_x(); }
-  [[nodiscard]] float center_y() const { return shape_->center_y(); }
+  [[nodiscard]] float center_x() const;
+  [[nodiscard]] float center_y() const;
 
  private:
-  // TODO(f1lo): Make this type agnostic.
-  // When adding new types make sure that `CollidesWith` is appropriately
-  // updated.
-  enum class ShapeType { POINT, LINE, RECTANGLE, CIRCLE };
+  // When adding new shapes make sure that every shape implements `Collides`
+  // for it, otherwise the dispatch in `CollidesWith` does not compile.
+  typedef std::variant<PointInternal, LineInternal, RectangleInternal,
+                       CircleInternal>
+      ShapeVariant;
 
-  HitBox(std::unique_ptr<Shape> shape, const ShapeType type)
-      : shape_(std::move(shape)), shape_type_(type) {}
+  explicit HitBox(const ShapeVariant& shape) : shape_(shape) {}
 
-  std::unique_ptr<Shape> shape_;
-  ShapeType shape_type_;
+  // Stored inline so that hit boxes need no allocation and no pointer chase.
+  ShapeVariant shape_;
 };
 }  // namespace internal
 }  // namespace lib
@@ -4,6 +4,7 @@
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
 #include "lib/api/common_types.h"
+#include "lib/internal/geometry/ray.h"
 
 namespace lib {
 namespace internal {
@@ -311,6 +312,44 @@ TEST_F(HitBoxTest, RectangleReflectionTop2) {
             std::make_pair(-speed.x, speed.y));
 }
 
+TEST_F(HitBoxTest, RectangleAabb) {
+  EXPECT_EQ(rectangle_.aabb(),
+            (Aabb{.min_x = -5, .min_y = -1, .max_x = 6, .max_y = 4}));
+}
+
+TEST_F(HitBoxTest, AabbFollowsMove) {
+  circle_.Move(1, -1);
+
+  EXPECT_EQ(circle_.aabb(),
+            (Aabb{.min_x = 0, .min_y = -2, .max_x = 6, .max_y = 4}));
+}
+
+TEST_F(HitBoxTest, CopyIsIndependent) {
+  HitBox copy = circle_;
+
+  copy.Move(10, 0);
+
+  EXPECT_EQ(circle_.center_x(), 2);
+  EXPECT_EQ(copy.center_x(), 12);
+  EXPECT_FALSE(copy.CollidesWith(circle_));
+}
+
+TEST_F(HitBoxTest, Casts) {
+  const Ray ray = {
+      .origin = {-20, 2}, .direction = {1, 0}, .max_distance = 100};
+
+  EXPECT_FLOAT_EQ(rectangle_.Raycast(ray)->distance, 15);
+  EXPECT_FLOAT_EQ(circle_.Raycast(ray)->distance, 19);
+  EXPECT_FLOAT_EQ(circle_.CircleCast(ray, 1)->distance, 18);
+  EXPECT_FLOAT_EQ(rectangle_.BoxCast(ray, 1, 1)->distance, 14);
+  EXPECT_FALSE(different_point_.Raycast(ray).has_value());
+}
+
+TEST_F(HitBoxTest, ReflectFromCircleDies) {
+  EXPECT_DEATH((void)circle_.Reflect(point_, 1, 1),
+               HasSubstr("Reflection is only implemented"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace lib
@@ -0,0 +1,159 @@
+#include "lib/internal/job_system.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+constexpr size_t kChunksPerThread = 4;
+
+}  // namespace
+
+JobSystem::JobSystem(const int num_threads) {
+  CHECK(num_threads > 0) << "At least one thread is required, have: "
+                         << num_threads;
+  for (int i = 0; i < num_threads; ++i) {
+    deques_.push_back(std::make_unique<Deque>());
+  }
+  workers_.reserve(num_threads - 1);
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+  }
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void JobSystem::ParallelFor(const size_t count,
+                            const absl::FunctionRef<void(size_t)> job) {
+  if (workers_.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      job(i);
+    }
+    return;
+  }
+
+  // Neighbouring jobs go to the same thread, they often touch neighbouring
+  // memory.
+  for (size_t deque = 0; deque < deques_.size(); ++deque) {
+    absl::MutexLock lock(&deques_[deque]->mu);
+    deques_[deque]->jobs.clear();
+    deques_[deque]->front = 0;
+    for (size_t i = count * deque / deques_.size();
+         i < count * (deque + 1) / deques_.size(); ++i) {
+      deques_[deque]->jobs.push_back(i);
+    }
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    job_ = &job;
+    busy_workers_ = static_cast<int>(workers_.size());
+    ++generation_;
+  }
+  RunJobs(/*own_deque=*/0, job);
+
+  absl::MutexLock lock(&mu_);
+  const auto all_workers_idle = [this]() {
+    mu_.AssertHeld();
+    return busy_workers_ == 0;
+  };
+  mu_.Await(absl::Condition(&all_workers_idle));
+  job_ = nullptr;
+}
+
+void JobSystem::ParallelForChunks(
+    const size_t count,
+    const absl::FunctionRef<void(size_t chunk, size_t begin, size_t end)>
+        job) {
+  const size_t num_chunks = NumChunks(count);
+  ParallelFor(num_chunks, [count, num_chunks, job](const size_t chunk) {
+    job(chunk, count * chunk / num_chunks, count * (chunk + 1) / num_chunks);
+  });
+}
+
+size_t JobSystem::NumChunks(const size_t count) const {
+  return std::min(count, workers_.empty() ? size_t{1}
+                                          : deques_.size() * kChunksPerThread);
+}
+
+void JobSystem::WorkerLoop(const size_t deque) {
+  uint64_t seen_generation = 0;
+  while (true) {
+    const absl::FunctionRef<void(size_t)>* job;
+    {
+      absl::MutexLock lock(&mu_);
+      const auto has_work = [this, &seen_generation]() {
+        mu_.AssertHeld();
+        return stop_ || generation_ != seen_generation;
+      };
+      mu_.Await(absl::Condition(&has_work));
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+      job = job_;
+    }
+
+    RunJobs(deque, *job);
+
+    absl::MutexLock lock(&mu_);
+    --busy_workers_;
+  }
+}
+
+void JobSystem::RunJobs(const size_t own_deque,
+                        const absl::FunctionRef<void(size_t)> job) {
+  // No jobs are added while they run, once every deque has been found empty
+  // there is nothing left to do.
+  while (true) {
+    std::optional<size_t> next = Pop(own_deque);
+    for (size_t offset = 1; !next.has_value() && offset < deques_.size();
+         ++offset) {
+      next = Steal((own_deque + offset) % deques_.size());
+    }
+    if (!next.has_value()) {
+      return;
+    }
+    job(*next);
+  }
+}
+
+std::optional<size_t> JobSystem::Pop(const size_t deque) {
+  absl::MutexLock lock(&deques_[deque]->mu);
+  std::vector<size_t>& jobs = deques_[deque]->jobs;
+  if (jobs.size() == deques_[deque]->front) {
+    return std::nullopt;
+  }
+  const size_t job = jobs.back();
+  jobs.pop_back();
+  return job;
+}
+
+std::optional<size_t> JobSystem::Steal(const size_t deque) {
+  absl::MutexLock lock(&deques_[deque]->mu);
+  if (deques_[deque]->jobs.size() == deques_[deque]->front) {
+    return std::nullopt;
+  }
+  return deques_[deque]->jobs[deques_[deque]->front++];
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,77 @@
+#ifndef LIB_INTERNAL_JOB_SYSTEM_H
+#define LIB_INTERNAL_JOB_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+
+namespace lib {
+namespace internal {
+
+// Fixed set of threads which run the jobs of a parallel for. Every thread has
+// its own deque of jobs: it takes its jobs from the back, and once it runs out
+// steals the oldest jobs from the front of the other deques - so a thread
+// which got cheap jobs helps the others instead of waiting for them. The
+// thread calling `ParallelFor` takes part in the work, so a job system of a
+// single thread does not start any threads at all.
+class JobSystem {
+ public:
+  explicit JobSystem(int num_threads);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  // Calls `job(i)` for every `i` in [0, `count`) and blocks until all of the
+  // calls have returned. Jobs may run in any order.
+  void ParallelFor(size_t count, absl::FunctionRef<void(size_t)> job);
+  // Splits [0, `count`) into `NumChunks(count)` ranges and calls
+  // `job(chunk, begin, end)` for each of them. Chunks are numbered in the
+  // order of their ranges, so output written per chunk can be merged in a
+  // deterministic order afterwards.
+  void ParallelForChunks(
+      size_t count,
+      absl::FunctionRef<void(size_t chunk, size_t begin, size_t end)> job);
+  // More chunks than threads, so that there is something left to steal.
+  [[nodiscard]] size_t NumChunks(size_t count) const;
+
+  [[nodiscard]] int num_threads() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+ private:
+  // Jobs of a single thread, `jobs[front, end)` are left.
+  struct Deque {
+    absl::Mutex mu;
+    std::vector<size_t> jobs ABSL_GUARDED_BY(mu);
+    size_t front ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  void WorkerLoop(size_t deque);
+  // Runs jobs until every deque is empty.
+  void RunJobs(size_t own_deque, absl::FunctionRef<void(size_t)> job);
+  [[nodiscard]] std::optional<size_t> Pop(size_t deque);
+  [[nodiscard]] std::optional<size_t> Steal(size_t deque);
+
+  absl::Mutex mu_;
+  // Incremented for every `ParallelFor`, wakes up the workers.
+  uint64_t generation_ ABSL_GUARDED_BY(mu_) = 0;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+  int busy_workers_ ABSL_GUARDED_BY(mu_) = 0;
+  const absl::FunctionRef<void(size_t)>* job_ ABSL_GUARDED_BY(mu_) = nullptr;
+  // One per thread, the calling thread owns the first one.
+  std::vector<std::unique_ptr<Deque>> deques_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_JOB_SYSTEM_H
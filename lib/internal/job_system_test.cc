@@ -0,0 +1,110 @@
+#include "lib/internal/job_system.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+TEST(JobSystemTest, RunsEveryJobOnce) {
+  JobSystem jobs(/*num_threads=*/4);
+  std::vector<std::atomic<int>> calls(1000);
+
+  jobs.ParallelFor(calls.size(), [&calls](const size_t i) { ++calls[i]; });
+
+  for (const std::atomic<int>& call : calls) {
+    EXPECT_EQ(call.load(), 1);
+  }
+}
+
+TEST(JobSystemTest, CanBeReused) {
+  JobSystem jobs(/*num_threads=*/3);
+  std::atomic<int> sum = 0;
+
+  for (int round = 0; round < 100; ++round) {
+    jobs.ParallelFor(10, [&sum](const size_t i) {
+      sum += static_cast<int>(i);
+    });
+  }
+
+  EXPECT_EQ(sum.load(), 100 * 45);
+}
+
+TEST(JobSystemTest, IdleThreadsSteal) {
+  JobSystem jobs(/*num_threads=*/4);
+  // The calling thread owns the first quarter of the jobs, which are slow.
+  std::vector<std::thread::id> ran_on(16);
+  const std::thread::id caller = std::this_thread::get_id();
+
+  jobs.ParallelFor(ran_on.size(), [&ran_on](const size_t i) {
+    if (i < 4) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ran_on[i] = std::this_thread::get_id();
+  });
+
+  int stolen = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    stolen += ran_on[i] != caller ? 1 : 0;
+  }
+  EXPECT_GT(stolen, 0);
+}
+
+TEST(JobSystemTest, ChunksCoverRangeInOrder) {
+  JobSystem jobs(/*num_threads=*/3);
+  std::vector<std::pair<size_t, size_t>> ranges(jobs.NumChunks(100));
+
+  jobs.ParallelForChunks(100, [&ranges](const size_t chunk, const size_t begin,
+                                        const size_t end) {
+    ranges[chunk] = {begin, end};
+  });
+
+  ASSERT_EQ(ranges.size(), 12);
+  EXPECT_EQ(ranges.front().first, 0);
+  EXPECT_EQ(ranges.back().second, 100);
+  for (size_t chunk = 1; chunk < ranges.size(); ++chunk) {
+    EXPECT_EQ(ranges[chunk].first, ranges[chunk - 1].second);
+    EXPECT_LT(ranges[chunk].first, ranges[chunk].second);
+  }
+  EXPECT_EQ(jobs.NumChunks(5), 5);
+  EXPECT_EQ(JobSystem(/*num_threads=*/1).NumChunks(100), 1);
+}
+
+TEST(JobSystemTest, SingleThreadRunsInOrder) {
+  JobSystem jobs(/*num_threads=*/1);
+  std::vector<size_t> order;
+
+  jobs.ParallelFor(5, [&order](const size_t i) { order.push_back(i); });
+
+  EXPECT_THAT(order, ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_EQ(jobs.num_threads(), 1);
+}
+
+TEST(JobSystemTest, NoJobs) {
+  JobSystem jobs(/*num_threads=*/2);
+  int calls = 0;
+
+  jobs.ParallelFor(0, [&calls](size_t) { ++calls; });
+  jobs.ParallelForChunks(0, [&calls](size_t, size_t, size_t) { ++calls; });
+
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(JobSystemDeathTest, NeedsThreads) {
+  EXPECT_DEATH(JobSystem(/*num_threads=*/0),
+               HasSubstr("At least one thread is required"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
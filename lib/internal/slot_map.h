@@ -0,0 +1,119 @@
+#ifndef LIB_INTERNAL_SLOT_MAP_H
+#define LIB_INTERNAL_SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "absl/base/nullability.h"
+
+namespace lib {
+namespace internal {
+
+// Refers to a value of a `SlotMap`. Once the value is erased the handle is
+// stale: it never refers to another value, even one stored in the same slot.
+struct SlotHandle {
+  static constexpr uint32_t kInvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
+  uint32_t index = kInvalidIndex;
+  uint32_t generation = 0;
+
+  bool operator==(const SlotHandle& other) const = default;
+};
+
+// Values stored contiguously, so that iterating them does not chase pointers.
+// Insert and erase take constant time. Erasing moves the last value into the
+// gap, so values are in the order they were inserted in only until the first
+// erase. Pointers to the values are invalidated by both, handles are not.
+template <typename T>
+class SlotMap {
+ public:
+  SlotHandle Insert(T value) {
+    uint32_t index;
+    if (free_slots_.empty()) {
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back({});
+    } else {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    Slot& slot = slots_[index];
+    slot.dense_index = static_cast<uint32_t>(values_.size());
+    values_.push_back(std::move(value));
+    dense_to_slot_.push_back(index);
+    return {.index = index, .generation = slot.generation};
+  }
+
+  // Returns false if `handle` is stale.
+  bool Erase(const SlotHandle handle) {
+    if (!Contains(handle)) {
+      return false;
+    }
+    Slot& slot = slots_[handle.index];
+    const uint32_t last = static_cast<uint32_t>(values_.size()) - 1;
+    if (slot.dense_index != last) {
+      values_[slot.dense_index] = std::move(values_[last]);
+      dense_to_slot_[slot.dense_index] = dense_to_slot_[last];
+      slots_[dense_to_slot_[last]].dense_index = slot.dense_index;
+    }
+    values_.pop_back();
+    dense_to_slot_.pop_back();
+    slot.dense_index = SlotHandle::kInvalidIndex;
+    ++slot.generation;
+    free_slots_.push_back(handle.index);
+    return true;
+  }
+
+  [[nodiscard]] bool Contains(const SlotHandle handle) const {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].generation == handle.generation &&
+           slots_[handle.index].dense_index != SlotHandle::kInvalidIndex;
+  }
+  // Null if `handle` is stale.
+  [[nodiscard]] absl::Nullable<T*> Find(const SlotHandle handle) {
+    return Contains(handle) ? &values_[slots_[handle.index].dense_index]
+                            : nullptr;
+  }
+  [[nodiscard]] absl::Nullable<const T*> Find(const SlotHandle handle) const {
+    return Contains(handle) ? &values_[slots_[handle.index].dense_index]
+                            : nullptr;
+  }
+  // Handle of `values()[dense_index]`.
+  [[nodiscard]] SlotHandle handle(const size_t dense_index) const {
+    const uint32_t index = dense_to_slot_[dense_index];
+    return {.index = index, .generation = slots_[index].generation};
+  }
+
+  [[nodiscard]] std::span<T> values() { return values_; }
+  [[nodiscard]] std::span<const T> values() const { return values_; }
+  [[nodiscard]] size_t size() const { return values_.size(); }
+  [[nodiscard]] bool empty() const { return values_.empty(); }
+
+  auto begin() { return values_.begin(); }
+  auto end() { return values_.end(); }
+  auto begin() const { return values_.begin(); }
+  auto end() const { return values_.end(); }
+
+ private:
+  struct Slot {
+    // Where the value is in `values_`, invalid while the slot is free.
+    uint32_t dense_index = SlotHandle::kInvalidIndex;
+    // Incremented every time the value of the slot is erased.
+    uint32_t generation = 0;
+  };
+
+  std::vector<T> values_;
+  // Slot of every value in `values_`, used to fix it up when a value moves.
+  std::vector<uint32_t> dense_to_slot_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_SLOT_MAP_H
@@ -0,0 +1,84 @@
+#include "lib/internal/slot_map.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(SlotMapTest, InsertAndFind) {
+  SlotMap<std::string> slot_map;
+
+  const SlotHandle a = slot_map.Insert("a");
+  const SlotHandle b = slot_map.Insert("b");
+
+  ASSERT_NE(slot_map.Find(a), nullptr);
+  EXPECT_EQ(*slot_map.Find(a), "a");
+  ASSERT_NE(slot_map.Find(b), nullptr);
+  EXPECT_EQ(*slot_map.Find(b), "b");
+  EXPECT_THAT(slot_map.values(), ElementsAre("a", "b"));
+  EXPECT_EQ(slot_map.handle(1), b);
+}
+
+TEST(SlotMapTest, EraseMovesLastValue) {
+  SlotMap<std::string> slot_map;
+  const SlotHandle a = slot_map.Insert("a");
+  const SlotHandle b = slot_map.Insert("b");
+  const SlotHandle c = slot_map.Insert("c");
+
+  EXPECT_TRUE(slot_map.Erase(a));
+
+  EXPECT_THAT(slot_map.values(), ElementsAre("c", "b"));
+  EXPECT_EQ(slot_map.handle(0), c);
+  EXPECT_EQ(*slot_map.Find(b), "b");
+  EXPECT_EQ(*slot_map.Find(c), "c");
+  EXPECT_FALSE(slot_map.Contains(a));
+  EXPECT_EQ(slot_map.Find(a), nullptr);
+  EXPECT_FALSE(slot_map.Erase(a));
+}
+
+TEST(SlotMapTest, ReusedSlotDoesNotMatchStaleHandle) {
+  SlotMap<std::string> slot_map;
+  const SlotHandle a = slot_map.Insert("a");
+  slot_map.Erase(a);
+
+  const SlotHandle b = slot_map.Insert("b");
+
+  EXPECT_EQ(b.index, a.index);
+  EXPECT_NE(b, a);
+  EXPECT_EQ(slot_map.Find(a), nullptr);
+  EXPECT_EQ(*slot_map.Find(b), "b");
+}
+
+TEST(SlotMapTest, MoveOnlyValues) {
+  SlotMap<std::unique_ptr<int>> slot_map;
+  const SlotHandle one = slot_map.Insert(std::make_unique<int>(1));
+  const SlotHandle two = slot_map.Insert(std::make_unique<int>(2));
+
+  slot_map.Erase(one);
+
+  ASSERT_EQ(slot_map.size(), 1);
+  EXPECT_EQ(**slot_map.Find(two), 2);
+  slot_map.Erase(two);
+  EXPECT_TRUE(slot_map.empty());
+  EXPECT_THAT(slot_map.values(), IsEmpty());
+}
+
+TEST(SlotMapTest, InvalidHandle) {
+  SlotMap<std::string> slot_map;
+  slot_map.Insert("a");
+
+  EXPECT_FALSE(slot_map.Contains(SlotHandle()));
+  EXPECT_EQ(slot_map.Find(SlotHandle()), nullptr);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
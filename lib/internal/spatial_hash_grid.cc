@@ -0,0 +1,311 @@
+#include "lib/internal/spatial_hash_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+#include "lib/internal/geometry/vec.h"
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+// Keeps cell coordinates of far away (or infinite) boxes representable.
+constexpr float kMaxCellCoordinate = 1 << 30;
+
+int ToCell(const float coordinate, const float cell_size) {
+  return static_cast<int>(std::clamp(std::floor(coordinate / cell_size),
+                                     -kMaxCellCoordinate, kMaxCellCoordinate));
+}
+
+}  // namespace
+
+SpatialHashGrid::SpatialHashGrid(const float cell_size)
+    : cell_size_(cell_size) {
+  CHECK(cell_size_ > 0) << "Cell size must be positive, have: " << cell_size_;
+}
+
+uint64_t SpatialHashGrid::CellKey(const int x, const int y) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 |
+         static_cast<uint32_t>(y);
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::ToCellRange(
+    const Aabb& aabb) const {
+  return {.min_x = ToCell(aabb.min_x, cell_size_),
+          .min_y = ToCell(aabb.min_y, cell_size_),
+          .max_x = ToCell(aabb.max_x, cell_size_),
+          .max_y = ToCell(aabb.max_y, cell_size_)};
+}
+
+void SpatialHashGrid::AddToCell(const ProxyId id, const int x, const int y) {
+  cells_[CellKey(x, y)].push_back(id);
+}
+
+void SpatialHashGrid::RemoveFromCell(const ProxyId id, const int x,
+                                     const int y) {
+  const auto cell_it = cells_.find(CellKey(x, y));
+  CHECK(cell_it != cells_.end())
+      << "Proxy " << id << " is not in cell (" << x << ", " << y << ").";
+  std::vector<ProxyId>& cell = cell_it->second;
+  const auto it = std::ranges::find(cell, id);
+  CHECK(it != cell.end())
+      << "Proxy " << id << " is not in cell (" << x << ", " << y << ").";
+  *it = cell.back();
+  cell.pop_back();
+  if (cell.empty()) {
+    cells_.erase(cell_it);
+  }
+}
+
+void SpatialHashGrid::AddToCells(const ProxyId id, const Proxy& proxy) {
+  if (proxy.oversized) {
+    oversized_.push_back(id);
+    return;
+  }
+  for (int x = proxy.cells.min_x; x <= proxy.cells.max_x; ++x) {
+    for (int y = proxy.cells.min_y; y <= proxy.cells.max_y; ++y) {
+      AddToCell(id, x, y);
+    }
+  }
+}
+
+void SpatialHashGrid::RemoveFromCells(const ProxyId id, const Proxy& proxy) {
+  if (proxy.oversized) {
+    const auto it = std::ranges::find(oversized_, id);
+    CHECK(it != oversized_.end()) << "Proxy " << id << " is not oversized.";
+    *it = oversized_.back();
+    oversized_.pop_back();
+    return;
+  }
+  for (int x = proxy.cells.min_x; x <= proxy.cells.max_x; ++x) {
+    for (int y = proxy.cells.min_y; y <= proxy.cells.max_y; ++y) {
+      RemoveFromCell(id, x, y);
+    }
+  }
+}
+
+void SpatialHashGrid::Insert(const ProxyId id, const Aabb& aabb) {
+  const CellRange cells = ToCellRange(aabb);
+  const Proxy proxy = {.aabb = aabb,
+                       .cells = cells,
+                       .oversized = cells.total_cells() > kMaxCellsPerProxy};
+  const auto [it, inserted] = proxies_.try_emplace(id, proxy);
+  CHECK(inserted) << "Proxy " << id << " is already in the grid.";
+  AddToCells(id, proxy);
+}
+
+void SpatialHashGrid::Update(const ProxyId id, const Aabb& aabb) {
+  const auto it = proxies_.find(id);
+  CHECK(it != proxies_.end()) << "Proxy " << id << " is not in the grid.";
+  Proxy& proxy = it->second;
+  proxy.aabb = aabb;
+  const CellRange new_cells = ToCellRange(aabb);
+  if (new_cells == proxy.cells) {
+    return;
+  }
+
+  const bool new_oversized = new_cells.total_cells() > kMaxCellsPerProxy;
+  if (proxy.oversized || new_oversized) {
+    RemoveFromCells(id, proxy);
+    proxy.cells = new_cells;
+    proxy.oversized = new_oversized;
+    AddToCells(id, proxy);
+    return;
+  }
+
+  // Only touch the cells which were left or entered.
+  const CellRange old_cells = proxy.cells;
+  for (int x = old_cells.min_x; x <= old_cells.max_x; ++x) {
+    for (int y = old_cells.min_y; y <= old_cells.max_y; ++y) {
+      if (!new_cells.Contains(x, y)) {
+        RemoveFromCell(id, x, y);
+      }
+    }
+  }
+  for (int x = new_cells.min_x; x <= new_cells.max_x; ++x) {
+    for (int y = new_cells.min_y; y <= new_cells.max_y; ++y) {
+      if (!old_cells.Contains(x, y)) {
+        AddToCell(id, x, y);
+      }
+    }
+  }
+  proxy.cells = new_cells;
+}
+
+void SpatialHashGrid::Remove(const ProxyId id) {
+  const auto it = proxies_.find(id);
+  CHECK(it != proxies_.end()) << "Proxy " << id << " is not in the grid.";
+  RemoveFromCells(id, it->second);
+  proxies_.erase(it);
+}
+
+void SpatialHashGrid::Query(const Aabb& aabb,
+                            absl::FunctionRef<void(ProxyId)> callback) const {
+  const CellRange query_cells = ToCellRange(aabb);
+  // Walking a huge range cell by cell is slower than checking every proxy.
+  if (query_cells.total_cells() > kMaxCellsPerProxy) {
+    for (const auto& [id, proxy] : proxies_) {
+      if (proxy.aabb.Overlaps(aabb)) {
+        callback(id);
+      }
+    }
+    return;
+  }
+
+  for (const ProxyId id : oversized_) {
+    if (proxies_.at(id).aabb.Overlaps(aabb)) {
+      callback(id);
+    }
+  }
+  for (int x = query_cells.min_x; x <= query_cells.max_x; ++x) {
+    for (int y = query_cells.min_y; y <= query_cells.max_y; ++y) {
+      const auto cell_it = cells_.find(CellKey(x, y));
+      if (cell_it == cells_.end()) {
+        continue;
+      }
+      for (const ProxyId id : cell_it->second) {
+        const Proxy& proxy = proxies_.at(id);
+        // A proxy spanning several cells is only reported from the first cell
+        // shared with the query, which deduplicates without extra memory.
+        if (x != std::max(proxy.cells.min_x, query_cells.min_x) ||
+            y != std::max(proxy.cells.min_y, query_cells.min_y)) {
+          continue;
+        }
+        if (proxy.aabb.Overlaps(aabb)) {
+          callback(id);
+        }
+      }
+    }
+  }
+}
+
+void SpatialHashGrid::QueryRay(
+    const Ray& ray, const float thickness,
+    const absl::FunctionRef<void(ProxyId)> callback) const {
+  const auto report = [this, &ray, thickness, callback](const ProxyId id) {
+    if (Raycast(ray, proxies_.at(id).aabb.Expand(thickness)).has_value()) {
+      callback(id);
+    }
+  };
+  // Thick rays reach into cells next to the crossed ones, look at everything
+  // around the ray instead.
+  if (thickness > 0) {
+    Query(ray.BoundingBox().Expand(thickness), report);
+    return;
+  }
+  const Vector end = ray.At(ray.max_distance);
+  int x = ToCell(ray.origin.x, cell_size_);
+  int y = ToCell(ray.origin.y, cell_size_);
+  const int64_t cells_to_cross =
+      std::abs(static_cast<int64_t>(ToCell(end.x, cell_size_)) - x) +
+      std::abs(static_cast<int64_t>(ToCell(end.y, cell_size_)) - y);
+  // Walking a very long ray cell by cell is slower than checking every proxy.
+  if (cells_to_cross > kMaxCellsPerProxy) {
+    for (const auto& [id, proxy] : proxies_) {
+      report(id);
+    }
+    return;
+  }
+
+  for (const ProxyId id : oversized_) {
+    report(id);
+  }
+  // Proxies spanning several crossed cells are found more than once. Reused
+  // between queries to avoid allocating, thread local so that several threads
+  // can query at once.
+  thread_local std::vector<ProxyId> candidates;
+  candidates.clear();
+  // Distance along the ray to the next vertical and horizontal cell border.
+  const auto first_border = [this](const float origin, const float direction,
+                                   const int cell) {
+    if (direction == 0) {
+      return std::numeric_limits<float>::infinity();
+    }
+    const int border = direction > 0 ? cell + 1 : cell;
+    return (border * cell_size_ - origin) / direction;
+  };
+  float next_x = first_border(ray.origin.x, ray.direction.x, x);
+  float next_y = first_border(ray.origin.y, ray.direction.y, y);
+  const float step_x = cell_size_ / std::abs(ray.direction.x);
+  const float step_y = cell_size_ / std::abs(ray.direction.y);
+  for (int64_t crossed = 0;; ++crossed) {
+    const auto cell_it = cells_.find(CellKey(x, y));
+    if (cell_it != cells_.end()) {
+      candidates.insert(candidates.end(), cell_it->second.begin(),
+                        cell_it->second.end());
+    }
+    if (crossed == cells_to_cross) {
+      break;
+    }
+    if (next_x < next_y) {
+      x += ray.direction.x > 0 ? 1 : -1;
+      next_x += step_x;
+    } else {
+      y += ray.direction.y > 0 ? 1 : -1;
+      next_y += step_y;
+    }
+  }
+  std::ranges::sort(candidates);
+  const auto duplicates = std::ranges::unique(candidates);
+  candidates.erase(duplicates.begin(), duplicates.end());
+  for (const ProxyId id : candidates) {
+    report(id);
+  }
+}
+
+void SpatialHashGrid::QueryPairs(
+    const absl::FunctionRef<void(ProxyId, ProxyId)> callback) const {
+  const auto report = [&callback](const ProxyId a, const ProxyId b) {
+    if (a < b) {
+      callback(a, b);
+    } else {
+      callback(b, a);
+    }
+  };
+
+  for (size_t i = 0; i < oversized_.size(); ++i) {
+    const Proxy& oversized = proxies_.at(oversized_[i]);
+    for (const auto& [id, proxy] : proxies_) {
+      // Pairs of two oversized proxies are reported by the first one only.
+      if (id == oversized_[i] ||
+          (proxy.oversized &&
+           std::ranges::find(oversized_.begin(), oversized_.begin() + i,
+                             id) != oversized_.begin() + i)) {
+        continue;
+      }
+      if (oversized.aabb.Overlaps(proxy.aabb)) {
+        report(oversized_[i], id);
+      }
+    }
+  }
+
+  for (const auto& [key, cell] : cells_) {
+    for (size_t i = 0; i < cell.size(); ++i) {
+      const Proxy& a = proxies_.at(cell[i]);
+      for (size_t j = i + 1; j < cell.size(); ++j) {
+        const Proxy& b = proxies_.at(cell[j]);
+        // Proxies sharing several cells are only reported from the first
+        // shared cell.
+        if (key != CellKey(std::max(a.cells.min_x, b.cells.min_x),
+                           std::max(a.cells.min_y, b.cells.min_y))) {
+          continue;
+        }
+        if (a.aabb.Overlaps(b.aabb)) {
+          report(cell[i], cell[j]);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,89 @@
+#ifndef LIB_INTERNAL_SPATIAL_HASH_GRID_H
+#define LIB_INTERNAL_SPATIAL_HASH_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "gtest/gtest_prod.h"
+#include "lib/internal/broadphase.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+/*
+ * Uniform spatial hash grid broadphase. Every proxy is stored in all the cells
+ * its bounding box touches, so a query only has to look at the cells which
+ * the queried box touches instead of at every proxy.
+ *
+ * Proxies which would span more than `kMaxCellsPerProxy` cells (e.g. world
+ * borders) are kept in a separate list and always checked.
+ */
+class SpatialHashGrid : public Broadphase {
+ public:
+  static constexpr int kMaxCellsPerProxy = 256;
+
+  explicit SpatialHashGrid(float cell_size);
+
+  void Insert(ProxyId id, const Aabb& aabb) override;
+  // Only cells which the proxy entered or left are touched.
+  void Update(ProxyId id, const Aabb& aabb) override;
+  void Remove(ProxyId id) override;
+  void Query(const Aabb& aabb,
+             absl::FunctionRef<void(ProxyId)> callback) const override;
+  // Walks only the cells which a thin ray crosses.
+  void QueryRay(const Ray& ray, float thickness,
+                absl::FunctionRef<void(ProxyId)> callback) const override;
+  void QueryPairs(
+      absl::FunctionRef<void(ProxyId, ProxyId)> callback) const override;
+
+  [[nodiscard]] bool Contains(ProxyId id) const override {
+    return proxies_.contains(id);
+  }
+  [[nodiscard]] size_t size() const override { return proxies_.size(); }
+
+ private:
+  struct CellRange {
+    [[nodiscard]] bool Contains(const int x, const int y) const {
+      return min_x <= x && x <= max_x && min_y <= y && y <= max_y;
+    }
+    [[nodiscard]] int64_t total_cells() const {
+      return static_cast<int64_t>(max_x - min_x + 1) * (max_y - min_y + 1);
+    }
+    bool operator==(const CellRange& other) const = default;
+
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+  };
+
+  struct Proxy {
+    Aabb aabb;
+    CellRange cells;
+    bool oversized;
+  };
+
+  [[nodiscard]] static uint64_t CellKey(int x, int y);
+  [[nodiscard]] CellRange ToCellRange(const Aabb& aabb) const;
+  void AddToCell(ProxyId id, int x, int y);
+  void RemoveFromCell(ProxyId id, int x, int y);
+  void AddToCells(ProxyId id, const Proxy& proxy);
+  void RemoveFromCells(ProxyId id, const Proxy& proxy);
+
+  FRIEND_TEST(SpatialHashGridTest, UpdateOnlyTouchesChangedCells);
+  FRIEND_TEST(SpatialHashGridTest, HugeProxyIsOversized);
+
+  const float cell_size_;
+  absl::flat_hash_map<ProxyId, Proxy> proxies_;
+  absl::flat_hash_map<uint64_t, std::vector<ProxyId>> cells_;
+  std::vector<ProxyId> oversized_;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_SPATIAL_HASH_GRID_H
@@ -0,0 +1,236 @@
+#include "lib/internal/spatial_hash_grid.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+using ProxyPair = std::pair<ProxyId, ProxyId>;
+
+std::vector<ProxyId> QueryAll(const SpatialHashGrid& grid, const Aabb& aabb) {
+  std::vector<ProxyId> ids;
+  grid.Query(aabb, [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyId> QueryRayAll(const SpatialHashGrid& grid, const Ray& ray,
+                                 const float thickness = 0) {
+  std::vector<ProxyId> ids;
+  grid.QueryRay(ray, thickness,
+              [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyPair> QueryAllPairs(const SpatialHashGrid& grid) {
+  std::vector<ProxyPair> pairs;
+  grid.QueryPairs([&pairs](const ProxyId a, const ProxyId b) {
+    pairs.emplace_back(a, b);
+  });
+  return pairs;
+}
+
+}  // namespace
+
+TEST(SpatialHashGridTest, QueryFindsOverlapping) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  grid.Insert(2, {.min_x = 4, .min_y = 4, .max_x = 25, .max_y = 25});
+  grid.Insert(3, {.min_x = 100, .min_y = 100, .max_x = 105, .max_y = 105});
+
+  EXPECT_THAT(QueryAll(grid, {.min_x = 3, .min_y = 3, .max_x = 6, .max_y = 6}),
+              UnorderedElementsAre(1, 2));
+  EXPECT_THAT(
+      QueryAll(grid, {.min_x = 50, .min_y = 50, .max_x = 60, .max_y = 60}),
+      IsEmpty());
+}
+
+TEST(SpatialHashGridTest, QueryReportsMultiCellProxyOnce) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = -15, .min_y = -15, .max_x = 35, .max_y = 35});
+
+  EXPECT_THAT(
+      QueryAll(grid, {.min_x = -20, .min_y = -20, .max_x = 40, .max_y = 40}),
+      UnorderedElementsAre(1));
+}
+
+TEST(SpatialHashGridTest, QueryChecksBoundingBoxes) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 1, .max_y = 1});
+
+  // Same cell, but the boxes do not overlap.
+  EXPECT_THAT(QueryAll(grid, {.min_x = 5, .min_y = 5, .max_x = 6, .max_y = 6}),
+              IsEmpty());
+}
+
+TEST(SpatialHashGridTest, UpdateMovesProxy) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  grid.Update(1, {.min_x = 50, .min_y = 50, .max_x = 55, .max_y = 55});
+
+  EXPECT_THAT(QueryAll(grid, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+              IsEmpty());
+  EXPECT_THAT(
+      QueryAll(grid, {.min_x = 50, .min_y = 50, .max_x = 51, .max_y = 51}),
+      UnorderedElementsAre(1));
+}
+
+TEST(SpatialHashGridTest, UpdateOnlyTouchesChangedCells) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 1, .min_y = 1, .max_x = 15, .max_y = 5});
+  grid.Insert(2, {.min_x = 11, .min_y = 1, .max_x = 12, .max_y = 2});
+
+  grid.Update(1, {.min_x = 11, .min_y = 1, .max_x = 25, .max_y = 5});
+
+  EXPECT_EQ(grid.cells_.size(), 2);
+  EXPECT_FALSE(grid.cells_.contains(SpatialHashGrid::CellKey(0, 0)));
+  // The shared cell is not touched, so the order is unchanged.
+  EXPECT_THAT(grid.cells_.at(SpatialHashGrid::CellKey(1, 0)),
+              ElementsAre(1, 2));
+  EXPECT_THAT(grid.cells_.at(SpatialHashGrid::CellKey(2, 0)),
+              ElementsAre(1));
+}
+
+TEST(SpatialHashGridTest, Remove) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  grid.Insert(2, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  grid.Remove(1);
+
+  EXPECT_FALSE(grid.Contains(1));
+  EXPECT_EQ(grid.size(), 1);
+  EXPECT_THAT(QueryAll(grid, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+              UnorderedElementsAre(2));
+}
+
+TEST(SpatialHashGridTest, HugeProxyIsOversized) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = -1000000, .max_x = 0, .max_y = 1000000});
+
+  EXPECT_THAT(grid.oversized_, ElementsAre(1));
+  EXPECT_TRUE(grid.cells_.empty());
+  EXPECT_THAT(
+      QueryAll(grid, {.min_x = -1, .min_y = 500, .max_x = 1, .max_y = 501}),
+      UnorderedElementsAre(1));
+
+  grid.Update(1, {.min_x = 0, .min_y = 0, .max_x = 1, .max_y = 1});
+
+  EXPECT_TRUE(grid.oversized_.empty());
+  EXPECT_EQ(grid.cells_.size(), 1);
+}
+
+TEST(SpatialHashGridTest, HugeQuery) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  grid.Insert(2, {.min_x = 500, .min_y = 0, .max_x = 505, .max_y = 5});
+
+  EXPECT_THAT(QueryAll(grid, {.min_x = -1000000,
+                              .min_y = 0,
+                              .max_x = 1000000,
+                              .max_y = 0}),
+              UnorderedElementsAre(1, 2));
+}
+
+TEST(SpatialHashGridTest, QueryRay) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 10, .min_y = -5, .max_x = 20, .max_y = 5});
+  grid.Insert(2, {.min_x = 50, .min_y = -5, .max_x = 60, .max_y = 5});
+  grid.Insert(3, {.min_x = 10, .min_y = 10, .max_x = 20, .max_y = 20});
+  grid.Insert(4, {.min_x = -20, .min_y = -5, .max_x = -10, .max_y = 5});
+
+  EXPECT_THAT(QueryRayAll(grid, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 100}),
+              UnorderedElementsAre(1, 2));
+  EXPECT_THAT(QueryRayAll(grid, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 30}),
+              UnorderedElementsAre(1));
+  EXPECT_THAT(QueryRayAll(grid, {.origin = {0, 8},
+                                .direction = {1, 0},
+                                .max_distance = 100},
+                          /*thickness=*/3),
+              UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(SpatialHashGridTest, QueryRayMatchesBruteForce) {
+  SpatialHashGrid grid(/*cell_size=*/16);
+  std::vector<Aabb> proxies;
+  std::mt19937 random(/*seed=*/42);
+  std::uniform_real_distribution<float> position(-200, 200);
+  std::uniform_real_distribution<float> size(1, 40);
+  for (ProxyId id = 0; id < 300; ++id) {
+    const float x = position(random);
+    const float y = position(random);
+    proxies.push_back(Aabb{.min_x = x,
+                           .min_y = y,
+                           .max_x = x + size(random),
+                           .max_y = y + size(random)});
+    grid.Insert(id, proxies.back());
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    const float angle = position(random);
+    const Ray ray = {.origin = {position(random), position(random)},
+                     .direction = {std::cos(angle), std::sin(angle)},
+                     .max_distance = size(random) * 5};
+    // Every other ray is thick.
+    const float thickness = i % 2 == 0 ? 0 : size(random);
+    std::vector<ProxyId> expected;
+    for (ProxyId id = 0; id < proxies.size(); ++id) {
+      if (Raycast(ray, proxies[id].Expand(thickness)).has_value()) {
+        expected.push_back(id);
+      }
+    }
+
+    EXPECT_THAT(QueryRayAll(grid, ray, thickness),
+                UnorderedElementsAreArray(expected));
+  }
+}
+
+TEST(SpatialHashGridTest, QueryPairs) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(3, {.min_x = 0, .min_y = 0, .max_x = 25, .max_y = 25});
+  grid.Insert(1, {.min_x = 15, .min_y = 15, .max_x = 35, .max_y = 35});
+  grid.Insert(2, {.min_x = 34, .min_y = 34, .max_x = 36, .max_y = 36});
+  grid.Insert(4, {.min_x = 0, .min_y = 26, .max_x = 5, .max_y = 30});
+
+  EXPECT_THAT(QueryAllPairs(grid), UnorderedElementsAre(ProxyPair(1, 3),
+                                                        ProxyPair(1, 2)));
+}
+
+TEST(SpatialHashGridTest, QueryPairsWithOversized) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = -1000000, .max_x = 0, .max_y = 1000000});
+  grid.Insert(2, {.min_x = -1000000, .min_y = 0, .max_x = 1000000, .max_y = 0});
+  grid.Insert(3, {.min_x = -4, .min_y = 500, .max_x = 4, .max_y = 508});
+
+  EXPECT_THAT(QueryAllPairs(grid), UnorderedElementsAre(ProxyPair(1, 2),
+                                                        ProxyPair(1, 3)));
+}
+
+TEST(SpatialHashGridDeathTest, InsertTwice) {
+  SpatialHashGrid grid(/*cell_size=*/10);
+  grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  EXPECT_DEATH(grid.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+               "already in the grid");
+}
+
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,28 @@
+#include "lib/internal/state_hash.h"
+
+#include <bit>
+#include <cstdint>
+
+namespace lib {
+namespace internal {
+
+namespace {
+
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+}  // namespace
+
+void StateHash::Add(uint64_t value) {
+  for (int byte = 0; byte < 8; ++byte) {
+    hash_ ^= value & 0xff;
+    hash_ *= kFnvPrime;
+    value >>= 8;
+  }
+}
+
+void StateHash::Add(const float value) {
+  Add(static_cast<uint64_t>(std::bit_cast<uint32_t>(value)));
+}
+
+}  // namespace internal
+}  // namespace lib
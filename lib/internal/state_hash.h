@@ -0,0 +1,28 @@
+#ifndef LIB_INTERNAL_STATE_HASH_H
+#define LIB_INTERNAL_STATE_HASH_H
+
+#include <cstdint>
+
+namespace lib {
+namespace internal {
+
+// 64 bit FNV-1a hash of the values added, in the order they are added. Unlike
+// `absl::Hash` it is not seeded per process, so hashes of the same state are
+// equal across runs and machines, e.g. to compare a replay with the recording.
+class StateHash {
+ public:
+  void Add(uint64_t value);
+  // Hashes the bits of `value`, -0 and 0 hash differently.
+  void Add(float value);
+  void Add(bool value) { Add(static_cast<uint64_t>(value)); }
+
+  [[nodiscard]] uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 14695981039346656037ull;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_STATE_HASH_H
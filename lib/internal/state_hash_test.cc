@@ -0,0 +1,42 @@
+#include "lib/internal/state_hash.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+TEST(StateHashTest, Stable) {
+  StateHash state_hash;
+
+  state_hash.Add(uint64_t{0});
+
+  // FNV-1a of eight zero bytes.
+  EXPECT_EQ(state_hash.hash(), 0xa8c7f832281a39c5ull);
+}
+
+TEST(StateHashTest, DependsOnValuesAndOrder) {
+  StateHash first;
+  first.Add(1.0f);
+  first.Add(2.0f);
+  StateHash same;
+  same.Add(1.0f);
+  same.Add(2.0f);
+  StateHash swapped;
+  swapped.Add(2.0f);
+  swapped.Add(1.0f);
+  StateHash flag;
+  flag.Add(true);
+  StateHash no_flag;
+  no_flag.Add(false);
+
+  EXPECT_EQ(first.hash(), same.hash());
+  EXPECT_NE(first.hash(), swapped.hash());
+  EXPECT_NE(flag.hash(), no_flag.hash());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace lib
@@ -0,0 +1,206 @@
+#include "lib/internal/sweep_and_prune.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+size_t SweepAndPrune::FindEndpoint(const Endpoint& endpoint) const {
+  // Endpoints with equal value and type are ordered arbitrarily, look
+  // through all of them.
+  auto it = std::lower_bound(endpoints_.begin(), endpoints_.end(), endpoint);
+  while (it != endpoints_.end() && it->id != endpoint.id) {
+    CHECK(!(endpoint < *it)) << "Proxy " << endpoint.id << " endpoint at "
+                             << endpoint.value << " is missing.";
+    ++it;
+  }
+  CHECK(it != endpoints_.end()) << "Proxy " << endpoint.id << " endpoint at "
+                                << endpoint.value << " is missing.";
+  return it - endpoints_.begin();
+}
+
+void SweepAndPrune::SortEndpoint(size_t index) {
+  while (index > 0 && endpoints_[index] < endpoints_[index - 1]) {
+    std::swap(endpoints_[index], endpoints_[index - 1]);
+    --index;
+    ++swaps_;
+  }
+  while (index + 1 < endpoints_.size() &&
+         endpoints_[index + 1] < endpoints_[index]) {
+    std::swap(endpoints_[index], endpoints_[index + 1]);
+    ++index;
+    ++swaps_;
+  }
+}
+
+void SweepAndPrune::InsertEndpoint(const Endpoint& endpoint) {
+  endpoints_.insert(
+      std::upper_bound(endpoints_.begin(), endpoints_.end(), endpoint),
+      endpoint);
+}
+
+void SweepAndPrune::RemoveEndpoint(const Endpoint& endpoint) {
+  endpoints_.erase(endpoints_.begin() + FindEndpoint(endpoint));
+}
+
+void SweepAndPrune::AddOversized(const ProxyId id, const Proxy& proxy) {
+  if (proxy.oversized()) {
+    oversized_.push_back(id);
+    return;
+  }
+  max_width_ = std::max(max_width_, proxy.aabb.width());
+}
+
+void SweepAndPrune::RemoveOversized(const ProxyId id, const Proxy& proxy) {
+  if (!proxy.oversized()) {
+    return;
+  }
+  const auto it = std::ranges::find(oversized_, id);
+  CHECK(it != oversized_.end()) << "Proxy " << id << " is not oversized.";
+  *it = oversized_.back();
+  oversized_.pop_back();
+}
+
+void SweepAndPrune::RecomputeMaxWidth() {
+  max_width_ = 0;
+  for (const auto& [id, proxy] : proxies_) {
+    if (!proxy.oversized()) {
+      max_width_ = std::max(max_width_, proxy.aabb.width());
+    }
+  }
+}
+
+void SweepAndPrune::Insert(const ProxyId id, const Aabb& aabb) {
+  const auto [it, inserted] = proxies_.try_emplace(id, Proxy{.aabb = aabb});
+  CHECK(inserted) << "Proxy " << id << " is already in sweep and prune.";
+  InsertEndpoint({.value = aabb.min_x, .id = id, .is_max = false});
+  InsertEndpoint({.value = aabb.max_x, .id = id, .is_max = true});
+  AddOversized(id, it->second);
+}
+
+void SweepAndPrune::Update(const ProxyId id, const Aabb& aabb) {
+  const auto it = proxies_.find(id);
+  CHECK(it != proxies_.end())
+      << "Proxy " << id << " is not in sweep and prune.";
+  Proxy& proxy = it->second;
+  const size_t min_index =
+      FindEndpoint({.value = proxy.aabb.min_x, .id = id, .is_max = false});
+  const size_t max_index =
+      FindEndpoint({.value = proxy.aabb.max_x, .id = id, .is_max = true});
+  const bool moving_right = aabb.min_x >= proxy.aabb.min_x;
+  endpoints_[min_index].value = aabb.min_x;
+  endpoints_[max_index].value = aabb.max_x;
+  RemoveOversized(id, proxy);
+  proxy.aabb = aabb;
+  AddOversized(id, proxy);
+
+  // Endpoints of the same proxy never swap with each other, so both indices
+  // stay valid. Moving right the maximum has to go first, otherwise it would
+  // block the minimum, and the other way around when moving left.
+  if (moving_right) {
+    SortEndpoint(max_index);
+    SortEndpoint(min_index);
+    return;
+  }
+  SortEndpoint(min_index);
+  SortEndpoint(max_index);
+}
+
+void SweepAndPrune::Remove(const ProxyId id) {
+  const auto it = proxies_.find(id);
+  CHECK(it != proxies_.end())
+      << "Proxy " << id << " is not in sweep and prune.";
+  const Proxy proxy = it->second;
+  RemoveEndpoint({.value = proxy.aabb.min_x, .id = id, .is_max = false});
+  RemoveEndpoint({.value = proxy.aabb.max_x, .id = id, .is_max = true});
+  RemoveOversized(id, proxy);
+  proxies_.erase(it);
+  if (!proxy.oversized() && proxy.aabb.width() >= max_width_) {
+    RecomputeMaxWidth();
+  }
+}
+
+void SweepAndPrune::Query(
+    const Aabb& aabb, const absl::FunctionRef<void(ProxyId)> callback) const {
+  for (const ProxyId id : oversized_) {
+    if (proxies_.at(id).aabb.Overlaps(aabb)) {
+      callback(id);
+    }
+  }
+
+  // Any other overlapping proxy starts at most `max_width_` before the query.
+  auto it = std::lower_bound(
+      endpoints_.begin(), endpoints_.end(),
+      Endpoint{.value = aabb.min_x - max_width_, .id = 0, .is_max = false});
+  for (; it != endpoints_.end() && it->value <= aabb.max_x; ++it) {
+    if (it->is_max) {
+      continue;
+    }
+    const Proxy& proxy = proxies_.at(it->id);
+    if (!proxy.oversized() && proxy.aabb.Overlaps(aabb)) {
+      callback(it->id);
+    }
+  }
+}
+
+void SweepAndPrune::QueryRay(
+    const Ray& ray, const float thickness,
+    const absl::FunctionRef<void(ProxyId)> callback) const {
+  Query(ray.BoundingBox().Expand(thickness),
+        [this, &ray, thickness, callback](const ProxyId id) {
+          if (Raycast(ray, proxies_.at(id).aabb.Expand(thickness))
+                  .has_value()) {
+            callback(id);
+          }
+        });
+}
+
+void SweepAndPrune::QueryPairs(
+    const absl::FunctionRef<void(ProxyId, ProxyId)> callback) const {
+  // Reused between calls to avoid allocating every frame. Thread local, so
+  // that pairs can be queried from several threads at once.
+  thread_local std::vector<const std::pair<const ProxyId, Proxy>*> active;
+  // Where every open proxy is in `active`.
+  thread_local absl::flat_hash_map<ProxyId, size_t> active_indices;
+  active.clear();
+  // `clear` frees the memory of large tables.
+  active_indices.erase(active_indices.begin(), active_indices.end());
+  for (const Endpoint& endpoint : endpoints_) {
+    if (endpoint.is_max) {
+      // Swap with the last open proxy, which takes over the index.
+      const auto it = active_indices.find(endpoint.id);
+      const size_t index = it->second;
+      active_indices.erase(it);
+      active[index] = active.back();
+      active.pop_back();
+      if (index < active.size()) {
+        active_indices[active[index]->first] = index;
+      }
+      continue;
+    }
+
+    const auto& current = *proxies_.find(endpoint.id);
+    for (const auto* other : active) {
+      // Intervals on the x axis overlap, since `other` is still open.
+      if (current.second.aabb.min_y <= other->second.aabb.max_y &&
+          other->second.aabb.min_y <= current.second.aabb.max_y) {
+        callback(std::min(current.first, other->first),
+                 std::max(current.first, other->first));
+      }
+    }
+    active_indices[current.first] = active.size();
+    active.push_back(&current);
+  }
+}
+
+}  // namespace internal
+}  // namespace lib
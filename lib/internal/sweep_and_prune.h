@@ -0,0 +1,102 @@
+#ifndef LIB_INTERNAL_SWEEP_AND_PRUNE_H
+#define LIB_INTERNAL_SWEEP_AND_PRUNE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "gtest/gtest_prod.h"
+#include "lib/internal/broadphase.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+
+/*
+ * Sweep and prune broadphase. Keeps x-axis endpoints of all proxies sorted
+ * across frames. Objects move only a few units per frame, so after `Update`
+ * an endpoint is moved to its new place with insertion sort and usually swaps
+ * with none or very few neighbours, making the frame close to O(n).
+ *
+ * Proxies wider than `kMaxProxyWidth` (e.g. world borders or screen edges)
+ * are also checked separately by `Query` so that they do not widen the
+ * scanned range for everyone else. The scan of a query starts the width of
+ * the widest other proxy before it.
+ */
+class SweepAndPrune : public Broadphase {
+ public:
+  // A few sprites wide, well below the width of a screen.
+  static constexpr float kMaxProxyWidth = 256;
+
+  SweepAndPrune() = default;
+
+  void Insert(ProxyId id, const Aabb& aabb) override;
+  // Moves the endpoints of the proxy with insertion sort.
+  void Update(ProxyId id, const Aabb& aabb) override;
+  void Remove(ProxyId id) override;
+  void Query(const Aabb& aabb,
+             absl::FunctionRef<void(ProxyId)> callback) const override;
+  void QueryRay(const Ray& ray, float thickness,
+                absl::FunctionRef<void(ProxyId)> callback) const override;
+  // Sweeps over the sorted endpoints keeping the proxies whose x-axis
+  // interval is open. Levels query every moving object on its own instead,
+  // which also finds the static objects kept in another broadphase and can
+  // be split into chunks detected in parallel.
+  void QueryPairs(
+      absl::FunctionRef<void(ProxyId, ProxyId)> callback) const override;
+
+  [[nodiscard]] bool Contains(ProxyId id) const override {
+    return proxies_.contains(id);
+  }
+  [[nodiscard]] size_t size() const override { return proxies_.size(); }
+
+ private:
+  struct Endpoint {
+    // Minimum endpoints go first on ties, so touching proxies overlap.
+    [[nodiscard]] bool operator<(const Endpoint& other) const {
+      return value < other.value ||
+             (value == other.value && !is_max && other.is_max);
+    }
+
+    float value;
+    ProxyId id;
+    bool is_max;
+  };
+
+  struct Proxy {
+    [[nodiscard]] bool oversized() const {
+      return aabb.width() > kMaxProxyWidth;
+    }
+
+    Aabb aabb;
+  };
+
+  // Binary searches for the index of `endpoint`.
+  [[nodiscard]] size_t FindEndpoint(const Endpoint& endpoint) const;
+  // Moves the endpoint at `index` left or right until the endpoints are
+  // sorted again.
+  void SortEndpoint(size_t index);
+  void InsertEndpoint(const Endpoint& endpoint);
+  void RemoveEndpoint(const Endpoint& endpoint);
+  void AddOversized(ProxyId id, const Proxy& proxy);
+  void RemoveOversized(ProxyId id, const Proxy& proxy);
+  void RecomputeMaxWidth();
+
+  FRIEND_TEST(SweepAndPruneTest, SmallMoveSwapsOnlyNeighbours);
+  FRIEND_TEST(SweepAndPruneTest, ScreenWideProxyKeepsScanLocal);
+
+  std::vector<Endpoint> endpoints_;
+  absl::flat_hash_map<ProxyId, Proxy> proxies_;
+  std::vector<ProxyId> oversized_;
+  // Upper bound on the width of proxies which are not oversized.
+  float max_width_ = 0;
+  // Number of endpoint swaps done by `Update`, used in tests.
+  size_t swaps_ = 0;
+};
+
+}  // namespace internal
+}  // namespace lib
+
+#endif  // LIB_INTERNAL_SWEEP_AND_PRUNE_H
@@ -0,0 +1,229 @@
+#include "lib/internal/sweep_and_prune.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "lib/internal/geometry/aabb.h"
+#include "lib/internal/geometry/ray.h"
+
+namespace lib {
+namespace internal {
+namespace {
+
+using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+using ProxyPair = std::pair<ProxyId, ProxyId>;
+
+std::vector<ProxyId> QueryAll(const SweepAndPrune& sap, const Aabb& aabb) {
+  std::vector<ProxyId> ids;
+  sap.Query(aabb, [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyId> QueryRayAll(const SweepAndPrune& sap, const Ray& ray,
+                                 const float thickness = 0) {
+  std::vector<ProxyId> ids;
+  sap.QueryRay(ray, thickness,
+              [&ids](const ProxyId id) { ids.push_back(id); });
+  return ids;
+}
+
+std::vector<ProxyPair> QueryAllPairs(const SweepAndPrune& sap) {
+  std::vector<ProxyPair> pairs;
+  sap.QueryPairs([&pairs](const ProxyId a, const ProxyId b) {
+    pairs.emplace_back(a, b);
+  });
+  return pairs;
+}
+
+}  // namespace
+
+TEST(SweepAndPruneTest, QueryFindsOverlapping) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  sap.Insert(2, {.min_x = 4, .min_y = 4, .max_x = 25, .max_y = 25});
+  sap.Insert(3, {.min_x = 100, .min_y = 100, .max_x = 105, .max_y = 105});
+  sap.Insert(4, {.min_x = 3, .min_y = 50, .max_x = 6, .max_y = 55});
+
+  EXPECT_THAT(QueryAll(sap, {.min_x = 3, .min_y = 3, .max_x = 6, .max_y = 6}),
+              UnorderedElementsAre(1, 2));
+  EXPECT_THAT(
+      QueryAll(sap, {.min_x = 30, .min_y = 30, .max_x = 40, .max_y = 40}),
+      IsEmpty());
+}
+
+TEST(SweepAndPruneTest, TouchingOverlaps) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  sap.Insert(2, {.min_x = 5, .min_y = 5, .max_x = 10, .max_y = 10});
+
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAre(ProxyPair(1, 2)));
+}
+
+TEST(SweepAndPruneTest, OversizedProxy) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = -1000000, .min_y = 0, .max_x = 1000000, .max_y = 0});
+  sap.Insert(2, {.min_x = 500, .min_y = -4, .max_x = 508, .max_y = 4});
+  sap.Insert(3, {.min_x = 600, .min_y = 10, .max_x = 608, .max_y = 18});
+
+  EXPECT_THAT(
+      QueryAll(sap, {.min_x = 400, .min_y = -1, .max_x = 700, .max_y = 1}),
+      UnorderedElementsAre(1, 2));
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAre(ProxyPair(1, 2)));
+}
+
+TEST(SweepAndPruneTest, QueryRay) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 10, .min_y = -5, .max_x = 20, .max_y = 5});
+  sap.Insert(2, {.min_x = 50, .min_y = -5, .max_x = 60, .max_y = 5});
+  sap.Insert(3, {.min_x = 10, .min_y = 10, .max_x = 20, .max_y = 20});
+  sap.Insert(4, {.min_x = -20, .min_y = -5, .max_x = -10, .max_y = 5});
+
+  EXPECT_THAT(QueryRayAll(sap, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 100}),
+              UnorderedElementsAre(1, 2));
+  EXPECT_THAT(QueryRayAll(sap, {.origin = {0, 0},
+                                .direction = {1, 0},
+                                .max_distance = 30}),
+              UnorderedElementsAre(1));
+  EXPECT_THAT(QueryRayAll(sap, {.origin = {0, 8},
+                                .direction = {1, 0},
+                                .max_distance = 100},
+                          /*thickness=*/3),
+              UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(SweepAndPruneTest, UpdateMovesProxy) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  sap.Insert(2, {.min_x = 50, .min_y = 0, .max_x = 55, .max_y = 5});
+  sap.Insert(3, {.min_x = 100, .min_y = 0, .max_x = 105, .max_y = 5});
+
+  sap.Update(1, {.min_x = 102, .min_y = 0, .max_x = 107, .max_y = 5});
+
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAre(ProxyPair(1, 3)));
+
+  sap.Update(1, {.min_x = -10, .min_y = 0, .max_x = 51, .max_y = 5});
+
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAre(ProxyPair(1, 2)));
+}
+
+TEST(SweepAndPruneTest, SmallMoveSwapsOnlyNeighbours) {
+  SweepAndPrune sap;
+  for (ProxyId id = 0; id < 100; ++id) {
+    const float x = static_cast<float>(id) * 10;
+    sap.Insert(id, {.min_x = x, .min_y = 0, .max_x = x + 8, .max_y = 8});
+  }
+
+  // Passes the minimum of the next proxy only.
+  sap.Update(50, {.min_x = 503, .min_y = 0, .max_x = 511, .max_y = 8});
+
+  EXPECT_EQ(sap.swaps_, 1);
+}
+
+TEST(SweepAndPruneTest, ScreenWideProxyKeepsScanLocal) {
+  SweepAndPrune sap;
+  for (ProxyId id = 0; id < 100; ++id) {
+    const float x = static_cast<float>(id) * 20;
+    sap.Insert(id, {.min_x = x, .min_y = 0, .max_x = x + 8, .max_y = 8});
+  }
+
+  // Like the screen edges of a 1920 wide screen, which move with the camera.
+  sap.Insert(100, {.min_x = 0, .min_y = -2, .max_x = 1920, .max_y = 0});
+
+  // Queries only scan back the width of the small proxies.
+  EXPECT_FLOAT_EQ(sap.max_width_, 8);
+  EXPECT_THAT(sap.oversized_, ElementsAre(100));
+  EXPECT_THAT(QueryAll(sap, {.min_x = 1510, .min_y = -1, .max_x = 1512,
+                             .max_y = 1}),
+              UnorderedElementsAre(100));
+  sap.Update(100, {.min_x = 10, .min_y = -2, .max_x = 1930, .max_y = 0});
+  EXPECT_FLOAT_EQ(sap.max_width_, 8);
+  EXPECT_THAT(QueryAllPairs(sap), Contains(ProxyPair(96, 100)));
+}
+
+TEST(SweepAndPruneTest, Remove) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  sap.Insert(2, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+  sap.Insert(3, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  sap.Remove(2);
+
+  EXPECT_FALSE(sap.Contains(2));
+  EXPECT_EQ(sap.size(), 2);
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAre(ProxyPair(1, 3)));
+}
+
+TEST(SweepAndPruneTest, MatchesBruteForce) {
+  SweepAndPrune sap;
+  absl::flat_hash_map<ProxyId, Aabb> proxies;
+  std::mt19937 random(/*seed=*/7);
+  std::uniform_real_distribution<float> position(0, 500);
+  std::uniform_real_distribution<float> size(1, 40);
+  std::uniform_real_distribution<float> step(-6, 6);
+  for (ProxyId id = 0; id < 200; ++id) {
+    const float x = position(random);
+    const float y = position(random);
+    proxies[id] = {.min_x = x,
+                   .min_y = y,
+                   .max_x = x + size(random),
+                   .max_y = y + size(random)};
+    sap.Insert(id, proxies[id]);
+  }
+  // Simulate a few frames of small moves.
+  for (int frame = 0; frame < 10; ++frame) {
+    for (auto& [id, aabb] : proxies) {
+      const float dx = step(random);
+      const float dy = step(random);
+      aabb = {.min_x = aabb.min_x + dx,
+              .min_y = aabb.min_y + dy,
+              .max_x = aabb.max_x + dx,
+              .max_y = aabb.max_y + dy};
+      sap.Update(id, aabb);
+    }
+  }
+  for (ProxyId id = 1; id < 200; id += 7) {
+    proxies.erase(id);
+    sap.Remove(id);
+  }
+
+  std::vector<ProxyPair> expected_pairs;
+  for (const auto& [a, a_aabb] : proxies) {
+    for (const auto& [b, b_aabb] : proxies) {
+      if (a < b && a_aabb.Overlaps(b_aabb)) {
+        expected_pairs.emplace_back(a, b);
+      }
+    }
+  }
+  EXPECT_THAT(QueryAllPairs(sap), UnorderedElementsAreArray(expected_pairs));
+  for (const auto& [id, aabb] : proxies) {
+    std::vector<ProxyId> expected_ids;
+    for (const auto& [other_id, other_aabb] : proxies) {
+      if (aabb.Overlaps(other_aabb)) {
+        expected_ids.push_back(other_id);
+      }
+    }
+    EXPECT_THAT(QueryAll(sap, aabb), UnorderedElementsAreArray(expected_ids));
+  }
+}
+
+TEST(SweepAndPruneDeathTest, InsertTwice) {
+  SweepAndPrune sap;
+  sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5});
+
+  EXPECT_DEATH(sap.Insert(1, {.min_x = 0, .min_y = 0, .max_x = 5, .max_y = 5}),
+               "already in sweep and prune");
+}
+
+}  // namespace internal
+}  // namespace lib